@@ -655,4 +655,385 @@ Z: 300)teststr");
 		}
 	}
 
-}
\ No newline at end of file
+	int RpcAdd(int lhs, int rhs)
+	{
+		return lhs + rhs;
+	}
+
+	GLAS_FUNCTION_PROP(RpcAdd, glas::FunctionProperties::ServerCallable);
+
+	float RpcDot(Vector lhs, Vector rhs)
+	{
+		return lhs.X * rhs.X + lhs.Y * rhs.Y + lhs.Z * rhs.Z;
+	}
+
+	GLAS_FUNCTION_PROP(RpcDot, glas::FunctionProperties::ServerCallable);
+
+	int RpcNotCallable(int value)
+	{
+		return value;
+	}
+
+	GLAS_FUNCTION(RpcNotCallable);
+
+	size_t RpcLength(std::string text)
+	{
+		return text.size();
+	}
+
+	GLAS_FUNCTION_PROP(RpcLength, glas::FunctionProperties::ServerCallable);
+
+	struct alignas(64) AlignedVector
+	{
+		Vector Value{};
+	};
+
+	GLAS_MEMBER(AlignedVector, Value);
+
+	AlignedVector RpcScale(Vector vector, float scale)
+	{
+		return AlignedVector{ Vector{ vector.X * scale, vector.Y * scale, vector.Z * scale } };
+	}
+
+	GLAS_FUNCTION_PROP(RpcScale, glas::FunctionProperties::ServerCallable);
+
+	TEST_CASE("Rpc Dispatcher", "[Rpc]")
+	{
+		using namespace glas::Rpc;
+
+		std::vector<uint8_t> request{};
+		std::vector<uint8_t> response{};
+
+		SECTION("Batch")
+		{
+			RequestWriter writer{ request };
+			writer.AddCall(GLAS_FUNCTION_ID(RpcAdd), 20, 22);
+			writer.AddCall(GLAS_FUNCTION_ID(RpcDot), Vector{ 1, 2, 3 }, Vector{ 4, 5, 6 });
+			writer.AddCall(GLAS_FUNCTION_ID(RpcAdd), 1, 2);
+
+			Dispatcher dispatcher{};
+			REQUIRE(dispatcher.Dispatch(request, response) == 3);
+
+			ResponseReader reader{ response };
+			REQUIRE(reader.GetCallCount() == 3);
+
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::Success);
+			REQUIRE(reader.Read<int>() == 42);
+
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::Success);
+			REQUIRE(reader.Read<float>() == 32.f);
+
+			REQUIRE(reader.Next());
+			REQUIRE(reader.Read<int>() == 3);
+
+			REQUIRE(!reader.Next());
+		}
+
+		SECTION("Invalid Calls")
+		{
+			RequestWriter writer{ request };
+			writer.AddCall(glas::FunctionId{ 12345 }, 1);
+			writer.AddCall(GLAS_FUNCTION_ID(RpcNotCallable), 1);
+			writer.AddCall(GLAS_FUNCTION_ID(RpcAdd), 1);
+			writer.AddCall(GLAS_FUNCTION_ID(RpcAdd), 2, 3);
+
+			Dispatcher dispatcher{};
+			REQUIRE(dispatcher.Dispatch(request, response) == 4);
+
+			ResponseReader reader{ response };
+
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::UnknownFunction);
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::NotServerCallable);
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::InvalidArguments);
+
+			// the calls after an invalid call are still executed
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::Success);
+			REQUIRE(reader.Read<int>() == 5);
+		}
+
+		SECTION("Over-Aligned Return Type")
+		{
+			RequestWriter writer{ request };
+			writer.AddCall(GLAS_FUNCTION_ID(RpcScale), Vector{ 1, 2, 3 }, 2.f);
+
+			Dispatcher dispatcher{};
+			REQUIRE(dispatcher.Dispatch(request, response) == 1);
+
+			ResponseReader reader{ response };
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::Success);
+
+			const AlignedVector result = reader.Read<AlignedVector>();
+			REQUIRE(result.Value.X == 2.f);
+			REQUIRE(result.Value.Y == 4.f);
+			REQUIRE(result.Value.Z == 6.f);
+		}
+
+		SECTION("Malformed Arguments")
+		{
+			// the size prefix of the string is larger than anything that can be allocated
+			RequestWriter writer{ request };
+			writer.AddCall(GLAS_FUNCTION_ID(RpcLength), std::numeric_limits<size_t>::max());
+			// a size that can be allocated is still limited to the bytes of the call
+			writer.AddCall(GLAS_FUNCTION_ID(RpcLength), size_t{ 1 } << 30);
+			writer.AddCall(GLAS_FUNCTION_ID(RpcLength), std::string("text"));
+
+			Dispatcher dispatcher{};
+			REQUIRE(dispatcher.Dispatch(request, response) == 3);
+
+			ResponseReader reader{ response };
+
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::InvalidArguments);
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::InvalidArguments);
+			REQUIRE(reader.Next());
+			REQUIRE(reader.GetStatus() == CallStatus::Success);
+			REQUIRE(reader.Read<size_t>() == 4);
+		}
+
+#ifdef GLAS_RPC_LOOPBACK
+		SECTION("Loopback Transport")
+		{
+			LoopbackTransport transport{};
+			REQUIRE(transport.IsConnected());
+
+			// pipeline multiple requests before reading the responses
+			for (int i{}; i < 10; ++i)
+			{
+				RequestWriter writer{ request };
+				writer.AddCall(GLAS_FUNCTION_ID(RpcAdd), i, i);
+				REQUIRE(transport.Send(request));
+			}
+
+			for (int i{}; i < 10; ++i)
+			{
+				REQUIRE(transport.Receive(response));
+
+				ResponseReader reader{ response };
+				REQUIRE(reader.Next());
+				REQUIRE(reader.Read<int>() == i * 2);
+			}
+		}
+#endif
+	}
+	class ComponentBase
+	{
+	public:
+		virtual ~ComponentBase() = default;
+
+		int Owner{};
+	};
+
+	class RenderComponent : public ComponentBase
+	{
+	public:
+		Vector Color{};
+		float Opacity{ 1.f };
+	};
+
+	class PhysicsComponent : public ComponentBase
+	{
+	public:
+		float Mass{};
+	};
+
+	class RigidbodyComponent final : public PhysicsComponent
+	{
+	public:
+		Vector Velocity{};
+	};
+
+	class TagComponent final : public ComponentBase
+	{
+	public:
+		std::vector<int> Tags{};
+	};
+
+	struct ComponentList
+	{
+		ComponentList() = default;
+		ComponentList(const ComponentList&) = delete;
+		ComponentList& operator=(const ComponentList&) = delete;
+
+		std::vector<std::unique_ptr<ComponentBase>> Components{};
+	};
+
+	GLAS_MEMBER(ComponentBase, Owner);
+	GLAS_MEMBER(RenderComponent, Color);
+	GLAS_MEMBER(RenderComponent, Opacity);
+	GLAS_MEMBER(PhysicsComponent, Mass);
+	GLAS_MEMBER(RigidbodyComponent, Velocity);
+	GLAS_CHILD(ComponentBase, RenderComponent);
+	GLAS_CHILD(ComponentBase, PhysicsComponent);
+	GLAS_MEMBER(TagComponent, Tags);
+	GLAS_CHILD(ComponentBase, TagComponent);
+	GLAS_CHILD(PhysicsComponent, RigidbodyComponent);
+}
+
+// containers of unique pointers report that they are copy constructible
+GLAS_STORAGE_DISABLE_COPY(std::vector<std::unique_ptr<SerializeTest::ComponentBase>>);
+
+namespace SerializeTest
+{
+	GLAS_MEMBER(ComponentList, Components);
+
+	void FillComponentList(ComponentList& list)
+	{
+		auto render = std::make_unique<RenderComponent>();
+		render->Owner = 1;
+		render->Color = Vector{ 0.25f, 0.5f, 0.75f };
+		render->Opacity = 0.5f;
+
+		auto physics = std::make_unique<PhysicsComponent>();
+		physics->Owner = 2;
+		physics->Mass = 10.f;
+
+		auto rigidbody = std::make_unique<RigidbodyComponent>();
+		rigidbody->Owner = 3;
+		rigidbody->Mass = 20.f;
+		rigidbody->Velocity = Vector{ 1.f, 2.f, 3.f };
+
+		list.Components.emplace_back(std::move(render));
+		list.Components.emplace_back(std::move(physics));
+		list.Components.emplace_back(std::move(rigidbody));
+		list.Components.emplace_back(nullptr);
+		list.Components.emplace_back(std::make_unique<RenderComponent>());
+	}
+
+	void CheckComponentList(const ComponentList& list)
+	{
+		REQUIRE(list.Components.size() == 5);
+
+		auto render = dynamic_cast<RenderComponent*>(list.Components[0].get());
+		REQUIRE(render);
+		REQUIRE(render->Owner == 1);
+		REQUIRE(render->Color.Y == 0.5f);
+		REQUIRE(render->Opacity == 0.5f);
+
+		REQUIRE(typeid(*list.Components[1]) == typeid(PhysicsComponent));
+		REQUIRE(list.Components[1]->Owner == 2);
+		REQUIRE(static_cast<PhysicsComponent*>(list.Components[1].get())->Mass == 10.f);
+
+		auto rigidbody = dynamic_cast<RigidbodyComponent*>(list.Components[2].get());
+		REQUIRE(rigidbody);
+		REQUIRE(rigidbody->Owner == 3);
+		REQUIRE(rigidbody->Mass == 20.f);
+		REQUIRE(rigidbody->Velocity.Z == 3.f);
+
+		REQUIRE(!list.Components[3]);
+		REQUIRE(dynamic_cast<RenderComponent*>(list.Components[4].get()));
+	}
+
+	TEST_CASE("Polymorphic Serialization", "[Polymorphic]")
+	{
+		ComponentList list0{};
+		ComponentList list1{};
+		FillComponentList(list0);
+
+		SECTION("Binary")
+		{
+			std::stringstream stream{};
+			{
+				PolymorphicScope scope{};
+				SerializeBinary(stream, list0);
+			}
+
+			// every type is only written in full once inside of a scope
+			std::stringstream unscopedStream{};
+			SerializeBinary(unscopedStream, list0);
+			REQUIRE(stream.str().size() + sizeof(glas::TypeId) == unscopedStream.str().size());
+
+			{
+				PolymorphicScope scope{};
+				DeserializeBinary(stream, list1);
+			}
+			CheckComponentList(list1);
+		}
+
+		SECTION("JSon")
+		{
+			std::stringstream stream{};
+			{
+				PolymorphicScope scope{};
+				SerializeJSon(stream, list0);
+			}
+			{
+				PolymorphicScope scope{};
+				DeserializeJSon(stream, list1);
+			}
+			CheckComponentList(list1);
+		}
+
+		SECTION("YAML")
+		{
+			std::stringstream stream{};
+			{
+				PolymorphicScope scope{};
+				SerializeYaml(stream, list0);
+			}
+			{
+				PolymorphicScope scope{};
+				DeserializeYaml(stream, list1);
+			}
+			CheckComponentList(list1);
+		}
+
+		SECTION("Malformed Documents")
+		{
+			const std::unique_ptr<ComponentBase> component = std::make_unique<PhysicsComponent>();
+			std::unique_ptr<ComponentBase> result{};
+
+			// the type index has to be an unsigned integer
+			std::stringstream jsonStream{};
+			SerializeJSon(jsonStream, component);
+			std::string json = jsonStream.str();
+			json.replace(json.find("\"Type Index\": 1"), 15, "\"Type Index\": \"1\"");
+			std::stringstream malformedJson{ json };
+			DeserializeJSon(malformedJson, result);
+			REQUIRE(!result);
+
+			// the constructed instance is destroyed when one of its parts can not be read
+			auto tags = std::make_unique<TagComponent>();
+			tags->Tags = { 1, 2 };
+			const std::unique_ptr<ComponentBase> tagged = std::move(tags);
+
+			std::stringstream yamlStream{};
+			SerializeYaml(yamlStream, tagged);
+			std::string yaml = yamlStream.str();
+			yaml.replace(yaml.find("- 2"), 3, "- text");
+			std::stringstream malformedYaml{ yaml };
+			REQUIRE_THROWS(DeserializeYaml(malformedYaml, result));
+			REQUIRE(!result);
+		}
+
+		SECTION("Unrelated Types")
+		{
+			// a RenderComponent is not a PhysicsComponent, so it can not be read into a pointer to one
+			const std::unique_ptr<RenderComponent> render = std::make_unique<RenderComponent>();
+
+			std::stringstream binaryStream{};
+			SerializeBinary(binaryStream, render);
+			std::unique_ptr<PhysicsComponent> physics{};
+			DeserializeBinary(binaryStream, physics);
+			REQUIRE(!physics);
+			REQUIRE(binaryStream.fail());
+
+			std::stringstream jsonStream{};
+			SerializeJSon(jsonStream, render);
+			DeserializeJSon(jsonStream, physics);
+			REQUIRE(!physics);
+
+			std::stringstream yamlStream{};
+			SerializeYaml(yamlStream, render);
+			DeserializeYaml(yamlStream, physics);
+			REQUIRE(!physics);
+		}
+	}
+}
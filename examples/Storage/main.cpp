@@ -810,5 +810,2454 @@ namespace StorageTest
 		}
 	}
 
+	int AsyncMultiply(int value, int factor)
+	{
+		return value * factor;
+	}
+
+	GLAS_FUNCTION(AsyncMultiply);
+
+	void AsyncThrow()
+	{
+		throw std::runtime_error("Async exception");
+	}
+
+	GLAS_FUNCTION(AsyncThrow);
+
+	struct AsyncCounter
+	{
+		int Add(int amount) { return Count += amount; }
+
+		int Count{};
+	};
+
+	GLAS_MEMBER_FUNCTION(AsyncCounter, Add);
+
+	TEST_CASE("Async Call", "[Async]")
+	{
+		auto multiplyId = GLAS_FUNCTION_ID(AsyncMultiply);
+
+		SECTION("CallAsync")
+		{
+			auto handle = multiplyId.CallAsync(TypeTuple::Create(6, 7));
+
+			REQUIRE(handle.IsValid());
+			REQUIRE(*handle.GetResult().As<int>() == 42);
+			REQUIRE(handle.IsReady());
+		}
+
+		SECTION("MemberCallAsync")
+		{
+			AsyncCounter counter{ 10 };
+			auto handle = GLAS_MEMBER_FUNCTION_ID(AsyncCounter, Add).MemberCallAsync(&counter, TypeTuple::Create(5));
+
+			REQUIRE(*handle.GetResult().As<int>() == 15);
+			REQUIRE(counter.Count == 15);
+		}
+
+		SECTION("Completion Callback")
+		{
+			std::atomic<int> result{};
+			auto callback = [](glas::Async::CallHandle& handle, void* userData)
+				{
+					static_cast<std::atomic<int>*>(userData)->store(*handle.GetResult().As<int>());
+				};
+
+			auto handle = multiplyId.CallAsync(TypeTuple::Create(3, 3), callback, &result);
+			handle.Wait();
+			while (result.load() == 0) {}
+			REQUIRE(result.load() == 9);
+
+			// setting a callback after completion executes it immediately
+			auto finishedHandle = multiplyId.CallAsync(TypeTuple::Create(4, 4));
+			finishedHandle.Wait();
+			finishedHandle.OnComplete(callback, &result);
+			REQUIRE(result.load() == 16);
+		}
+
+		SECTION("Batch")
+		{
+			std::vector<glas::Async::CallHandle> handles;
+			{
+				glas::Async::CallBatch batch{};
+				for (int i{}; i < 100; ++i)
+				{
+					handles.emplace_back(batch.Add(multiplyId, TypeTuple::Create(i, 2)));
+				}
+				REQUIRE(batch.Size() == 100);
+			}
+
+			for (int i{}; i < 100; ++i)
+			{
+				REQUIRE(*handles[i].GetResult().As<int>() == i * 2);
+			}
+		}
+
+		SECTION("Exception")
+		{
+			auto handle = GLAS_FUNCTION_ID(AsyncThrow).CallAsync(TypeTuple::Create());
+
+			REQUIRE_THROWS_AS(handle.GetResult(), std::runtime_error);
+		}
+	}
+
+	int ProfiledSquare(int value)
+	{
+		return value * value;
+	}
+
+	GLAS_FUNCTION(ProfiledSquare);
+
+	TEST_CASE("Function Profiler", "[Profiler]")
+	{
+		auto squareId = GLAS_FUNCTION_ID(ProfiledSquare);
+		glas::Profiler::ResetFunctionProfiles();
+
+		SECTION("Call Count")
+		{
+			auto tuple = TypeTuple::Create(5);
+			int result{};
+			for (int i{}; i < 100; ++i)
+			{
+				squareId.Call(tuple, &result);
+			}
+			REQUIRE(result == 25);
+
+			auto profile = glas::GetFunctionProfile(squareId);
+			REQUIRE(profile.Function == squareId);
+			REQUIRE(profile.CallCount == 100);
+			REQUIRE(profile.MaxNanoseconds <= profile.TotalNanoseconds);
+
+			uint64_t histogramCount{};
+			for (uint64_t bucket : profile.Histogram)
+			{
+				histogramCount += bucket;
+			}
+			REQUIRE(histogramCount == 100);
+		}
+
+		SECTION("Merge Threads")
+		{
+			std::vector<std::thread> threads;
+			for (int i{}; i < 4; ++i)
+			{
+				threads.emplace_back([squareId]
+					{
+						auto tuple = TypeTuple::Create(3);
+						int result{};
+						for (int j{}; j < 250; ++j)
+						{
+							squareId.Call(tuple, &result);
+						}
+					});
+			}
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			REQUIRE(glas::GetFunctionProfile(squareId).CallCount == 1000);
+		}
+
+		SECTION("Reset")
+		{
+			auto tuple = TypeTuple::Create(2);
+			squareId.Call(tuple);
+			REQUIRE(glas::GetFunctionProfile(squareId).CallCount == 1);
+
+			glas::Profiler::ResetFunctionProfiles();
+			REQUIRE(glas::GetFunctionProfile(squareId).CallCount == 0);
+
+			// the counters are cleared by the next call on their thread
+			squareId.Call(tuple);
+			REQUIRE(glas::GetFunctionProfile(squareId).CallCount == 1);
+
+			// counters of threads that exited before the reset stay cleared
+			std::thread{ [squareId] { auto threadTuple = TypeTuple::Create(2); squareId.Call(threadTuple); } }.join();
+			REQUIRE(glas::GetFunctionProfile(squareId).CallCount == 2);
+			glas::Profiler::ResetFunctionProfiles();
+			REQUIRE(glas::GetFunctionProfile(squareId).CallCount == 0);
+		}
+
+		SECTION("Dump")
+		{
+			auto tuple = TypeTuple::Create(2);
+			squareId.Call(tuple);
+
+			std::stringstream text{};
+			glas::Profiler::WriteProfileText(text);
+			REQUIRE(text.str().find("ProfiledSquare") != std::string::npos);
+
+			std::stringstream json{};
+			glas::Profiler::WriteProfileJson(json);
+			REQUIRE(json.str().find("\"Name\":\"ProfiledSquare\",\"Calls\":1,") != std::string::npos);
+		}
+	}
+
+	struct ConstructionCounter
+	{
+		ConstructionCounter() { ++Constructions; }
+		ConstructionCounter(const ConstructionCounter& other) : Value{ other.Value } { ++Constructions; ++Copies; }
+		ConstructionCounter(ConstructionCounter&& other) noexcept : Value{ other.Value } { ++Constructions; ++Moves; }
+		ConstructionCounter& operator=(const ConstructionCounter& other) { Value = other.Value; ++Assignments; return *this; }
+		ConstructionCounter& operator=(ConstructionCounter&& other) noexcept { Value = other.Value; ++Assignments; return *this; }
+		~ConstructionCounter() { ++Destructions; }
+
+		int Value{};
+
+		inline static int Constructions{};
+		inline static int Copies{};
+		inline static int Moves{};
+		inline static int Assignments{};
+		inline static int Destructions{};
+
+		static void ResetCounters() { Constructions = Copies = Moves = Assignments = Destructions = 0; }
+	};
+
+	GLAS_TYPE(ConstructionCounter);
+
+	ConstructionCounter CreateCounter()
+	{
+		return ConstructionCounter{};
+	}
+
+	GLAS_FUNCTION(CreateCounter);
+
+	std::string RepeatString(std::string value, int count)
+	{
+		std::string result{};
+		for (int i{}; i < count; ++i)
+		{
+			result += value;
+		}
+		return result;
+	}
+
+	GLAS_FUNCTION(RepeatString);
+
+	struct ReturnHolder
+	{
+		int& GetValue() { return Value; }
+
+		int Value{};
+	};
+
+	GLAS_MEMBER_FUNCTION(ReturnHolder, GetValue);
+
+	TEST_CASE("In Place Return Values", "[Invoke]")
+	{
+		SECTION("Call")
+		{
+			auto tuple = TypeTuple::Create();
+			ConstructionCounter::ResetCounters();
+
+			alignas(ConstructionCounter) uint8_t buffer[sizeof(ConstructionCounter)];
+			GLAS_FUNCTION_ID(CreateCounter).Call(tuple, buffer);
+			std::launder(reinterpret_cast<ConstructionCounter*>(buffer))->~ConstructionCounter();
+
+			REQUIRE(ConstructionCounter::Constructions == 1);
+			REQUIRE(ConstructionCounter::Assignments == 0);
+			REQUIRE(ConstructionCounter::Destructions == 1);
+		}
+
+		SECTION("Invoke")
+		{
+			auto tuple = TypeTuple::Create();
+			ConstructionCounter::ResetCounters();
+			{
+				auto result = GLAS_FUNCTION_ID(CreateCounter).Invoke(tuple);
+				REQUIRE(result.As<ConstructionCounter>());
+			}
+
+			REQUIRE(ConstructionCounter::Constructions == 1);
+			REQUIRE(ConstructionCounter::Copies == 0);
+			REQUIRE(ConstructionCounter::Moves == 0);
+			REQUIRE(ConstructionCounter::Assignments == 0);
+			REQUIRE(ConstructionCounter::Destructions == 1);
+		}
+
+		SECTION("Invoke String")
+		{
+			auto tuple = TypeTuple::Create(std::string("ab"), 3);
+			auto result = GLAS_FUNCTION_ID(RepeatString).Invoke(tuple);
+
+			REQUIRE(*result.As<std::string>() == "ababab");
+		}
+
+		SECTION("Reference Return")
+		{
+			ReturnHolder holder{ 5 };
+			auto tuple = TypeTuple::Create();
+			auto getValueId = GLAS_MEMBER_FUNCTION_ID(ReturnHolder, GetValue);
+
+			int* value{};
+			getValueId.MemberCall(&holder, tuple, &value);
+			REQUIRE(value == &holder.Value);
+
+			REQUIRE(getValueId.MemberInvoke(&holder, tuple).GetData() == nullptr);
+		}
+	}
+
+	struct SlotPadding
+	{
+		virtual ~SlotPadding() = default;
+		double Padding{};
+	};
+
+	struct SlotBase
+	{
+		virtual ~SlotBase() = default;
+
+		int GetBaseValue() const { return BaseValue; }
+		void AddBaseValue(int amount) { BaseValue += amount; }
+
+		int BaseValue{ 10 };
+	};
+
+	struct SlotChild : SlotPadding, SlotBase
+	{
+		int GetChildValue() const { return ChildValue; }
+
+		int ChildValue{ 20 };
+	};
+
+	GLAS_TYPE(SlotPadding);
+	GLAS_TYPE(SlotBase);
+	GLAS_TYPE(SlotChild);
+	GLAS_MEMBER_FUNCTION(SlotBase, GetBaseValue);
+	GLAS_CHILD(SlotPadding, SlotChild);
+	GLAS_CHILD(SlotBase, SlotChild);
+	GLAS_MEMBER_FUNCTION(SlotChild, GetChildValue);
+	GLAS_MEMBER_FUNCTION(SlotBase, AddBaseValue);
+
+	TEST_CASE("Method Dispatch Table", "[MethodTable]")
+	{
+		const glas::TypeInfo& baseInfo = glas::TypeId::Create<SlotBase>().GetInfo();
+		const glas::TypeInfo& childInfo = glas::TypeId::Create<SlotChild>().GetInfo();
+
+		SECTION("Slots")
+		{
+			REQUIRE(baseInfo.MethodTable.size() == 2);
+			REQUIRE(childInfo.MethodTable.size() == 3);
+
+			REQUIRE(baseInfo.GetMethodSlot(GLAS_MEMBER_FUNCTION_ID(SlotBase, GetBaseValue)) == 0);
+			REQUIRE(baseInfo.GetMethodSlot(GLAS_MEMBER_FUNCTION_ID(SlotBase, AddBaseValue)) == 1);
+			REQUIRE(baseInfo.GetMethodSlot(GLAS_MEMBER_FUNCTION_ID(SlotChild, GetChildValue)) == glas::InvalidMethodSlot);
+			REQUIRE(baseInfo.GetMethodSlot("Unknown") == glas::InvalidMethodSlot);
+
+			REQUIRE(childInfo.GetMethodSlot("GetBaseValue") != glas::InvalidMethodSlot);
+			REQUIRE(childInfo.GetMethodSlot("AddBaseValue") != glas::InvalidMethodSlot);
+			REQUIRE(childInfo.GetMethodSlot("GetChildValue") != glas::InvalidMethodSlot);
+		}
+
+		SECTION("Call")
+		{
+			SlotBase base{};
+			auto tuple = TypeTuple::Create();
+			int result{};
+
+			baseInfo.CallMethod(baseInfo.GetMethodSlot("GetBaseValue"), &base, tuple, &result);
+			REQUIRE(result == 10);
+		}
+
+		SECTION("Call Inherited")
+		{
+			SlotChild child{};
+			auto emptyTuple = TypeTuple::Create();
+			auto amountTuple = TypeTuple::Create(5);
+			int result{};
+
+			childInfo.CallMethod(childInfo.GetMethodSlot(GLAS_MEMBER_FUNCTION_ID(SlotBase, AddBaseValue)), &child, amountTuple);
+			REQUIRE(child.BaseValue == 15);
+
+			childInfo.CallMethod(childInfo.GetMethodSlot(GLAS_MEMBER_FUNCTION_ID(SlotBase, GetBaseValue)), &child, emptyTuple, &result);
+			REQUIRE(result == 15);
+
+			childInfo.CallMethod(childInfo.GetMethodSlot(GLAS_MEMBER_FUNCTION_ID(SlotChild, GetChildValue)), &child, emptyTuple, &result);
+			REQUIRE(result == 20);
+		}
+	}
+
+	int PureCallCount{};
+
+	std::string PureRepeat(const std::string& value, int count)
+	{
+		++PureCallCount;
+
+		std::string result{};
+		for (int i{}; i < count; ++i)
+		{
+			result += value;
+		}
+		return result;
+	}
+
+	GLAS_FUNCTION_PROP(PureRepeat, glas::FunctionProperties::Pure);
+
+	int PureOutput(int* output)
+	{
+		++PureCallCount;
+		return *output += 1;
+	}
+
+	GLAS_FUNCTION_PROP(PureOutput, glas::FunctionProperties::Pure);
+
+	TEST_CASE("Memoization", "[Memoization]")
+	{
+		auto repeatId = GLAS_FUNCTION_ID(PureRepeat);
+		glas::Memoization::Clear(repeatId);
+		PureCallCount = 0;
+
+		SECTION("Hits and Misses")
+		{
+			auto tuple = TypeTuple::Create(std::string("ab"), 2);
+
+			for (int i{}; i < 3; ++i)
+			{
+				auto result = repeatId.Invoke(tuple);
+				REQUIRE(*result.As<std::string>() == "abab");
+			}
+
+			auto otherTuple = TypeTuple::Create(std::string("ab"), 3);
+			REQUIRE(*repeatId.Invoke(otherTuple).As<std::string>() == "ababab");
+
+			REQUIRE(PureCallCount == 2);
+
+			auto statistics = glas::Memoization::GetStatistics(repeatId);
+			REQUIRE(statistics.Hits == 2);
+			REQUIRE(statistics.Misses == 2);
+			REQUIRE(statistics.Size == 2);
+		}
+
+		SECTION("Call")
+		{
+			auto tuple = TypeTuple::Create(std::string("x"), 4);
+
+			for (int i{}; i < 2; ++i)
+			{
+				alignas(std::string) uint8_t buffer[sizeof(std::string)];
+				repeatId.Call(tuple, buffer);
+
+				auto& result = *std::launder(reinterpret_cast<std::string*>(buffer));
+				REQUIRE(result == "xxxx");
+				result.~basic_string();
+			}
+
+			REQUIRE(PureCallCount == 1);
+		}
+
+		SECTION("Eviction")
+		{
+			glas::Memoization::SetCapacity(repeatId, 2);
+
+			for (int count : { 1, 2, 3, 1 })
+			{
+				auto tuple = TypeTuple::Create(std::string("a"), count);
+				repeatId.Call(tuple);
+			}
+
+			auto statistics = glas::Memoization::GetStatistics(repeatId);
+			REQUIRE(PureCallCount == 4);
+			REQUIRE(statistics.Evictions == 2);
+			REQUIRE(statistics.Size == 2);
+
+			glas::Memoization::SetCapacity(repeatId, GLAS_MEMOIZATION_CAPACITY);
+		}
+
+		SECTION("Concurrent Hits")
+		{
+			auto tuple = TypeTuple::Create(std::string("c"), 2);
+			repeatId.Call(tuple);
+
+			// the cache is stored inside of the function info after the first call
+			const glas::FunctionInfo& info = *repeatId.GetInfo();
+			REQUIRE(info.MemoizationCache == &glas::Memoization::GetFunctionCache(info));
+
+			std::vector<std::thread> threads;
+			for (int i{}; i < 4; ++i)
+			{
+				threads.emplace_back([repeatId]
+					{
+						auto threadTuple = TypeTuple::Create(std::string("c"), 2);
+						for (int j{}; j < 100; ++j)
+						{
+							repeatId.Call(threadTuple);
+						}
+					});
+			}
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			auto statistics = glas::Memoization::GetStatistics(repeatId);
+			REQUIRE(PureCallCount == 1);
+			REQUIRE(statistics.Hits == 400);
+			REQUIRE(statistics.Misses == 1);
+		}
+
+		SECTION("Not Memoizable")
+		{
+			int value{};
+			auto tuple = TypeTuple::Create(&value);
+
+			int result{};
+			for (int i{}; i < 3; ++i)
+			{
+				GLAS_FUNCTION_ID(PureOutput).Call(tuple, &result);
+			}
+
+			REQUIRE(PureCallCount == 3);
+			REQUIRE(result == 3);
+		}
+	}
+
+	std::vector<std::string> CommandLog{};
+
+	void LogCommand(const std::string& message, int count)
+	{
+		for (int i{}; i < count; ++i)
+		{
+			CommandLog.emplace_back(message);
+		}
+	}
+
+	GLAS_FUNCTION(LogCommand);
+
+	void LogCounter(ConstructionCounter counter)
+	{
+		(void)counter;
+		CommandLog.emplace_back("counter");
+	}
+
+	GLAS_FUNCTION(LogCounter);
+
+	void IncrementCommand(int* value)
+	{
+		++*value;
+	}
+
+	GLAS_FUNCTION(IncrementCommand);
+
+	TEST_CASE("Command Buffer", "[CommandBuffer]")
+	{
+		CommandLog.clear();
+		glas::CommandBuffer buffer{ 256 };
+
+		SECTION("Record Order")
+		{
+			ReturnHolder holder{ 1 };
+			int value{};
+
+			buffer.Add(GLAS_FUNCTION_ID(LogCommand), std::string("a"), 2);
+			buffer.Add(GLAS_FUNCTION_ID(IncrementCommand), &value);
+			buffer.AddMember(GLAS_MEMBER_FUNCTION_ID(ReturnHolder, GetValue), &holder);
+			buffer.AddTuple(GLAS_FUNCTION_ID(LogCommand), nullptr, TypeTuple::Create(std::string("b"), 1));
+
+			REQUIRE(buffer.Size() == 4);
+			REQUIRE(CommandLog.empty());
+
+			buffer.Execute();
+
+			REQUIRE(CommandLog == std::vector<std::string>{ "a", "a", "b" });
+			REQUIRE(value == 1);
+
+			buffer.Execute();
+			REQUIRE(value == 2);
+		}
+
+		SECTION("Sorted Execution")
+		{
+			int value{};
+			for (int i{}; i < 3; ++i)
+			{
+				buffer.Add(GLAS_FUNCTION_ID(LogCommand), std::to_string(i), 1);
+				buffer.Add(GLAS_FUNCTION_ID(IncrementCommand), &value);
+			}
+
+			buffer.Execute(true);
+
+			REQUIRE(CommandLog == std::vector<std::string>{ "0", "1", "2" });
+			REQUIRE(value == 3);
+		}
+
+		SECTION("Argument Lifetime")
+		{
+			ConstructionCounter::ResetCounters();
+			for (int i{}; i < 100; ++i)
+			{
+				buffer.Add(GLAS_FUNCTION_ID(LogCounter), ConstructionCounter{});
+			}
+
+			// the commands span multiple blocks
+			buffer.Execute();
+			REQUIRE(CommandLog.size() == 100);
+			REQUIRE(ConstructionCounter::Moves == 100);
+			REQUIRE(ConstructionCounter::Copies == 100);
+
+			buffer.Reset();
+			REQUIRE(buffer.Empty());
+			REQUIRE(ConstructionCounter::Constructions == ConstructionCounter::Destructions);
+		}
+
+		SECTION("Reuse")
+		{
+			for (int frame{}; frame < 3; ++frame)
+			{
+				buffer.Add(GLAS_FUNCTION_ID(LogCommand), std::string(64, 'x'), 1);
+				buffer.Add(GLAS_FUNCTION_ID(LogCommand), std::string("y"), 1);
+				buffer.Execute();
+				buffer.Reset();
+			}
+
+			REQUIRE(CommandLog.size() == 6);
+			REQUIRE(CommandLog[4] == std::string(64, 'x'));
+			REQUIRE(CommandLog[5] == "y");
+		}
+	}
+
+	int AddValues(int lhs, int rhs)
+	{
+		return lhs + rhs;
+	}
+
+	GLAS_FUNCTION(AddValues);
+
+	void ConsumeCounter(ConstructionCounter counter, int* value)
+	{
+		(void)counter;
+		++*value;
+	}
+
+	GLAS_FUNCTION(ConsumeCounter);
+
+	TEST_CASE("Delegate", "[Delegate]")
+	{
+		REQUIRE(sizeof(glas::Delegate) <= 64);
+
+		SECTION("Function")
+		{
+			auto add = glas::Delegate::Create(GLAS_FUNCTION_ID(AddValues));
+			REQUIRE(add);
+			REQUIRE(add.GetBoundArgumentCount() == 0);
+			REQUIRE(add.Invoke<int>(2, 3) == 5);
+
+			auto addTen = glas::Delegate::Create(GLAS_FUNCTION_ID(AddValues), 10);
+			REQUIRE(addTen.GetBoundArgumentCount() == 1);
+			REQUIRE(addTen.Invoke<int>(5) == 15);
+		}
+
+		SECTION("Method")
+		{
+			ReturnHolder holder{ 7 };
+			auto getValue = glas::Delegate::CreateMember(GLAS_MEMBER_FUNCTION_ID(ReturnHolder, GetValue), &holder);
+
+			REQUIRE(&getValue.Invoke<int&>() == &holder.Value);
+			REQUIRE(getValue.GetSubject() == &holder);
+		}
+
+		SECTION("Pointer Arguments")
+		{
+			int value{};
+			auto increment = glas::Delegate::Create(GLAS_FUNCTION_ID(IncrementCommand), &value);
+			increment();
+			increment();
+			REQUIRE(value == 2);
+
+			int other{};
+			glas::Delegate::Create(GLAS_FUNCTION_ID(IncrementCommand))(&other);
+			REQUIRE(other == 1);
+		}
+
+		SECTION("Copy and Compare")
+		{
+			int value{};
+			ConstructionCounter::ResetCounters();
+			{
+				auto consume = glas::Delegate::Create(GLAS_FUNCTION_ID(ConsumeCounter), ConstructionCounter{});
+				auto copy = consume;
+
+				REQUIRE(copy == consume);
+				REQUIRE(copy.GetFunction().GetId() == GLAS_FUNCTION_ID(ConsumeCounter).GetId());
+
+				copy(&value);
+				consume(&value);
+				REQUIRE(value == 2);
+
+				copy = glas::Delegate::Create(GLAS_FUNCTION_ID(AddValues), 1);
+				REQUIRE(!(copy == consume));
+				REQUIRE(copy.Invoke<int>(1) == 2);
+
+				copy = consume;
+				copy = copy;
+				REQUIRE(copy == consume);
+				copy(&value);
+				REQUIRE(value == 3);
+
+				auto moved = std::move(copy);
+				moved(&value);
+				REQUIRE(value == 4);
+			}
+			REQUIRE(ConstructionCounter::Constructions == ConstructionCounter::Destructions);
+
+			glas::Delegate empty{};
+			REQUIRE(!empty);
+		}
+	}
+
+	struct HierarchyRoot
+	{
+		virtual ~HierarchyRoot() = default;
+	};
+
+	struct HierarchyMiddle : HierarchyRoot {};
+	struct HierarchyLeaf : HierarchyMiddle {};
+	struct HierarchySibling : HierarchyRoot {};
+
+	GLAS_TYPE(HierarchyRoot);
+	GLAS_TYPE(HierarchyMiddle);
+	GLAS_TYPE(HierarchyLeaf);
+	GLAS_TYPE(HierarchySibling);
+	GLAS_CHILD(HierarchyMiddle, HierarchyLeaf);
+	GLAS_CHILD(HierarchyRoot, HierarchyMiddle);
+	GLAS_CHILD(HierarchyRoot, HierarchySibling);
+
+	struct LateRoot
+	{
+		virtual ~LateRoot() = default;
+	};
+
+	struct LateMiddle : LateRoot {};
+	struct LateLeaf : LateMiddle {};
+
+	TEST_CASE("Type Hierarchy", "[IsA]")
+	{
+		using glas::TypeId;
+
+		SECTION("Single Inheritance")
+		{
+			REQUIRE(glas::IsA(TypeId::Create<HierarchyLeaf>(), TypeId::Create<HierarchyLeaf>()));
+			REQUIRE(glas::IsA(TypeId::Create<HierarchyLeaf>(), TypeId::Create<HierarchyMiddle>()));
+			REQUIRE(glas::IsA(TypeId::Create<HierarchyLeaf>(), TypeId::Create<HierarchyRoot>()));
+			REQUIRE(glas::IsA(TypeId::Create<HierarchySibling>(), TypeId::Create<HierarchyRoot>()));
+
+			REQUIRE(!glas::IsA(TypeId::Create<HierarchyRoot>(), TypeId::Create<HierarchyLeaf>()));
+			REQUIRE(!glas::IsA(TypeId::Create<HierarchySibling>(), TypeId::Create<HierarchyMiddle>()));
+			REQUIRE(!glas::IsA(TypeId::Create<HierarchyLeaf>(), TypeId::Create<SlotBase>()));
+			REQUIRE(!glas::IsA(TypeId::Create<int>(), TypeId::Create<HierarchyRoot>()));
+		}
+
+		SECTION("Multiple Inheritance")
+		{
+			REQUIRE(glas::IsA(TypeId::Create<SlotChild>(), TypeId::Create<SlotBase>()));
+			REQUIRE(glas::IsA(TypeId::Create<SlotChild>(), TypeId::Create<SlotPadding>()));
+			REQUIRE(!glas::IsA(TypeId::Create<SlotBase>(), TypeId::Create<SlotPadding>()));
+		}
+
+		SECTION("Late Registration")
+		{
+			glas::RegisterChild<LateMiddle, LateLeaf>();
+			REQUIRE(glas::IsA(TypeId::Create<LateLeaf>(), TypeId::Create<LateMiddle>()));
+			REQUIRE(!glas::IsA(TypeId::Create<LateLeaf>(), TypeId::Create<LateRoot>()));
+
+			// registering a parent above an existing hierarchy updates every descendant
+			glas::RegisterChild<LateRoot, LateMiddle>();
+			REQUIRE(glas::IsA(TypeId::Create<LateLeaf>(), TypeId::Create<LateRoot>()));
+			REQUIRE(glas::IsA(TypeId::Create<LateLeaf>().GetInfo(), TypeId::Create<LateRoot>().GetInfo()));
+		}
+	}
+
+	struct CastExtra
+	{
+		virtual ~CastExtra() = default;
+		int64_t Extra{};
+	};
+
+	struct CastGrandChild final : CastExtra, SlotChild
+	{
+		int GrandChildValue{ 30 };
+	};
+
+	GLAS_TYPE(CastExtra);
+	GLAS_TYPE(CastGrandChild);
+	GLAS_CHILD(CastExtra, CastGrandChild);
+	GLAS_CHILD(SlotChild, CastGrandChild);
+
+	TEST_CASE("Reflected Casts", "[Cast]")
+	{
+		using glas::TypeId;
+
+		CastGrandChild grandChild{};
+		void* instance = &grandChild;
+
+		SECTION("Up Cast")
+		{
+			REQUIRE(glas::UpCast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<CastExtra>()) == static_cast<CastExtra*>(&grandChild));
+			REQUIRE(glas::UpCast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<SlotChild>()) == static_cast<SlotChild*>(&grandChild));
+			REQUIRE(glas::UpCast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<SlotBase>()) == static_cast<SlotBase*>(&grandChild));
+			REQUIRE(glas::UpCast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<SlotPadding>()) == static_cast<SlotPadding*>(&grandChild));
+			REQUIRE(glas::UpCast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<HierarchyRoot>()) == nullptr);
+		}
+
+		SECTION("Down Cast")
+		{
+			void* base = static_cast<SlotBase*>(&grandChild);
+			REQUIRE(glas::DownCast(base, TypeId::Create<SlotBase>(), TypeId::Create<CastGrandChild>()) == &grandChild);
+			REQUIRE(glas::DownCast(base, TypeId::Create<SlotBase>(), TypeId::Create<SlotChild>()) == static_cast<SlotChild*>(&grandChild));
+			REQUIRE(glas::DownCast(base, TypeId::Create<SlotBase>(), TypeId::Create<CastExtra>()) == nullptr);
+		}
+
+		SECTION("Cast")
+		{
+			void* base = static_cast<SlotBase*>(&grandChild);
+			REQUIRE(glas::Cast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<SlotBase>()) == base);
+			REQUIRE(glas::Cast(base, TypeId::Create<SlotBase>(), TypeId::Create<CastGrandChild>()) == instance);
+			REQUIRE(glas::Cast(instance, TypeId::Create<CastGrandChild>(), TypeId::Create<CastGrandChild>()) == instance);
+			REQUIRE(glas::Cast(base, TypeId::Create<SlotBase>(), TypeId::Create<SlotPadding>()) == nullptr);
+
+			// the dynamic type is found through the v-table of the instance
+			SlotChild* polymorphic = &grandChild;
+			const TypeId dynamicType = glas::GetTypeIDFromPolymorphic(polymorphic);
+			REQUIRE(dynamicType == TypeId::Create<CastGrandChild>());
+			auto* extra = static_cast<CastExtra*>(glas::Cast(glas::DownCast(polymorphic, TypeId::Create<SlotChild>(), dynamicType), dynamicType, TypeId::Create<CastExtra>()));
+			REQUIRE(extra == static_cast<CastExtra*>(&grandChild));
+		}
+	}
+
+	TEST_CASE("VTable Lookup", "[VTable]")
+	{
+		using glas::TypeId;
+
+		SECTION("Registry")
+		{
+			glas::VTableRegistry registry{};
+			std::vector<uint64_t> fakeVTables(1000);
+
+			for (size_t i{}; i < fakeVTables.size(); ++i)
+			{
+				REQUIRE(registry.Emplace(&fakeVTables[i], TypeId{ i + 1 }));
+			}
+
+			REQUIRE(!registry.Emplace(&fakeVTables[0], TypeId{ 5000 }));
+			REQUIRE(registry.Size() == fakeVTables.size());
+
+			for (size_t i{}; i < fakeVTables.size(); ++i)
+			{
+				REQUIRE(registry.Find(&fakeVTables[i]).GetId() == i + 1);
+			}
+
+			uint64_t unknown{};
+			REQUIRE(!registry.Find(&unknown).IsValid());
+		}
+
+		SECTION("Cache")
+		{
+			CastGrandChild grandChild{};
+			HierarchyLeaf leaf{};
+			HierarchySibling sibling{};
+
+			const std::array<const HierarchyRoot*, 2> roots{ &leaf, &sibling };
+			const SlotChild* slotChild = &grandChild;
+
+			glas::VTableCache<1> monomorphic{};
+			glas::VTableCache<2> polymorphic{};
+
+			for (int i{}; i < 4; ++i)
+			{
+				REQUIRE(monomorphic.Get(slotChild) == TypeId::Create<CastGrandChild>());
+				REQUIRE(polymorphic.Get(roots[0]) == TypeId::Create<HierarchyLeaf>());
+				REQUIRE(polymorphic.Get(roots[1]) == TypeId::Create<HierarchySibling>());
+				REQUIRE(polymorphic.Get(slotChild) == TypeId::Create<CastGrandChild>());
+			}
+
+			REQUIRE(glas::GetTypeIDFromPolymorphic(roots[0]) == TypeId::Create<HierarchyLeaf>());
+			REQUIRE(!monomorphic.Get(static_cast<const SlotChild*>(nullptr)).IsValid());
+		}
+	}
+
+	int TaggedConstructions{};
+
+	struct TaggedBase
+	{
+		TaggedBase() { ++TaggedConstructions; }
+		explicit TaggedBase(glas::VTableTag) {}
+		virtual ~TaggedBase() = default;
+	};
+
+	struct TaggedChild : TaggedBase
+	{
+		explicit TaggedChild(int value) : Value{ value } { ++TaggedConstructions; }
+		explicit TaggedChild(glas::VTableTag tag) : TaggedBase{ tag } {}
+
+		int Value{};
+	};
+
+	GLAS_TYPE(TaggedBase);
+	GLAS_TYPE(TaggedChild);
+	GLAS_CHILD(TaggedBase, TaggedChild);
+
+	TEST_CASE("VTable Tag", "[VTable]")
+	{
+		using glas::TypeId;
+
+		// registration did not run the regular constructors
+		REQUIRE(TaggedConstructions == 0);
+		REQUIRE(TypeId::Create<TaggedChild>().GetInfo().VTable);
+
+		TaggedBase base{};
+		TaggedChild child{ 5 };
+		const TaggedBase* childBase = &child;
+
+		REQUIRE(glas::GetTypeIDFromPolymorphic(&base) == TypeId::Create<TaggedBase>());
+		REQUIRE(glas::GetTypeIDFromPolymorphic(childBase) == TypeId::Create<TaggedChild>());
+		REQUIRE(TaggedConstructions == 3);
+	}
+	int UpdatedObjects{};
+
+	class UpdateComponent
+	{
+	public:
+		virtual ~UpdateComponent() = default;
+		virtual void Update(float deltaTime) { Time += deltaTime; ++UpdatedObjects; }
+
+		float Time{};
+	};
+
+	class MoveComponent final : public UpdateComponent
+	{
+	public:
+		void Update(float deltaTime) override { Position += Speed * deltaTime; ++UpdatedObjects; }
+
+		float Position{};
+		float Speed{ 2.f };
+		std::string Name{ "Move component with a heap allocated name" };
+	};
+
+	class SpinComponent : public UpdateComponent
+	{
+	public:
+		void Update(float deltaTime) override { Angle += deltaTime; UpdateComponent::Update(deltaTime); }
+
+		float Angle{};
+	};
+
+	class UpdateExtra
+	{
+	public:
+		virtual ~UpdateExtra() = default;
+
+		int Tag{ 42 };
+	};
+
+	class OffsetComponent final : public UpdateExtra, public UpdateComponent
+	{
+	public:
+		int Value{};
+	};
+
+	/** Never registered, so its dynamic type can not be resolved. */
+	class UnregisteredComponent final : public UpdateComponent
+	{
+	public:
+		int Value{};
+	};
+
+	GLAS_TYPE(UpdateComponent);
+	GLAS_TYPE(MoveComponent);
+	GLAS_TYPE(SpinComponent);
+	GLAS_TYPE(OffsetComponent);
+	GLAS_CHILD(UpdateComponent, MoveComponent);
+	GLAS_CHILD(UpdateComponent, SpinComponent);
+	GLAS_CHILD(UpdateExtra, OffsetComponent);
+	GLAS_CHILD(UpdateComponent, OffsetComponent);
+	GLAS_MEMBER_FUNCTION(UpdateComponent, Update);
+	GLAS_MEMBER_FUNCTION(MoveComponent, Update);
+
+	TEST_CASE("Polymorphic Vector", "[PolymorphicVector]")
+	{
+		using glas::TypeId;
+
+		glas::Storage::PolymorphicVector<UpdateComponent> components{};
+
+		for (int i{}; i < 10; ++i)
+		{
+			components.Emplace<MoveComponent>().Speed = static_cast<float>(i);
+			components.Emplace<SpinComponent>();
+			components.Emplace<OffsetComponent>().Value = i;
+		}
+		components.Emplace(TypeId::Create<UpdateComponent>());
+
+		REQUIRE(components.Size() == 31);
+		REQUIRE(components.GetBucketCount() == 4);
+		REQUIRE(components.Count(TypeId::Create<MoveComponent>()) == 10);
+		REQUIRE(components.Count(TypeId::Create<UpdateExtra>()) == 0);
+
+		SECTION("Bucketed Iteration")
+		{
+			// the objects of one type are visited together
+			std::vector<TypeId> visitedTypes{};
+			components.ForEach([&visitedTypes](UpdateComponent& component)
+				{
+					const TypeId type = glas::GetTypeIDFromPolymorphic(&component);
+					if (visitedTypes.empty() || visitedTypes.back() != type)
+						visitedTypes.emplace_back(type);
+				});
+			REQUIRE(visitedTypes.size() == 4);
+
+			UpdatedObjects = 0;
+			components.ForEach([](UpdateComponent& component) { component.Update(1.f); });
+			REQUIRE(UpdatedObjects == 31);
+
+			float totalPosition{};
+			components.ForEachOfType<MoveComponent>([&totalPosition](MoveComponent& component) { totalPosition += component.Position; });
+			REQUIRE(totalPosition == 45.f);
+
+			int tagSum{};
+			components.ForEachOfType<OffsetComponent>([&tagSum](OffsetComponent& component) { tagSum += component.Tag + component.Value; });
+			REQUIRE(tagSum == 42 * 10 + 45);
+		}
+
+		SECTION("Reflected Method")
+		{
+			UpdatedObjects = 0;
+			components.CallMethod(GLAS_MEMBER_FUNCTION_ID(UpdateComponent, Update), 0.5f);
+			REQUIRE(UpdatedObjects == 31);
+
+			float totalAngle{};
+			components.ForEachOfType<SpinComponent>([&totalAngle](SpinComponent& component) { totalAngle += component.Angle; });
+			REQUIRE(totalAngle == 5.f);
+
+			float totalTime{};
+			components.ForEachOfType<OffsetComponent>([&totalTime](OffsetComponent& component) { totalTime += component.Time; });
+			REQUIRE(totalTime == 5.f);
+		}
+
+		SECTION("Insertion and Removal")
+		{
+			MoveComponent move{};
+			move.Speed = 100.f;
+			UpdateComponent* copy = components.PushBackCopy(move);
+			REQUIRE(glas::GetTypeIDFromPolymorphic(copy) == TypeId::Create<MoveComponent>());
+			REQUIRE(static_cast<MoveComponent*>(copy)->Speed == 100.f);
+
+			OffsetComponent offset{};
+			offset.Value = 7;
+			UpdateComponent* moved = components.PushBackMove(offset);
+			REQUIRE(static_cast<OffsetComponent*>(moved)->Value == 7);
+			REQUIRE(static_cast<OffsetComponent*>(moved)->Tag == 42);
+			REQUIRE(components.Size() == 33);
+
+			// an object of an unregistered type would be sliced to its base
+			UnregisteredComponent unregistered{};
+			REQUIRE_THROWS_AS(components.PushBackCopy(unregistered), std::runtime_error);
+			REQUIRE_THROWS_AS(components.PushBackMove(unregistered), std::runtime_error);
+			REQUIRE(components.Size() == 33);
+
+			UpdateComponent* first{};
+			components.ForEach([&first](UpdateComponent& component) { if (!first) first = &component; });
+			components.Erase(first);
+			REQUIRE(components.Size() == 32);
+			REQUIRE(components.Count(TypeId::Create<MoveComponent>()) == 10);
+
+			// the last object of the type took the place of the removed object
+			REQUIRE(static_cast<MoveComponent*>(first)->Speed == 100.f);
+
+			components.Clear();
+			REQUIRE(components.IsEmpty());
+			REQUIRE(components.GetBucketCount() == 4);
+		}
+	}
+	struct BaseEvent
+	{
+		int Value{};
+	};
+
+	struct DamageEvent : BaseEvent
+	{
+		float Damage{};
+	};
+
+	struct EventExtra
+	{
+		int Extra{};
+	};
+
+	struct CriticalDamageEvent : EventExtra, DamageEvent
+	{
+		float Multiplier{ 2.f };
+	};
+
+	struct TextEvent
+	{
+		std::string Text{};
+	};
+
+	GLAS_TYPE(BaseEvent);
+	GLAS_TYPE(DamageEvent);
+	GLAS_TYPE(CriticalDamageEvent);
+	struct NestedEvent
+	{
+		int Value{};
+	};
+
+	GLAS_TYPE(TextEvent);
+	GLAS_TYPE(NestedEvent);
+	GLAS_CHILD(BaseEvent, DamageEvent);
+	GLAS_CHILD(EventExtra, CriticalDamageEvent);
+	GLAS_CHILD(DamageEvent, CriticalDamageEvent);
+
+	void CountEvent(void* context, const void*)
+	{
+		++*static_cast<int*>(context);
+	}
+
+	TEST_CASE("Event Dispatcher", "[Event]")
+	{
+		using glas::TypeId;
+
+		glas::EventDispatcher dispatcher{};
+
+		int baseValues{};
+		float totalDamage{};
+		std::vector<std::string> texts{};
+		int criticalEvents{};
+
+		dispatcher.Subscribe<BaseEvent>([&baseValues](const BaseEvent& event) { baseValues += event.Value; });
+		const glas::EventHandlerId damageHandler = dispatcher.Subscribe<DamageEvent>([&totalDamage](const DamageEvent& event) { totalDamage += event.Damage; });
+		dispatcher.Subscribe<TextEvent>([&texts](const TextEvent& event) { texts.emplace_back(event.Text); });
+		dispatcher.Subscribe(TypeId::Create<CriticalDamageEvent>(), &CountEvent, &criticalEvents);
+
+		REQUIRE(dispatcher.GetHandlerCount(TypeId::Create<BaseEvent>()) == 1);
+		REQUIRE(dispatcher.GetHandlerCount(TypeId::Create<DamageEvent>()) == 2);
+		REQUIRE(dispatcher.GetHandlerCount(TypeId::Create<CriticalDamageEvent>()) == 3);
+		REQUIRE(dispatcher.GetHandlerCount(TypeId::Create<EventExtra>()) == 0);
+
+		SECTION("Hierarchy Routing")
+		{
+			CriticalDamageEvent critical{};
+			critical.Extra = 100;
+			critical.Value = 3;
+			critical.Damage = 10.f;
+
+			dispatcher.Publish(BaseEvent{ 1 });
+			dispatcher.Publish(DamageEvent{ { 2 }, 5.f });
+			dispatcher.Publish(critical);
+
+			// the handlers of the base classes receive the event at the offset of their base class
+			REQUIRE(baseValues == 6);
+			REQUIRE(totalDamage == 15.f);
+			REQUIRE(criticalEvents == 1);
+			REQUIRE(texts.empty());
+		}
+
+		SECTION("Batches")
+		{
+			const std::vector<DamageEvent> damageEvents(10, DamageEvent{ { 1 }, 2.f });
+			dispatcher.Publish(std::span{ damageEvents });
+			REQUIRE(baseValues == 10);
+			REQUIRE(totalDamage == 20.f);
+
+			const TextEvent first{ "first" };
+			const TextEvent second{ "second" };
+			const CriticalDamageEvent critical{};
+			const EventExtra unrouted{};
+
+			const std::array events
+			{
+				glas::EventReference::Create(first),
+				glas::EventReference::Create(critical),
+				glas::EventReference::Create(unrouted),
+				glas::EventReference::Create(second),
+			};
+			dispatcher.Publish(std::span{ events });
+
+			REQUIRE(texts == std::vector<std::string>{ "first", "second" });
+			REQUIRE(criticalEvents == 1);
+		}
+
+		SECTION("Unsubscribe")
+		{
+			REQUIRE(dispatcher.Unsubscribe(damageHandler));
+			REQUIRE(!dispatcher.Unsubscribe(damageHandler));
+			REQUIRE(dispatcher.GetHandlerCount(TypeId::Create<CriticalDamageEvent>()) == 2);
+
+			dispatcher.Publish(DamageEvent{ { 2 }, 5.f });
+			REQUIRE(baseValues == 2);
+			REQUIRE(totalDamage == 0.f);
+		}
+
+		SECTION("Nested Publish")
+		{
+			int nestedEvents{};
+			dispatcher.Subscribe(TypeId::Create<NestedEvent>(), &CountEvent, &nestedEvents);
+
+			// the route of NestedEvent is built while the route of TextEvent is being dispatched
+			dispatcher.Subscribe<TextEvent>([&dispatcher](const TextEvent&) { dispatcher.Publish(NestedEvent{}); });
+
+			const std::vector<TextEvent> textEvents{ { "first" }, { "second" }, { "third" } };
+			dispatcher.Publish(std::span{ textEvents });
+
+			REQUIRE(texts == std::vector<std::string>{ "first", "second", "third" });
+			REQUIRE(nestedEvents == 3);
+		}
+
+		SECTION("Throwing Handler")
+		{
+			dispatcher.Subscribe<NestedEvent>([](const NestedEvent&) { throw std::runtime_error("handler failed"); });
+			REQUIRE_THROWS_AS(dispatcher.Publish(NestedEvent{}), std::runtime_error);
+
+			// the publish ended, so handlers can be added again
+			int nestedEvents{};
+			dispatcher.Subscribe(TypeId::Create<TextEvent>(), &CountEvent, &nestedEvents);
+			dispatcher.Publish(TextEvent{ "after" });
+			REQUIRE(nestedEvents == 1);
+		}
+	}
+
+	struct alignas(64) OverAlignedType
+	{
+		float Values[4]{ 1.f, 2.f, 3.f, 4.f };
+	};
+
+	GLAS_TYPE(OverAlignedType);
+
+	/** Memory resource that counts the allocations that have not been deallocated yet. */
+	class CountingResource final : public std::pmr::memory_resource
+	{
+	public:
+		size_t Allocations{};
+
+	private:
+		void* do_allocate(size_t bytes, size_t alignment) override
+		{
+			++Allocations;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* data, size_t bytes, size_t alignment) override
+		{
+			--Allocations;
+			std::pmr::new_delete_resource()->deallocate(data, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	TEST_CASE("Memory Resources", "[MemoryResource]")
+	{
+		using glas::TypeId;
+
+		const auto isAligned = [](const void* data, size_t alignment) { return reinterpret_cast<uintptr_t>(data) % alignment == 0; };
+
+		SECTION("Alignment")
+		{
+			auto storage = TypeStorage::Construct<OverAlignedType>();
+			REQUIRE(isAligned(storage.GetData(), 64));
+			REQUIRE(storage.As<OverAlignedType>()->Values[3] == 4.f);
+
+			auto shared = SharedTypeStorage::Construct<OverAlignedType>();
+			REQUIRE(isAligned(shared.GetData(), 64));
+
+			auto vector = TypeVector::Create<OverAlignedType>(5);
+			vector.Reserve(17);
+			for (const void* element : vector)
+			{
+				REQUIRE(isAligned(element, 64));
+			}
+		}
+
+		SECTION("Custom Resource")
+		{
+			CountingResource resource{};
+			{
+				auto storage = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, &resource);
+				REQUIRE(resource.Allocations == 1);
+				REQUIRE(storage.GetResource() == &resource);
+
+				// copies are allocated from the default resource
+				const OverAlignedType original{ { 5.f, 6.f, 7.f, 8.f } };
+				auto copy = TypeStorage::CopyConstruct(TypeId::Create<OverAlignedType>(), &original, &resource);
+				REQUIRE(resource.Allocations == 2);
+				const TypeStorage defaultCopy{ copy };
+				REQUIRE(defaultCopy.GetResource() == std::pmr::get_default_resource());
+				REQUIRE(defaultCopy.As<OverAlignedType>()->Values[2] == 7.f);
+
+				// assigning destroys and deallocates the previous instance
+				storage = TypeStorage{ TypeId::Create<Vector>() };
+				REQUIRE(resource.Allocations == 1);
+
+				auto vector = TypeVector::Create<Vector>(&resource);
+				for (int i{}; i < 100; ++i)
+				{
+					vector.PushBack<Vector>({ static_cast<float>(i), 0.f, 0.f });
+				}
+				REQUIRE(resource.Allocations == 2);
+				REQUIRE(vector.Get<Vector>(99).X == 99.f);
+
+				// moving a vector keeps its resource
+				TypeVector movedVector{ std::move(vector) };
+				REQUIRE(movedVector.GetResource() == &resource);
+				REQUIRE(resource.Allocations == 2);
+
+				std::array variables{ glas::VariableId::Create<Vector>(), glas::VariableId::Create<int>() };
+				TypeTuple tuple{ variables, &resource };
+				REQUIRE(tuple.GetResource() == &resource);
+				REQUIRE(resource.Allocations == 3);
+			}
+			REQUIRE(resource.Allocations == 0);
+		}
+
+		SECTION("Shared Storage")
+		{
+			CountingResource resource{};
+			bool isAlive{};
+			{
+				auto shared = SharedTypeStorage::Construct<CleanupTester>(std::allocator_arg, &resource, isAlive);
+				WeakTypeStorage weak{ shared };
+				REQUIRE(isAlive);
+
+				// the instance and the reference counts share a single allocation
+				REQUIRE(resource.Allocations == 1);
+
+				{
+					const SharedTypeStorage copy{ shared };
+					REQUIRE(copy.GetData() == shared.GetData());
+				}
+				REQUIRE(isAlive);
+
+				REQUIRE(weak.GetSharedStorage().GetData() == shared.GetData());
+				shared = {};
+				REQUIRE(!isAlive);
+				REQUIRE(weak.Expired());
+				REQUIRE(weak.GetSharedStorage().GetData() == nullptr);
+			}
+			REQUIRE(resource.Allocations == 0);
+		}
+
+		SECTION("Monotonic Arena")
+		{
+			CountingResource upstream{};
+			MonotonicArena arena{ 1024, &upstream };
+
+			void* first{};
+			{
+				auto storage = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, &arena);
+				auto vector = TypeVector::Create<Vector>(10, &arena);
+				first = storage.GetData();
+
+				REQUIRE(isAligned(storage.GetData(), 64));
+				REQUIRE(upstream.Allocations == 1);
+			}
+
+			// allocations that are larger than a block get their own block
+			{
+				auto vector = TypeVector::Create<OverAlignedType>(64, &arena);
+				REQUIRE(isAligned(vector.Data(), 64));
+				REQUIRE(arena.GetBlockCount() == 2);
+			}
+
+			// resetting the arena reuses the same memory
+			arena.Reset();
+			{
+				auto storage = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, &arena);
+				REQUIRE(storage.GetData() == first);
+				REQUIRE(upstream.Allocations == 2);
+			}
+
+			arena.Release();
+			REQUIRE(arena.GetBlockCount() == 0);
+			REQUIRE(upstream.Allocations == 0);
+		}
+
+		SECTION("Scoped Arena")
+		{
+			MonotonicArena arena{};
+
+			auto persistent = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, &arena);
+			const auto marker = arena.GetMarker();
+
+			void* temporary{};
+			{
+				ScopedArena scope{ arena };
+				auto storage = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, scope.GetResource());
+				temporary = storage.GetData();
+			}
+
+			const auto rewound = arena.GetMarker();
+			REQUIRE(rewound.Block == marker.Block);
+			REQUIRE(rewound.Offset == marker.Offset);
+
+			auto storage = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, &arena);
+			REQUIRE(storage.GetData() == temporary);
+		}
+
+		SECTION("Transfer Ownership")
+		{
+			auto storage = TypeStorage::Construct<Vector>(Vector{ 1.f, 2.f, 3.f });
+			auto vector = storage.TransferOwnershipCheck<Vector>();
+			REQUIRE(vector->Y == 2.f);
+			REQUIRE(storage.GetData() == nullptr);
+
+			MonotonicArena arena{};
+			auto arenaStorage = TypeStorage::Construct<OverAlignedType>(std::allocator_arg, &arena, OverAlignedType{ { 4.f, 5.f, 6.f, 7.f } });
+			REQUIRE_THROWS(arenaStorage.TransferOwnershipCheck<int>());
+
+			auto arenaValue = arenaStorage.TransferOwnershipCheck<OverAlignedType>();
+			REQUIRE(arenaValue->Values[2] == 6.f);
+			REQUIRE(arenaStorage.GetData() == nullptr);
+		}
+	}
+	struct ThrowingMoveType
+	{
+		ThrowingMoveType() = default;
+		ThrowingMoveType(ThrowingMoveType&& other) noexcept(false) : Value{ other.Value } {}
+
+		int Value{ 7 };
+	};
+
+	GLAS_TYPE(ThrowingMoveType);
+
+	TEST_CASE("Type Storage Inline Buffer", "[TypeStorage]")
+	{
+		using glas::TypeId;
+
+		SECTION("Inline Types")
+		{
+			REQUIRE(TypeStorage::FitsInline(TypeId::Create<int>().GetInfo()));
+			REQUIRE(TypeStorage::FitsInline(TypeId::Create<Vector>().GetInfo()));
+			REQUIRE(TypeStorage::FitsInline(TypeId::Create<CleanupTester>().GetInfo()));
+
+			// too large, over aligned or the move constructor can throw
+			REQUIRE(!TypeStorage::FitsInline(TypeId::Create<Transform>().GetInfo()));
+			REQUIRE(!TypeStorage::FitsInline(TypeId::Create<OverAlignedType>().GetInfo()));
+			REQUIRE(!TypeStorage::FitsInline(TypeId::Create<ThrowingMoveType>().GetInfo()));
+		}
+
+		SECTION("No Allocations")
+		{
+			CountingResource resource{};
+
+			auto integer = TypeStorage::Construct<int>(std::allocator_arg, &resource, 5);
+			auto vector = TypeStorage::Construct<Vector>(std::allocator_arg, &resource, 1.f, 2.f, 3.f);
+			const Vector original{ 4.f, 5.f, 6.f };
+			auto copy = TypeStorage::CopyConstruct(TypeId::Create<Vector>(), &original, &resource);
+			TypeStorage defaultConstructed{ TypeId::Create<Vector>(), &resource };
+
+			REQUIRE(resource.Allocations == 0);
+			REQUIRE(integer.IsInline());
+			REQUIRE(*integer.As<int>() == 5);
+			REQUIRE(vector.As<Vector>()->Z == 3.f);
+			REQUIRE(copy.As<Vector>()->X == 4.f);
+
+			auto throwing = TypeStorage::Construct<ThrowingMoveType>(std::allocator_arg, &resource);
+			REQUIRE(!throwing.IsInline());
+			REQUIRE(resource.Allocations == 1);
+		}
+
+		SECTION("Relocation")
+		{
+			bool isAlive{};
+			{
+				auto storage = TypeStorage::Construct<CleanupTester>(isAlive);
+				const void* address = storage.GetData();
+
+				TypeStorage moved{ std::move(storage) };
+				REQUIRE(isAlive);
+				REQUIRE(moved.IsInline());
+				REQUIRE(moved.GetData() != address);
+				REQUIRE(storage.GetData() == nullptr);
+				REQUIRE(!storage.GetType().IsValid());
+
+				TypeStorage assigned{ TypeId::Create<Vector>() };
+				assigned = std::move(moved);
+				REQUIRE(isAlive);
+				REQUIRE(assigned.As<CleanupTester>());
+			}
+			REQUIRE(!isAlive);
+
+			std::vector<TypeStorage> storages{};
+			for (int i{}; i < 100; ++i)
+			{
+				storages.emplace_back(TypeStorage::Construct<Vector>(static_cast<float>(i), 0.f, 0.f));
+			}
+			for (int i{}; i < 100; ++i)
+			{
+				REQUIRE(storages[i].As<Vector>()->X == static_cast<float>(i));
+				REQUIRE(storages[i].IsInline());
+			}
+		}
+	}
+	TEST_CASE("Shared Type Storage Reference Counts", "[SharedTypeStorage]")
+	{
+		using glas::TypeId;
+
+		SECTION("Single Allocation")
+		{
+			CountingResource resource{};
+			bool isAlive{};
+			{
+				auto shared = LocalSharedTypeStorage::Construct<CleanupTester>(std::allocator_arg, &resource, isAlive);
+				REQUIRE(resource.Allocations == 1);
+				REQUIRE(shared.GetUseCount() == 1);
+				REQUIRE(shared.GetType() == TypeId::Create<CleanupTester>());
+
+				LocalWeakTypeStorage weak{ shared };
+				{
+					auto copy = shared;
+					auto locked = weak.GetSharedStorage();
+					REQUIRE(shared.GetUseCount() == 3);
+					REQUIRE(locked.GetData() == shared.GetData());
+				}
+				REQUIRE(shared.GetUseCount() == 1);
+
+				// the weak storage keeps the memory alive, but not the instance
+				shared = {};
+				REQUIRE(!isAlive);
+				REQUIRE(weak.Expired());
+				REQUIRE(weak.GetData() == nullptr);
+				REQUIRE(weak.GetType() == TypeId::Create<CleanupTester>());
+				REQUIRE(resource.Allocations == 1);
+			}
+			REQUIRE(resource.Allocations == 0);
+		}
+
+		SECTION("Alignment")
+		{
+			auto shared = LocalSharedTypeStorage::Construct<OverAlignedType>();
+			REQUIRE(reinterpret_cast<uintptr_t>(shared.GetData()) % 64 == 0);
+			REQUIRE(shared.As<OverAlignedType>()->Values[1] == 2.f);
+		}
+
+		SECTION("Threads")
+		{
+			auto shared = SharedTypeStorage::Construct<Vector>(1.f, 2.f, 3.f);
+			WeakTypeStorage weak{ shared };
+
+			std::vector<std::thread> threads{};
+			for (int i{}; i < 4; ++i)
+			{
+				threads.emplace_back([&shared, &weak]
+					{
+						for (int j{}; j < 1000; ++j)
+						{
+							SharedTypeStorage copy{ shared };
+							SharedTypeStorage locked{ weak.GetSharedStorage() };
+						}
+					});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+
+			REQUIRE(shared.GetUseCount() == 1);
+			REQUIRE(shared.As<Vector>()->Y == 2.f);
+		}
+	}
+	/** Opts in to relocation by copying bytes, the move constructor must not be called when the vector grows. */
+	struct RelocatableCounter
+	{
+		RelocatableCounter() = default;
+		RelocatableCounter(const RelocatableCounter& other) : Value{ other.Value } {}
+		RelocatableCounter(RelocatableCounter&& other) noexcept : Value{ other.Value } { ++MoveCount; }
+		~RelocatableCounter() { ++DestructionCount; }
+
+		RelocatableCounter& operator=(const RelocatableCounter&) = default;
+
+		int Value{};
+
+		static inline int MoveCount{};
+		static inline int DestructionCount{};
+	};
+}
+
+GLAS_STORAGE_TRIVIALLY_RELOCATABLE(StorageTest::RelocatableCounter);
+
+namespace StorageTest
+{
+	GLAS_TYPE(RelocatableCounter);
+
+	TEST_CASE("Trivially Relocatable Types", "[TypeVector]")
+	{
+		using glas::TypeId;
+
+		SECTION("Traits")
+		{
+			REQUIRE(TypeId::Create<Vector>().GetInfo().TriviallyCopyable);
+			REQUIRE(TypeId::Create<Vector>().GetInfo().TriviallyRelocatable);
+			REQUIRE(!TypeId::Create<RelocatableCounter>().GetInfo().TriviallyCopyable);
+			REQUIRE(TypeId::Create<RelocatableCounter>().GetInfo().TriviallyRelocatable);
+			REQUIRE(!TypeId::Create<VerboseClass>().GetInfo().TriviallyRelocatable);
+		}
+
+		SECTION("Plain Data")
+		{
+			auto vector = TypeVector::Create<Vector>();
+			for (int i{}; i < 1000; ++i)
+			{
+				vector.PushBack<Vector>({ static_cast<float>(i), static_cast<float>(-i), 0.f });
+			}
+			vector.ShrinkToFit();
+			REQUIRE(vector.Capacity() == 1000);
+
+			const TypeVector copy{ vector };
+			vector.SwapRemove(10);
+			REQUIRE(vector.Size() == 999);
+			REQUIRE(vector.Get<Vector>(10).X == 999.f);
+			REQUIRE(vector.Get<Vector>(998).X == 998.f);
+			REQUIRE(copy.Get<Vector>(10).X == 10.f);
+			REQUIRE(copy.Get<Vector>(999).Y == -999.f);
+		}
+
+		SECTION("Opt In")
+		{
+			RelocatableCounter::MoveCount = 0;
+			RelocatableCounter::DestructionCount = 0;
+			{
+				auto vector = TypeVector::Create<RelocatableCounter>();
+				for (int i{}; i < 100; ++i)
+				{
+					static_cast<RelocatableCounter*>(vector.PushBack())->Value = i;
+				}
+				vector.Reserve(500);
+				REQUIRE(RelocatableCounter::MoveCount == 0);
+				REQUIRE(RelocatableCounter::DestructionCount == 0);
+
+				vector.SwapRemove(0);
+				REQUIRE(RelocatableCounter::DestructionCount == 1);
+				REQUIRE(vector.Get<RelocatableCounter>(0).Value == 99);
+				REQUIRE(vector.Get<RelocatableCounter>(98).Value == 98);
+				REQUIRE(RelocatableCounter::MoveCount == 0);
+			}
+			REQUIRE(RelocatableCounter::DestructionCount == 100);
+		}
+	}
+
+	TEST_CASE("Bulk Lifecycle Operations", "[TypeVector]")
+	{
+		using glas::TypeId;
+
+		SECTION("Value Construction")
+		{
+			int integers[16];
+			float floats[16];
+			std::fill_n(integers, 16, -1);
+			std::fill_n(floats, 16, -1.f);
+
+			TypeId::Create<int>().GetInfo().ConstructN(integers, 16);
+			TypeId::Create<float>().GetInfo().ConstructN(floats, 16);
+			REQUIRE(std::ranges::all_of(integers, [](int value) { return value == 0; }));
+			REQUIRE(std::ranges::all_of(floats, [](float value) { return value == 0.f; }));
+
+			Vector vectors[4];
+			std::ranges::fill(vectors, Vector{ 1.f, 2.f, 3.f });
+			TypeId::Create<Vector>().GetInfo().CopyConstructN(vectors + 2, vectors, 2);
+			REQUIRE(vectors[3].Z == 3.f);
+		}
+
+		SECTION("Resize And Pop")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				auto vector = TypeVector::Create<ConstructionCounter>();
+				vector.Resize(100);
+				REQUIRE(ConstructionCounter::Constructions == 100);
+
+				vector.Get<ConstructionCounter>(99).Value = 99;
+				vector.Reserve(400);
+				REQUIRE(ConstructionCounter::Moves == 100);
+				REQUIRE(ConstructionCounter::Destructions == 100);
+				REQUIRE(vector.Get<ConstructionCounter>(99).Value == 99);
+
+				vector.PopBack(40);
+				REQUIRE(vector.Size() == 60);
+				REQUIRE(ConstructionCounter::Destructions == 140);
+
+				vector.Get<ConstructionCounter>(49).Value = 49;
+				vector.Resize(50);
+				REQUIRE(vector.Size() == 50);
+				REQUIRE(vector.Capacity() == 400);
+				REQUIRE(ConstructionCounter::Destructions == 150);
+				REQUIRE(ConstructionCounter::Moves == 100);
+				REQUIRE(vector.Get<ConstructionCounter>(49).Value == 49);
+
+				vector.Resize(0);
+				REQUIRE(vector.Size() == 0);
+				REQUIRE(ConstructionCounter::Destructions == 200);
+
+				vector.Resize(10);
+				vector.Clear();
+				REQUIRE(ConstructionCounter::Constructions - ConstructionCounter::Moves == 110);
+				REQUIRE(ConstructionCounter::Destructions == 210);
+			}
+			REQUIRE(ConstructionCounter::Destructions == 210);
+		}
+
+		SECTION("Copy")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				auto source = TypeVector::Create<ConstructionCounter>();
+				source.Resize(20);
+				for (size_t i{}; i < source.Size(); ++i)
+				{
+					source.Get<ConstructionCounter>(i).Value = static_cast<int>(i);
+				}
+
+				TypeVector copy{ source };
+				REQUIRE(ConstructionCounter::Copies == 20);
+				REQUIRE(copy.Get<ConstructionCounter>(19).Value == 19);
+
+				auto target = TypeVector::Create<ConstructionCounter>();
+				target.Resize(5);
+				target = source;
+				REQUIRE(target.Size() == 20);
+				REQUIRE(ConstructionCounter::Copies == 40);
+				REQUIRE(ConstructionCounter::Destructions == 5);
+				REQUIRE(target.Get<ConstructionCounter>(7).Value == 7);
+
+				auto other = TypeVector::Create<Vector>();
+				other.PushBack<Vector>({ 1.f, 2.f, 3.f });
+				other = source;
+				REQUIRE(other.GetType().GetId() == TypeId::Create<ConstructionCounter>().GetId());
+				REQUIRE(other.Get<ConstructionCounter>(19).Value == 19);
+
+				other = copy;
+				REQUIRE(ConstructionCounter::Destructions == 25);
+			}
+			REQUIRE(ConstructionCounter::Destructions == ConstructionCounter::Constructions);
+		}
+	}
+
+	struct NamedTransform
+	{
+		std::string Name{ "Unnamed" };
+		Transform Local{};
+		int* Target{};
+		int Layers[3]{ 1, 2, 3 };
+		int Unregistered{ 7 };
+	};
+	GLAS_MEMBER(NamedTransform, Name);
+	GLAS_MEMBER(NamedTransform, Local);
+	GLAS_MEMBER(NamedTransform, Target);
+	GLAS_MEMBER(NamedTransform, Layers);
+
+	TEST_CASE("Structure Of Arrays Vector", "[TypeSoAVector]")
+	{
+		using glas::TypeId;
+		using glas::Storage::TypeSoAVector;
+
+		SECTION("Columns")
+		{
+			auto vector = TypeSoAVector::Create<Transform>();
+			REQUIRE(vector.GetColumns().size() == 10);
+			REQUIRE(vector.GetColumns()[0].Name == "Translation.X");
+			REQUIRE(vector.GetColumns()[3].Name == "Rotation.X");
+			REQUIRE(vector.GetColumns()[9].Name == "Scale.Z");
+			REQUIRE(vector.GetColumnIndex("Rotation.W") == 6);
+			REQUIRE(vector.GetColumnIndex("Rotation") == TypeSoAVector::InvalidColumn);
+
+			for (int i{}; i < 1000; ++i)
+			{
+				Transform transform{};
+				transform.Translation.X = static_cast<float>(i);
+				vector.PushBack(transform);
+			}
+			REQUIRE(vector.Size() == 1000);
+
+			for (float& x : vector.Column<float>("Translation.X"))
+			{
+				x += 1.f;
+			}
+
+			for (size_t i{}; i < vector.GetColumns().size(); ++i)
+			{
+				REQUIRE(reinterpret_cast<uintptr_t>(vector.GetAddress(i, 0)) % GLAS_STORAGE_SOA_COLUMN_ALIGN == 0);
+			}
+
+			const auto scaleY = std::as_const(vector).Column<float>("Scale.Y");
+			REQUIRE(scaleY.size() == 1000);
+			REQUIRE(std::ranges::all_of(scaleY, [](float value) { return value == 1.f; }));
+			REQUIRE(vector[500].Get<float>(0) == 501.f);
+
+			size_t rows{};
+			for (auto row : vector)
+			{
+				REQUIRE(row.Get<float>(0) == static_cast<float>(row.GetIndex() + 1));
+				++rows;
+			}
+			REQUIRE(rows == 1000);
+		}
+
+		SECTION("Erase")
+		{
+			auto vector = TypeSoAVector::Create<Transform>();
+			for (int i{}; i < 10; ++i)
+			{
+				Transform transform{};
+				transform.Rotation.W = static_cast<float>(i);
+				vector.PushBack(transform);
+			}
+
+			vector.Erase(2);
+			REQUIRE(vector.Size() == 9);
+			REQUIRE(vector.Column<float>("Rotation.W")[2] == 3.f);
+			REQUIRE(vector.Column<float>("Rotation.W")[8] == 9.f);
+
+			vector.SwapRemove(0);
+			REQUIRE(vector.Column<float>("Rotation.W")[0] == 9.f);
+
+			vector.PopBack();
+			REQUIRE(vector.Size() == 7);
+			REQUIRE(vector.Column<float>("Rotation.W")[6] == 7.f);
+		}
+
+		SECTION("Conversion")
+		{
+			auto vector = TypeSoAVector::Create<NamedTransform>();
+			REQUIRE(vector.GetColumns().size() == 13);
+			REQUIRE(vector.GetColumns()[0].Name == "Name");
+			REQUIRE(vector.GetColumns()[12].Name == "Layers");
+
+			int target{};
+			for (int i{}; i < 50; ++i)
+			{
+				NamedTransform named{};
+				named.Name = "Object With A Long Name " + std::to_string(i);
+				named.Local.Scale.Z = static_cast<float>(i);
+				named.Target = &target;
+				named.Layers[2] = i;
+				vector.PushBack(named);
+			}
+			vector.PushBack();
+			REQUIRE(vector.Column<std::string>("Name")[50] == "Unnamed");
+			REQUIRE(vector.Column<float>("Local.Scale.X")[50] == 1.f);
+			REQUIRE(vector.Column<int*>("Target")[50] == nullptr);
+			REQUIRE(vector.Column<int[3]>("Layers")[50][1] == 2);
+
+			vector.Erase(0);
+			REQUIRE(vector.Column<std::string>("Name")[0] == "Object With A Long Name 1");
+			REQUIRE(vector.Column<std::string>("Name")[48] == "Object With A Long Name 49");
+
+			const glas::Storage::TypeVector objects = vector.ToTypeVector();
+			REQUIRE(objects.Size() == 50);
+			REQUIRE(objects.Get<NamedTransform>(10).Name == "Object With A Long Name 11");
+			REQUIRE(objects.Get<NamedTransform>(10).Local.Scale.Z == 11.f);
+			REQUIRE(objects.Get<NamedTransform>(10).Target == &target);
+			REQUIRE(objects.Get<NamedTransform>(10).Layers[2] == 11);
+			REQUIRE(objects.Get<NamedTransform>(10).Unregistered == 7);
+
+			const TypeSoAVector split{ objects };
+			REQUIRE(split.Size() == 50);
+			REQUIRE(split.Column<std::string>("Name")[10] == "Object With A Long Name 11");
+
+			TypeSoAVector copy{ split };
+			REQUIRE(copy.Column<float>("Local.Scale.Z")[48] == 49.f);
+			copy = vector;
+			REQUIRE(copy.Size() == 50);
+			REQUIRE(copy.Column<std::string>("Name")[1] == "Object With A Long Name 2");
+
+			TypeSoAVector moved{ std::move(copy) };
+			REQUIRE(moved.Size() == 50);
+			REQUIRE(copy.Size() == 0);
+
+			moved = TypeSoAVector::Create<Transform>();
+			REQUIRE(moved.GetColumns().size() == 10);
+		}
+	}
+
+	TEST_CASE("Chunked Vector", "[TypeChunkedVector]")
+	{
+		using glas::TypeId;
+		using glas::Storage::TypeChunkedVector;
+
+		SECTION("Stable Addresses")
+		{
+			auto vector = TypeChunkedVector::Create<Vector>();
+			REQUIRE(vector.GetChunkCapacity() == GLAS_STORAGE_CHUNK_SIZE / sizeof(Vector));
+
+			std::vector<Vector*> elements{};
+			for (int i{}; i < 5000; ++i)
+			{
+				elements.emplace_back(&vector.Emplace<Vector>(static_cast<float>(i), 0.f, 0.f));
+			}
+			REQUIRE(vector.Size() == 5000);
+			REQUIRE(vector.GetChunkCount() == (5000 + vector.GetChunkCapacity() - 1) / vector.GetChunkCapacity());
+
+			for (int i{}; i < 5000; ++i)
+			{
+				REQUIRE(elements[i]->X == static_cast<float>(i));
+				REQUIRE(vector.GetIndex(elements[i]) == static_cast<size_t>(i));
+			}
+
+			for (size_t i{}; i < vector.GetChunkCount(); ++i)
+			{
+				REQUIRE(reinterpret_cast<uintptr_t>(vector.At(i * vector.GetChunkCapacity())) % GLAS_STORAGE_CHUNK_ALIGN == 0);
+			}
+		}
+
+		SECTION("Free List")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				auto vector = TypeChunkedVector::Create<ConstructionCounter>();
+				for (int i{}; i < 3000; ++i)
+				{
+					static_cast<ConstructionCounter*>(vector.PushBack())->Value = i;
+				}
+				REQUIRE(ConstructionCounter::Moves == 0);
+
+				ConstructionCounter* kept = &vector.Get<ConstructionCounter>(2999);
+				vector.Erase(10);
+				vector.Erase(&vector.Get<ConstructionCounter>(200));
+				REQUIRE(vector.Size() == 2998);
+				REQUIRE(ConstructionCounter::Destructions == 2);
+				REQUIRE(!vector.IsOccupied(10));
+				REQUIRE(kept->Value == 2999);
+
+				ConstructionCounter counter{};
+				counter.Value = -1;
+				auto* reused = static_cast<ConstructionCounter*>(vector.PushBackCopy(&counter));
+				REQUIRE(vector.GetIndex(reused) == 200);
+				REQUIRE(vector.Get<ConstructionCounter>(200).Value == -1);
+
+				size_t count{};
+				int sum{};
+				for (const void* element : std::as_const(vector))
+				{
+					sum += static_cast<const ConstructionCounter*>(element)->Value;
+					++count;
+				}
+				REQUIRE(count == 2999);
+				REQUIRE(sum == 2999 * 3000 / 2 - 10 - 200 - 1);
+
+				count = 0;
+				vector.ForEach([&count](void*) { ++count; });
+				REQUIRE(count == 2999);
+				REQUIRE(ConstructionCounter::Moves == 0);
+			}
+			REQUIRE(ConstructionCounter::Destructions == ConstructionCounter::Constructions);
+		}
+
+		SECTION("Shrink")
+		{
+			auto vector = TypeChunkedVector::Create<Vector>();
+			for (int i{}; i < 3000; ++i)
+			{
+				vector.PushBack();
+			}
+			vector.Erase(10);
+
+			for (size_t i{ 1500 }; i < 3000; ++i)
+			{
+				vector.Erase(i);
+			}
+			vector.ShrinkToFit();
+			REQUIRE(vector.GetChunkCount() == (1500 + vector.GetChunkCapacity() - 1) / vector.GetChunkCapacity());
+			REQUIRE(vector.GetIndex(vector.PushBack()) == 10);
+			REQUIRE(vector.GetIndex(vector.PushBack()) == 1500);
+			REQUIRE(vector.Size() == 1501);
+		}
+
+		SECTION("Move")
+		{
+			auto vector = TypeChunkedVector::Create<std::string>();
+			std::string value{ "A string that does not fit inside of the small string buffer" };
+			auto* element = static_cast<std::string*>(vector.PushBackMove(&value));
+
+			TypeChunkedVector moved{ std::move(vector) };
+			REQUIRE(moved.Size() == 1);
+			REQUIRE(vector.Size() == 0);
+			REQUIRE(*element == "A string that does not fit inside of the small string buffer");
+			REQUIRE(moved.begin() != moved.end());
+			REQUIRE(vector.begin() == vector.end());
+
+			moved.Clear();
+			REQUIRE(moved.IsEmpty());
+			REQUIRE(moved.begin() == moved.end());
+		}
+	}
+
+	TEST_CASE("Archetype Storage", "[ArchetypeStorage]")
+	{
+		using glas::TypeId;
+		using glas::Storage::Entity;
+		using glas::Storage::Archetype;
+		using glas::Storage::ArchetypeStorage;
+
+		SECTION("Queries")
+		{
+			ArchetypeStorage storage{};
+
+			std::vector<Entity> entities{};
+			for (int i{}; i < 10000; ++i)
+			{
+				if (i % 2)
+					entities.emplace_back(storage.Create(Vector{ static_cast<float>(i), 0.f, 0.f }, Quaternion{}));
+				else
+					entities.emplace_back(storage.Create(Vector{ static_cast<float>(i), 0.f, 0.f }));
+			}
+			REQUIRE(storage.GetEntityCount() == 10000);
+			REQUIRE(storage.GetArchetypeCount() == 3);
+
+			size_t count{};
+			storage.ForEach<Vector>([&count](Entity, Vector& translation)
+				{
+					translation.Y = translation.X * 2.f;
+					++count;
+				});
+			REQUIRE(count == 10000);
+
+			count = 0;
+			storage.ForEach<Quaternion, Vector>([&count](Entity entity, Quaternion& rotation, const Vector& translation)
+				{
+					REQUIRE(static_cast<int>(translation.X) % 2 == 1);
+					REQUIRE(entity.Index == static_cast<uint32_t>(translation.X));
+					rotation.W = translation.Y;
+					++count;
+				});
+			REQUIRE(count == 5000);
+			REQUIRE(storage.GetComponent<Quaternion>(entities[101])->W == 202.f);
+			REQUIRE(storage.GetComponent<Quaternion>(entities[100]) == nullptr);
+
+			const std::array<TypeId, 1> types{ TypeId::Create<Quaternion>() };
+			size_t rows{};
+			storage.Query(types, [&rows](Archetype& archetype)
+				{
+					const size_t column = archetype.GetColumn(TypeId::Create<Quaternion>());
+					for (size_t chunk{}; chunk < archetype.GetChunkCount(); ++chunk)
+					{
+						REQUIRE(reinterpret_cast<uintptr_t>(archetype.GetColumnData(chunk, column)) % GLAS_STORAGE_CHUNK_ALIGN == 0);
+						rows += archetype.GetChunkSize(chunk);
+					}
+				});
+			REQUIRE(rows == 5000);
+		}
+
+		SECTION("Components")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				ArchetypeStorage storage{};
+
+				const std::array<TypeId, 2> types{ TypeId::Create<ConstructionCounter>(), TypeId::Create<std::string>() };
+				const Entity first = storage.Create(types);
+				const Entity second = storage.Create(types);
+				const Entity third = storage.Create();
+				REQUIRE(ConstructionCounter::Constructions == 2);
+
+				*storage.GetComponent<std::string>(first) = "A string that does not fit inside of the small string buffer";
+				storage.GetComponent<ConstructionCounter>(second)->Value = 2;
+
+				storage.AddComponent<Vector>(first, 1.f, 2.f, 3.f);
+				REQUIRE(storage.HasComponent(first, TypeId::Create<Vector>()));
+				REQUIRE(ConstructionCounter::Moves == 2);
+				REQUIRE(storage.GetComponent<ConstructionCounter>(second)->Value == 2);
+				REQUIRE(*storage.GetComponent<std::string>(first) == "A string that does not fit inside of the small string buffer");
+				REQUIRE(storage.GetComponent<Vector>(first)->Z == 3.f);
+
+				storage.RemoveComponent<ConstructionCounter>(first);
+				REQUIRE(!storage.HasComponent(first, TypeId::Create<ConstructionCounter>()));
+				REQUIRE(ConstructionCounter::Destructions == 3);
+				REQUIRE(*storage.GetComponent<std::string>(first) == "A string that does not fit inside of the small string buffer");
+
+				storage.AddComponent(third, TypeId::Create<ConstructionCounter>());
+				REQUIRE(ConstructionCounter::Constructions - ConstructionCounter::Moves == 3);
+
+				const size_t archetypeCount = storage.GetArchetypeCount();
+				const Entity fourth = storage.Create(types);
+				storage.AddComponent<Vector>(fourth);
+				storage.RemoveComponent<ConstructionCounter>(fourth);
+				REQUIRE(storage.GetArchetypeCount() == archetypeCount);
+
+				storage.Destroy(second);
+				REQUIRE(!storage.IsAlive(second));
+				REQUIRE(storage.IsAlive(first));
+				REQUIRE(storage.GetEntityCount() == 3);
+
+				const Entity reused = storage.Create();
+				REQUIRE(reused.Index == second.Index);
+				REQUIRE(reused.Generation != second.Generation);
+				REQUIRE(!storage.IsAlive(second));
+			}
+			REQUIRE(ConstructionCounter::Destructions == ConstructionCounter::Constructions);
+		}
+
+		SECTION("Shrinking")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				ArchetypeStorage storage{};
+
+				const std::array<TypeId, 2> types{ TypeId::Create<ConstructionCounter>(), TypeId::Create<std::string>() };
+				std::vector<Entity> entities{};
+				for (size_t i{}; i < 1000; ++i)
+					entities.emplace_back(storage.Create(types));
+
+				// leaves empty chunks at the end of the archetype
+				for (size_t i{}; i < 900; ++i)
+					storage.Destroy(entities[i]);
+
+				size_t count{};
+				storage.ForEach<std::string>([&count](Entity, std::string&) { ++count; });
+				REQUIRE(count == 100);
+
+				size_t rows{};
+				storage.Query(types, [&rows](Archetype& archetype)
+					{
+						for (size_t chunk{}; chunk < archetype.GetChunkCount(); ++chunk)
+							rows += archetype.GetChunkSize(chunk);
+					});
+				REQUIRE(rows == 100);
+			}
+			REQUIRE(ConstructionCounter::Destructions == ConstructionCounter::Constructions);
+		}
+	}
+
+	TEST_CASE("Type Tuple Layouts", "[TypeTuple]")
+	{
+		SECTION("Shared Layouts")
+		{
+			auto first = TypeTuple::Create<int, std::string, double>();
+			auto second = TypeTuple::Create<int, std::string, double>();
+			auto other = TypeTuple::Create<double, int>();
+
+			REQUIRE(first.GetLayout() != nullptr);
+			REQUIRE(first.GetLayout() == second.GetLayout());
+			REQUIRE(first.GetLayout() != other.GetLayout());
+
+			// tuples that are created from VariableIds share the layout of the template signature
+			auto variables = glas::GetVariableArray<int, std::string&, double>();
+			TypeTuple fromIds{ variables };
+			REQUIRE(fromIds.GetLayout() == first.GetLayout());
+			REQUIRE(!fromIds.GetVariable(1).IsReference());
+		}
+
+		SECTION("Aligned Variables")
+		{
+			auto tuple = TypeTuple::Create<char, OverAlignedType, char>();
+
+			REQUIRE(reinterpret_cast<uintptr_t>(tuple.GetVoid(1)) % alignof(OverAlignedType) == 0);
+			REQUIRE(tuple.Get<OverAlignedType>(1).Values[0] == 1.f);
+
+			tuple.Get<char>(0) = 'a';
+			tuple.Get<char>(2) = 'b';
+			REQUIRE(tuple.Get<char>(0) == 'a');
+			REQUIRE(tuple.Get<OverAlignedType>(1).Values[3] == 4.f);
+			REQUIRE(tuple.Get<char>(2) == 'b');
+		}
+
+		SECTION("Copy")
+		{
+			auto tuple = TypeTuple::Create(5, std::string("a string that does not fit in the small buffer"), 2.5);
+
+			auto copy = tuple;
+			REQUIRE(copy.GetLayout() == tuple.GetLayout());
+			REQUIRE(copy.Get<int>(0) == 5);
+			REQUIRE(copy.Get<std::string>(1) == "a string that does not fit in the small buffer");
+			REQUIRE(copy.Get<double>(2) == 2.5);
+			REQUIRE(copy.GetVoid(1) != tuple.GetVoid(1));
+
+			copy.Get<std::string>(1) = "changed";
+			REQUIRE(tuple.Get<std::string>(1) == "a string that does not fit in the small buffer");
+
+			tuple = copy;
+			REQUIRE(tuple.Get<std::string>(1) == "changed");
+
+			auto trivial = TypeTuple::Create(1, 2.f);
+			auto trivialCopy = trivial;
+			REQUIRE(trivialCopy.Get<int>(0) == 1);
+			REQUIRE(trivialCopy.Get<float>(1) == 2.f);
+
+			// every pointer of an array of pointers is copied
+			int values[3]{ 1, 2, 3 };
+			auto pointerVariables = glas::GetVariableArray<int*[3], std::string>();
+			TypeTuple pointers{ pointerVariables };
+			auto** pointerArray = static_cast<int**>(pointers.GetVoid(0));
+			for (size_t i{}; i < 3; ++i)
+				pointerArray[i] = &values[i];
+
+			auto pointersCopy = pointers;
+			auto** pointerArrayCopy = static_cast<int**>(pointersCopy.GetVoid(0));
+			for (size_t i{}; i < 3; ++i)
+				REQUIRE(pointerArrayCopy[i] == &values[i]);
+
+			TypeTuple empty{};
+			auto emptyCopy = empty;
+			REQUIRE(emptyCopy.GetSize() == 0);
+			REQUIRE(emptyCopy.GetLayout() == nullptr);
+		}
+
+		SECTION("Clone")
+		{
+			MonotonicArena arena{};
+
+			auto tuple = TypeTuple::Create(std::string("clone"), 3);
+			auto clone = tuple.Clone(&arena);
+
+			REQUIRE(clone.GetResource() == &arena);
+			REQUIRE(clone.Get<std::string>(0) == "clone");
+			REQUIRE(clone.Get<int>(1) == 3);
+		}
+
+		SECTION("Reset")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				auto tuple = TypeTuple::Create<ConstructionCounter, int, ConstructionCounter>();
+				REQUIRE(ConstructionCounter::Constructions == 2);
+
+				tuple.Get<ConstructionCounter>(0).Value = 10;
+				tuple.Get<int>(1) = 20;
+				const void* data = tuple.GetVariableDataPtr();
+
+				tuple.Reset();
+				REQUIRE(tuple.GetVariableDataPtr() == data);
+				REQUIRE(tuple.Get<ConstructionCounter>(0).Value == 0);
+				REQUIRE(tuple.Get<int>(1) == 0);
+				REQUIRE(ConstructionCounter::Constructions == 4);
+				REQUIRE(ConstructionCounter::Destructions == 2);
+			}
+			REQUIRE(ConstructionCounter::Destructions == 4);
+		}
+	}
+
+	struct GridCell
+	{
+		int32_t X{};
+		int32_t Y{};
+	};
+	GLAS_TYPE(GridCell);
+
+	/** Key whose bytes are unique, but whose version is ignored by its own equality and hash. */
+	struct VersionedKey
+	{
+		int32_t Id{};
+		int32_t Version{};
+
+		bool operator==(const VersionedKey& other) const { return Id == other.Id; }
+	};
+}
+
+template <>
+struct std::hash<StorageTest::VersionedKey>
+{
+	size_t operator()(const StorageTest::VersionedKey& key) const noexcept { return std::hash<int32_t>{}(key.Id); }
+};
+
+namespace StorageTest
+{
+	GLAS_TYPE(VersionedKey);
+
+	/** Key with its own equality but without a std::hash that matches it. */
+	struct UnhashedKey
+	{
+		int32_t Id{};
+		int32_t Version{};
+
+		bool operator==(const UnhashedKey& other) const { return Id == other.Id; }
+	};
+	GLAS_TYPE(UnhashedKey);
+
+	TEST_CASE("Type Hash Map", "[TypeHashMap]")
+	{
+		using glas::TypeId;
+		using glas::TypeInfo;
+
+		SECTION("Hash And Equality")
+		{
+			const TypeInfo& cellInfo = TypeId::Create<GridCell>().GetInfo();
+			REQUIRE(cellInfo.TriviallyComparable);
+			REQUIRE(cellInfo.Hash);
+			REQUIRE(cellInfo.Equals);
+
+			const GridCell cell{ 1, 2 };
+			const GridCell sameCell{ 1, 2 };
+			const GridCell otherCell{ 2, 1 };
+			REQUIRE(cellInfo.Equals(&cell, &sameCell));
+			REQUIRE(!cellInfo.Equals(&cell, &otherCell));
+			REQUIRE(cellInfo.Hash(&cell) == cellInfo.Hash(&sameCell));
+			REQUIRE(cellInfo.Hash(&cell) != cellInfo.Hash(&otherCell));
+
+			// the padding of the vectors is ignored by comparing their members
+			const TypeInfo& transformInfo = TypeId::Create<Transform>().GetInfo();
+			REQUIRE(!transformInfo.TriviallyComparable);
+			REQUIRE(transformInfo.Hash);
+			REQUIRE(transformInfo.Equals);
+
+			Transform transform{};
+			// constructed inside of a filled buffer, so the padding differs from the other transform
+			alignas(Transform) std::byte buffer[sizeof(Transform)];
+			std::memset(buffer, 0xFF, sizeof(buffer));
+			Transform& sameTransform = *new (buffer) Transform{};
+			transform.Translation.Y = sameTransform.Translation.Y = 5.f;
+
+			REQUIRE(transformInfo.Equals(&transform, &sameTransform));
+			REQUIRE(transformInfo.Hash(&transform) == transformInfo.Hash(&sameTransform));
+
+			sameTransform.Rotation.W = 1.f;
+			REQUIRE(!transformInfo.Equals(&transform, &sameTransform));
+			REQUIRE(transformInfo.Hash(&transform) != transformInfo.Hash(&sameTransform));
+
+			REQUIRE(glas::Storage::IsComparable(transformInfo));
+
+			// unique bytes do not override the hash and equality of the type itself
+			REQUIRE(!TypeId::Create<VersionedKey>().GetInfo().TriviallyComparable);
+			REQUIRE(TypeId::Create<int>().GetInfo().TriviallyComparable);
+
+			auto versions = TypeHashMap::Create<VersionedKey, int>();
+			versions.Insert(VersionedKey{ 1, 1 }, 10);
+			REQUIRE(!versions.Insert(VersionedKey{ 1, 2 }, 20).second);
+			REQUIRE(*versions.Find<int>(VersionedKey{ 1, 3 }) == 10);
+
+			// hashing the bytes would not match operator==, so the key can not be hashed
+			const TypeInfo& unhashedInfo = TypeId::Create<UnhashedKey>().GetInfo();
+			REQUIRE(!unhashedInfo.TriviallyComparable);
+			REQUIRE(!unhashedInfo.Hash);
+			REQUIRE(unhashedInfo.Equals);
+			REQUIRE(!glas::Storage::IsComparable(unhashedInfo));
+
+			// the standard containers of the test class can not be hashed
+			REQUIRE(!glas::Storage::IsComparable(TypeId::Create<TestClass>().GetInfo()));
+			REQUIRE(!TypeId::Create<CleanupTester>().GetInfo().Hash);
+		}
+
+		SECTION("Insert Find And Erase")
+		{
+			auto map = TypeHashMap::Create<int, std::string>();
+			REQUIRE(map.IsEmpty());
+			REQUIRE(map.Find<std::string>(5) == nullptr);
+
+			for (int i{}; i < 1000; ++i)
+			{
+				const auto [value, inserted] = map.Insert(i, std::to_string(i));
+				REQUIRE(inserted);
+				REQUIRE(*value == std::to_string(i));
+			}
+
+			REQUIRE(map.Size() == 1000);
+			REQUIRE(map.Capacity() * 7 >= map.Size() * 8);
+			REQUIRE(!map.Insert(5, std::string("duplicate")).second);
+			REQUIRE(*map.Find<std::string>(5) == "5");
+
+			for (int i{}; i < 1000; i += 2)
+			{
+				REQUIRE(map.Erase(i));
+			}
+			REQUIRE(!map.Erase(0));
+			REQUIRE(map.Size() == 500);
+
+			for (int i{}; i < 1000; ++i)
+			{
+				REQUIRE(map.Contains(i) == (i % 2 == 1));
+			}
 
-}
\ No newline at end of file
+			// erased slots are reused
+			const size_t capacity = map.Capacity();
+			for (int i{}; i < 1000; i += 2)
+			{
+				map.Insert(i, std::to_string(i * 2));
+			}
+			REQUIRE(map.Capacity() == capacity);
+			REQUIRE(*map.Find<std::string>(10) == "20");
+			REQUIRE(*map.Find<std::string>(11) == "11");
+
+			int key{ 2000 };
+			auto* value = static_cast<std::string*>(map.FindOrInsert(&key));
+			REQUIRE(value->empty());
+			*value = "added";
+			REQUIRE(map.FindOrInsert(&key) == value);
+			REQUIRE(*map.Find<std::string>(2000) == "added");
+
+			size_t count{};
+			map.ForEach([&count](void* key, void* value)
+				{
+					REQUIRE(*static_cast<std::string*>(value) == (*static_cast<int*>(key) == 2000 ? "added" : std::to_string(*static_cast<int*>(key) * (*static_cast<int*>(key) % 2 ? 1 : 2))));
+					++count;
+				});
+			REQUIRE(count == 1001);
+
+			map.Clear();
+			REQUIRE(map.IsEmpty());
+			REQUIRE(!map.Contains(11));
+			REQUIRE(map.Capacity() == capacity);
+		}
+
+		SECTION("Reflected Keys")
+		{
+			auto cells = TypeHashMap::Create<GridCell, int>();
+			for (int32_t x{}; x < 32; ++x)
+			{
+				for (int32_t y{}; y < 32; ++y)
+				{
+					cells.Insert(GridCell{ x, y }, x * 32 + y);
+				}
+			}
+			REQUIRE(cells.Size() == 1024);
+			REQUIRE(*cells.Find<int>(GridCell{ 3, 7 }) == 3 * 32 + 7);
+			REQUIRE(!cells.Contains(GridCell{ 32, 0 }));
+
+			auto transforms = TypeHashMap::Create<Transform, std::string>();
+			Transform transform{};
+			transform.Scale.X = 2.f;
+			transforms.Insert(transform, std::string("scaled"));
+			transforms.Insert(Transform{}, std::string("identity"));
+
+			Transform lookup{};
+			lookup.Scale.X = 2.f;
+			REQUIRE(*transforms.Find<std::string>(lookup) == "scaled");
+			REQUIRE(*transforms.Find<std::string>(Transform{}) == "identity");
+		}
+
+		SECTION("Copy And Move")
+		{
+			ConstructionCounter::ResetCounters();
+			{
+				auto map = TypeHashMap::Create<std::string, ConstructionCounter>();
+				for (int i{}; i < 100; ++i)
+				{
+					const std::string key = "key " + std::to_string(i);
+					static_cast<ConstructionCounter*>(map.FindOrInsert(&key))->Value = i;
+				}
+
+				auto copy = map;
+				REQUIRE(copy.Size() == 100);
+				REQUIRE(copy.Find<ConstructionCounter>(std::string("key 42"))->Value == 42);
+				REQUIRE(copy.Find<ConstructionCounter>(std::string("key 42")) != map.Find<ConstructionCounter>(std::string("key 42")));
+
+				copy.Erase(std::string("key 42"));
+				REQUIRE(map.Contains(std::string("key 42")));
+
+				auto moved = std::move(map);
+				REQUIRE(moved.Size() == 100);
+				REQUIRE(map.IsEmpty());
+				REQUIRE(!map.Contains(std::string("key 1")));
+
+				map = copy;
+				REQUIRE(map.Size() == 99);
+				REQUIRE(map.Find<ConstructionCounter>(std::string("key 99"))->Value == 99);
+			}
+			REQUIRE(ConstructionCounter::Constructions == ConstructionCounter::Destructions);
+		}
+
+		SECTION("Memory Resource")
+		{
+			CountingResource resource{};
+			{
+				auto map = TypeHashMap::Create<int, double>(&resource);
+				map.Reserve(100);
+				const size_t capacity = map.Capacity();
+				REQUIRE(capacity * 7 >= 100 * 8);
+
+				for (int i{}; i < 100; ++i)
+				{
+					map.Insert(i, i * 0.5);
+				}
+				REQUIRE(map.Capacity() == capacity);
+				REQUIRE(map.GetResource() == &resource);
+				REQUIRE(*map.Find<double>(99) == 49.5);
+			}
+			REQUIRE(resource.Allocations == 0);
+		}
+	}
+}
@@ -0,0 +1,429 @@
+#pragma once
+
+#ifdef GLAS_ASYNC
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <exception>
+#include <condition_variable>
+
+#include "../glas_decl.h"
+#include "glas_async_config.h"
+
+namespace glas::Async
+{
+	/**
+	 * CALL STATE
+	 */
+
+	inline CallState::CallState(FunctionId function, void* subject, Storage::TypeTuple&& parameters)
+		: Function{ function }
+		, Subject{ subject }
+		, Parameters{ std::move(parameters) }
+	{
+		Execute = &CallState::Run;
+	}
+
+	inline void CallState::RemoveReference()
+	{
+		if (m_ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			delete this;
+		}
+	}
+
+	inline void CallState::Run(Task* task)
+	{
+		auto state = static_cast<CallState*>(task);
+		const FunctionInfo* info = state->Function.GetInfo();
+
+		try
+		{
+			// references and pointers are not owned by the handle, so the return value is discarded
+			if (state->Subject)
+				state->Result = info->MemberInvoke(state->Subject, state->Parameters);
+			else
+				state->Result = info->Invoke(state->Parameters);
+		}
+		catch (...)
+		{
+			state->Exception = std::current_exception();
+		}
+
+		const uint8_t previousStatus = state->Status.exchange(Done, std::memory_order_acq_rel);
+		state->Status.notify_all();
+
+		if (previousStatus == CallbackSet)
+		{
+			state->AddReference();
+			CallHandle handle{ state };
+			state->Callback(handle, state->CallbackData);
+		}
+
+		// release the reference that was held by the thread pool
+		state->RemoveReference();
+	}
+
+	/**
+	 * CALL HANDLE
+	 */
+
+	inline CallHandle::CallHandle(CallState* state)
+		: m_State{ state }
+	{}
+
+	inline CallHandle::~CallHandle()
+	{
+		if (m_State)
+		{
+			m_State->RemoveReference();
+		}
+	}
+
+	inline CallHandle::CallHandle(const CallHandle& other)
+		: m_State{ other.m_State }
+	{
+		if (m_State)
+		{
+			m_State->AddReference();
+		}
+	}
+
+	inline CallHandle::CallHandle(CallHandle&& other) noexcept
+		: m_State{ other.m_State }
+	{
+		other.m_State = nullptr;
+	}
+
+	inline CallHandle& CallHandle::operator=(const CallHandle& other)
+	{
+		if (this != &other)
+		{
+			if (other.m_State)	other.m_State->AddReference();
+			if (m_State)		m_State->RemoveReference();
+			m_State = other.m_State;
+		}
+		return *this;
+	}
+
+	inline CallHandle& CallHandle::operator=(CallHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_State) m_State->RemoveReference();
+			m_State = other.m_State;
+			other.m_State = nullptr;
+		}
+		return *this;
+	}
+
+	inline bool CallHandle::IsReady() const
+	{
+		assert(m_State);
+		return m_State->Status.load(std::memory_order_acquire) == CallState::Done;
+	}
+
+	inline void CallHandle::Wait() const
+	{
+		assert(m_State);
+		uint8_t status = m_State->Status.load(std::memory_order_acquire);
+		while (status != CallState::Done)
+		{
+			m_State->Status.wait(status, std::memory_order_acquire);
+			status = m_State->Status.load(std::memory_order_acquire);
+		}
+	}
+
+	inline Storage::TypeStorage& CallHandle::GetResult()
+	{
+		Wait();
+
+		if (m_State->Exception)
+			std::rethrow_exception(m_State->Exception);
+
+		return m_State->Result;
+	}
+
+	inline void CallHandle::OnComplete(CallCallback callback, void* userData)
+	{
+		assert(m_State && callback && !m_State->Callback && "Only one callback can be set per call");
+
+		m_State->Callback = callback;
+		m_State->CallbackData = userData;
+
+		uint8_t expected = CallState::Pending;
+		if (!m_State->Status.compare_exchange_strong(expected, CallState::CallbackSet, std::memory_order_acq_rel))
+		{
+			// the call already finished, the worker will not execute the callback anymore
+			callback(*this, userData);
+		}
+	}
+
+	inline FunctionId CallHandle::GetFunctionId() const
+	{
+		return m_State ? m_State->Function : FunctionId{};
+	}
+
+	/**
+	 * THREAD POOL
+	 */
+
+	inline ThreadPool::ThreadPool(uint32_t threadCount)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		m_ThreadCount = threadCount;
+		m_Queues = std::make_unique<WorkQueue[]>(threadCount);
+
+		m_Threads.reserve(threadCount);
+		for (uint32_t i{}; i < threadCount; ++i)
+		{
+			m_Threads.emplace_back([this, i] { WorkerLoop(i); });
+		}
+	}
+
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock{ m_SleepMutex };
+			m_Stop = true;
+		}
+		m_SleepCondition.notify_all();
+
+		for (auto& thread : m_Threads)
+		{
+			thread.join();
+		}
+	}
+
+	inline void ThreadPool::Submit(Task* task)
+	{
+		assert(task && task->Execute);
+
+		PushList(GetSubmitQueue(), task, task);
+		m_Pending.fetch_add(1, std::memory_order_release);
+		WakeWorkers(1);
+	}
+
+	inline void ThreadPool::Submit(Task* first, size_t count)
+	{
+		if (!first || count == 0)
+			return;
+
+		const uint32_t queueCount = GetThreadCount();
+		const size_t tasksPerQueue = (count + queueCount - 1) / queueCount;
+
+		uint32_t queueIndex = GetSubmitQueue();
+		Task* current = first;
+		while (current)
+		{
+			// cut the next part of the list for the current queue
+			Task* last = current;
+			for (size_t i{ 1 }; i < tasksPerQueue && last->Next; ++i)
+			{
+				last = last->Next;
+			}
+			Task* next = last->Next;
+
+			PushList(queueIndex, current, last);
+
+			current = next;
+			queueIndex = (queueIndex + 1) % queueCount;
+		}
+
+		m_Pending.fetch_add(count, std::memory_order_release);
+		WakeWorkers(count);
+	}
+
+	inline void ThreadPool::WorkerLoop(uint32_t index)
+	{
+		t_WorkerPool = this;
+		t_WorkerIndex = index;
+
+		while (true)
+		{
+			if (Task* task = PopTask(index))
+			{
+				task->Execute(task);
+				continue;
+			}
+
+			std::unique_lock lock{ m_SleepMutex };
+			m_SleepCondition.wait(lock, [this] { return m_Stop || m_Pending.load(std::memory_order_acquire) != 0; });
+
+			if (m_Stop && m_Pending.load(std::memory_order_acquire) == 0)
+				return;
+		}
+	}
+
+	inline Task* ThreadPool::PopTask(uint32_t index)
+	{
+		const uint32_t queueCount = GetThreadCount();
+
+		// first try the own queue, after that steal from the other workers
+		for (uint32_t i{}; i < queueCount; ++i)
+		{
+			WorkQueue& queue = m_Queues[(index + i) % queueCount];
+
+			std::lock_guard lock{ queue.Mutex };
+			if (Task* task = queue.Head)
+			{
+				queue.Head = task->Next;
+				if (!queue.Head)
+					queue.Tail = nullptr;
+
+				task->Next = nullptr;
+				m_Pending.fetch_sub(1, std::memory_order_relaxed);
+				return task;
+			}
+		}
+		return nullptr;
+	}
+
+	inline void ThreadPool::PushList(uint32_t queueIndex, Task* first, Task* last)
+	{
+		WorkQueue& queue = m_Queues[queueIndex];
+
+		std::lock_guard lock{ queue.Mutex };
+		last->Next = nullptr;
+		if (queue.Tail)
+			queue.Tail->Next = first;
+		else
+			queue.Head = first;
+		queue.Tail = last;
+	}
+
+	inline uint32_t ThreadPool::GetSubmitQueue()
+	{
+		// work submitted from a worker stays on the queue of that worker
+		if (t_WorkerPool == this)
+			return t_WorkerIndex;
+
+		return m_NextQueue.fetch_add(1, std::memory_order_relaxed) % GetThreadCount();
+	}
+
+	inline void ThreadPool::WakeWorkers(size_t count)
+	{
+		{
+			// makes sure that a worker is either waiting or will see the new pending count
+			std::lock_guard lock{ m_SleepMutex };
+		}
+
+		if (count == 1)
+			m_SleepCondition.notify_one();
+		else
+			m_SleepCondition.notify_all();
+	}
+
+	inline ThreadPool& GetThreadPool()
+	{
+		static ThreadPool threadPool{ GLAS_ASYNC_THREAD_COUNT };
+		return threadPool;
+	}
+
+	/**
+	 * CALLS
+	 */
+
+	inline CallState* CreateCallState(FunctionId function, void* subject, Storage::TypeTuple&& parameters, CallCallback callback, void* userData)
+	{
+		const FunctionInfo* info = function.GetInfo();
+
+		// validate on the calling thread so that mistakes do not surface on a worker
+		assert(info && "Function is not registered");
+		assert(info->IsCompatible(parameters.GetVariableIds()));
+		assert(subject ? info->MethodCaller != nullptr : info->FunctionCaller != nullptr);
+		(void)info;
+
+		auto state = new CallState(function, subject, std::move(parameters));
+		if (callback)
+		{
+			state->Callback = callback;
+			state->CallbackData = userData;
+			state->Status.store(CallState::CallbackSet, std::memory_order_relaxed);
+		}
+
+		// one reference for the thread pool and one for the handle
+		state->AddReference();
+		return state;
+	}
+
+	inline CallHandle CallAsync(ThreadPool& pool, FunctionId function, void* subject, Storage::TypeTuple&& parameters, CallCallback callback, void* userData)
+	{
+		CallState* state = CreateCallState(function, subject, std::move(parameters), callback, userData);
+		CallHandle handle{ state };
+
+		pool.Submit(state);
+		return handle;
+	}
+
+	/**
+	 * CALL BATCH
+	 */
+
+	inline CallBatch::CallBatch(ThreadPool& pool)
+		: m_Pool{ &pool }
+	{}
+
+	inline CallBatch::CallBatch()
+		: m_Pool{ &GetThreadPool() }
+	{}
+
+	inline CallBatch::~CallBatch()
+	{
+		Submit();
+	}
+
+	inline CallHandle CallBatch::Add(FunctionId function, Storage::TypeTuple&& parameters, CallCallback callback, void* userData)
+	{
+		return AddMember(function, nullptr, std::move(parameters), callback, userData);
+	}
+
+	inline CallHandle CallBatch::AddMember(FunctionId function, void* subject, Storage::TypeTuple&& parameters, CallCallback callback, void* userData)
+	{
+		CallState* state = CreateCallState(function, subject, std::move(parameters), callback, userData);
+
+		if (m_Last)
+			m_Last->Next = state;
+		else
+			m_First = state;
+		m_Last = state;
+		++m_Count;
+
+		return CallHandle{ state };
+	}
+
+	inline void CallBatch::Submit()
+	{
+		if (m_Count == 0)
+			return;
+
+		m_Pool->Submit(m_First, m_Count);
+
+		m_First = nullptr;
+		m_Last = nullptr;
+		m_Count = 0;
+	}
+}
+
+namespace glas
+{
+	inline Async::CallHandle FunctionId::CallAsync(Storage::TypeTuple&& parameters, Async::CallCallback callback, void* userData) const
+	{
+		return Async::CallAsync(Async::GetThreadPool(), *this, nullptr, std::move(parameters), callback, userData);
+	}
+
+	inline Async::CallHandle FunctionId::MemberCallAsync(void* subject, Storage::TypeTuple&& parameters, Async::CallCallback callback, void* userData) const
+	{
+		assert(subject);
+		return Async::CallAsync(Async::GetThreadPool(), *this, subject, std::move(parameters), callback, userData);
+	}
+}
+
+#endif
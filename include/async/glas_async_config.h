@@ -0,0 +1,245 @@
+#pragma once
+
+#ifdef GLAS_ASYNC
+
+#ifndef GLAS_STORAGE
+#error "GLAS_ASYNC requires the GLAS_STORAGE addon to be enabled"
+#endif
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <exception>
+#include <condition_variable>
+
+#include "../glas_decl.h"
+#include "../storage/glas_storage_config.h"
+
+/**
+ * Settings
+ */
+
+/**
+ * Amount of worker threads used by the default thread pool.
+ * When set to 0, the amount of hardware threads will be used.
+ * @see GetThreadPool
+ */
+#ifndef GLAS_ASYNC_THREAD_COUNT
+#define GLAS_ASYNC_THREAD_COUNT 0
+#endif
+
+namespace glas::Async
+{
+	class ThreadPool;
+	class CallHandle;
+
+	/**
+	 * Intrusive unit of work that can be scheduled on a ThreadPool.
+	 * Tasks are linked together using the Next pointer so that scheduling never has to allocate.
+	 * The owner of the task is responsible for keeping it alive until Execute has been called.
+	 */
+	struct Task
+	{
+		/** Function that will be executed by a worker thread. */
+		void (*Execute)(Task*) { };
+
+		/** Next task inside of the queue or batch. */
+		Task* Next{ };
+	};
+
+	/**
+	 * Shared state of an asynchronous reflected call.
+	 * Holds the parameters, the return value and the completion status of the call.
+	 * The state is reference counted and shared between the thread pool and the CallHandles.
+	 */
+	class CallState final : public Task
+	{
+	public:
+		CallState(FunctionId function, void* subject, Storage::TypeTuple&& parameters);
+
+		CallState(const CallState&) = delete;
+		CallState(CallState&&) noexcept = delete;
+		CallState& operator=(const CallState&) = delete;
+		CallState& operator=(CallState&&) noexcept = delete;
+
+	public:
+		static constexpr uint8_t Pending		= 0; /**< The call has not finished yet*/
+		static constexpr uint8_t CallbackSet	= 1; /**< The call has not finished yet and a callback is waiting for it*/
+		static constexpr uint8_t Done			= 2; /**< The call has finished*/
+
+		void AddReference() { m_ReferenceCount.fetch_add(1, std::memory_order_relaxed); }
+		void RemoveReference();
+
+		/** Executes the call, stores the result and notifies any waiting threads. */
+		static void Run(Task* task);
+
+	public:
+		FunctionId					Function		{ };
+		void*						Subject			{ }; /**< Instance of the owning class in case the function is a method*/
+		Storage::TypeTuple			Parameters		{ };
+		Storage::TypeStorage		Result			{ };
+		std::exception_ptr			Exception		{ }; /**< Exception that was thrown during the call*/
+		CallCallback				Callback		{ };
+		void*						CallbackData	{ };
+		std::atomic<uint8_t>		Status			{ Pending };
+
+	private:
+		std::atomic<uint32_t>		m_ReferenceCount{ 1 };
+	};
+
+	/**
+	 * Future-like handle to an asynchronous reflected call.
+	 * Owns the return value of the function inside of a TypeStorage once the call has finished.
+	 * @see FunctionId::CallAsync
+	 * @see FunctionId::MemberCallAsync
+	 */
+	class CallHandle final
+	{
+	public:
+		CallHandle() = default;
+		explicit CallHandle(CallState* state);
+		~CallHandle();
+
+		CallHandle(const CallHandle& other);
+		CallHandle(CallHandle&& other) noexcept;
+		CallHandle& operator=(const CallHandle& other);
+		CallHandle& operator=(CallHandle&& other) noexcept;
+
+	public:
+		/** Returns true if the handle refers to a call. */
+		bool						IsValid			()	const	{ return m_State; }
+
+		/** Returns true if the call has finished, does not block. */
+		bool						IsReady			()	const;
+
+		/** Blocks until the call has finished. */
+		void						Wait			()	const;
+
+		/**
+		 * Blocks until the call has finished and returns the return value.
+		 * The storage is empty if the function returns void, a reference or a pointer.
+		 * Rethrows the exception in case the function threw one.
+		 */
+		Storage::TypeStorage&		GetResult		();
+
+		/**
+		 * Sets a callback that will be executed once the call has finished.
+		 * The callback is executed on the worker thread, or immediately on this thread if the call already finished.
+		 * Only one callback can be set per call.
+		 */
+		void						OnComplete		(CallCallback callback, void* userData = nullptr);
+
+		FunctionId					GetFunctionId	()	const;
+
+	private:
+		CallState* m_State{};
+	};
+
+	/**
+	 * Pool with a fixed amount of worker threads that execute Tasks.
+	 * Each worker owns a queue and will steal work from the other queues when its own queue is empty.
+	 * Tasks are intrusive, so submitting work never allocates.
+	 */
+	class ThreadPool final
+	{
+	public:
+		explicit ThreadPool(uint32_t threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool(ThreadPool&&) noexcept = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+		ThreadPool& operator=(ThreadPool&&) noexcept = delete;
+
+	public:
+		/** Schedules a single task. */
+		void						Submit			(Task* task);
+
+		/**
+		 * Schedules a linked list of tasks at once.
+		 * The tasks are spread over the worker queues using a single lock per queue and a single wake up.
+		 * @param first first task of the list, linked through Task::Next.
+		 * @param count amount of tasks in the list.
+		 */
+		void						Submit			(Task* first, size_t count);
+
+		uint32_t					GetThreadCount	()	const	{ return m_ThreadCount; }
+
+	private:
+		struct alignas(64) WorkQueue
+		{
+			std::mutex	Mutex	{ };
+			Task*		Head	{ };
+			Task*		Tail	{ };
+		};
+
+		void						WorkerLoop		(uint32_t index);
+		Task*						PopTask			(uint32_t index);
+		void						PushList		(uint32_t queueIndex, Task* first, Task* last);
+		uint32_t					GetSubmitQueue	();
+		void						WakeWorkers		(size_t count);
+
+	private:
+		std::unique_ptr<WorkQueue[]>	m_Queues		{ };
+		std::vector<std::thread>		m_Threads		{ };
+		uint32_t						m_ThreadCount	{ };
+		std::atomic<size_t>				m_Pending		{ };
+		std::atomic<uint32_t>			m_NextQueue		{ };
+		std::mutex						m_SleepMutex	{ };
+		std::condition_variable			m_SleepCondition{ };
+		bool							m_Stop			{ };
+
+		inline static thread_local ThreadPool*	t_WorkerPool	{ };
+		inline static thread_local uint32_t		t_WorkerIndex	{ };
+	};
+
+	/**
+	 * Collects many asynchronous calls and submits them to the thread pool at once.
+	 * Calls that are not yet submitted will be submitted when the batch is destroyed.
+	 */
+	class CallBatch final
+	{
+	public:
+		explicit CallBatch(ThreadPool& pool);
+		CallBatch();
+		~CallBatch();
+
+		CallBatch(const CallBatch&) = delete;
+		CallBatch(CallBatch&&) noexcept = delete;
+		CallBatch& operator=(const CallBatch&) = delete;
+		CallBatch& operator=(CallBatch&&) noexcept = delete;
+
+	public:
+		CallHandle					Add				(FunctionId function, Storage::TypeTuple&& parameters, CallCallback callback = nullptr, void* userData = nullptr);
+		CallHandle					AddMember		(FunctionId function, void* subject, Storage::TypeTuple&& parameters, CallCallback callback = nullptr, void* userData = nullptr);
+
+		/** Submits all the added calls to the thread pool. */
+		void						Submit			();
+
+		size_t						Size			()	const	{ return m_Count; }
+
+	private:
+		ThreadPool*	m_Pool	{ };
+		Task*		m_First	{ };
+		Task*		m_Last	{ };
+		size_t		m_Count	{ };
+	};
+
+	/**
+	 * Get the default thread pool used for asynchronous calls.
+	 * The pool is created the first time this function is called.
+	 * @see GLAS_ASYNC_THREAD_COUNT
+	 */
+	ThreadPool& GetThreadPool();
+
+	/**
+	 * Schedules a call to the function on the given thread pool.
+	 * @param subject instance of the owning class, or nullptr if the function is not a method.
+	 */
+	CallHandle CallAsync(ThreadPool& pool, FunctionId function, void* subject, Storage::TypeTuple&& parameters, CallCallback callback = nullptr, void* userData = nullptr);
+}
+
+#endif
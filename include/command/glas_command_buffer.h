@@ -0,0 +1,296 @@
+#pragma once
+
+#ifdef GLAS_COMMAND_BUFFER
+
+#include <new>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "../glas_decl.h"
+#include "glas_command_buffer_config.h"
+
+namespace glas
+{
+	inline CommandBuffer::CommandBuffer(size_t blockSize)
+		: m_BlockSize{ blockSize }
+	{}
+
+	inline CommandBuffer::~CommandBuffer()
+	{
+		Reset();
+		for (const Block& block : m_Blocks)
+		{
+			::operator delete(block.Data, std::align_val_t{ BlockAlignment });
+		}
+	}
+
+	/**
+	 * RECORDING
+	 */
+
+	template <typename ... Arguments>
+	void CommandBuffer::Add(FunctionId function, Arguments&&... arguments)
+	{
+		AddMember(function, nullptr, std::forward<Arguments>(arguments)...);
+	}
+
+	template <typename ... Arguments>
+	void CommandBuffer::AddMember(FunctionId function, void* subject, Arguments&&... arguments)
+	{
+		const CommandLayout& layout = GetLayout(function);
+		assert(layout.Parameters.size() == sizeof...(Arguments));
+		assert(layout.Info->IsMethod() == (subject != nullptr));
+
+		CommandHeader* command = Allocate(layout, subject);
+
+		size_t index{};
+		try
+		{
+			([&]
+				{
+					using StoredType = std::remove_cvref_t<Arguments>;
+					assert(VariableId::Create<StoredType>().GetTypeId().GetId() == layout.Parameters[index].GetTypeId().GetId());
+					assert(VariableId::Create<StoredType>().GetPointerAmount() == layout.Parameters[index].GetPointerAmount());
+
+					new (GetArgument(command, index)) StoredType(std::forward<Arguments>(arguments));
+					++index;
+				}(), ...);
+		}
+		catch (...)
+		{
+			Rollback(command, index);
+			throw;
+		}
+
+		Commit(command);
+	}
+
+	inline void CommandBuffer::AddTuple(FunctionId function, void* subject, const Storage::TypeTuple& arguments)
+	{
+		const CommandLayout& layout = GetLayout(function);
+		assert(layout.Parameters.size() == arguments.GetVariableIds().size());
+		assert(layout.Info->IsMethod() == (subject != nullptr));
+
+		CommandHeader* command = Allocate(layout, subject);
+
+		size_t index{};
+		try
+		{
+			for (; index < layout.Parameters.size(); ++index)
+			{
+				const VariableId parameter = layout.Parameters[index];
+				const void* source = arguments.GetVoid(index);
+
+				// a reference parameter can be stored as a pointer inside of the tuple
+				if (!parameter.IsPointer() && arguments.GetVariable(index).IsPointer())
+					source = *static_cast<const void* const*>(source);
+
+				if (parameter.IsPointer())
+				{
+					std::memcpy(GetArgument(command, index), source, sizeof(void*));
+				}
+				else
+				{
+					const auto copyConstructor = parameter.GetTypeId().GetInfo().CopyConstructor;
+					assert(copyConstructor);
+					copyConstructor(GetArgument(command, index), source);
+				}
+			}
+		}
+		catch (...)
+		{
+			Rollback(command, index);
+			throw;
+		}
+
+		Commit(command);
+	}
+
+	inline const CommandBuffer::CommandLayout& CommandBuffer::GetLayout(FunctionId function)
+	{
+		if (m_LastLayout && m_LastFunction.GetId() == function.GetId())
+			return *m_LastLayout;
+
+		auto it = m_Layouts.find(function.GetId());
+		if (it == m_Layouts.end())
+		{
+			const FunctionInfo* info = function.GetInfo();
+			assert(info && info->ArgumentCaller);
+
+			CommandLayout layout{};
+			layout.Function = function;
+			layout.Info = info;
+			layout.Parameters = info->ParameterTypes;
+			layout.Offsets.reserve(info->ParameterTypes.size());
+			layout.Destructors.reserve(info->ParameterTypes.size());
+
+			size_t size{ sizeof(CommandHeader) };
+			size_t align{ alignof(CommandHeader) };
+
+			for (const VariableId parameter : info->ParameterTypes)
+			{
+				const TypeInfo& parameterInfo = parameter.GetTypeId().GetInfo();
+				const size_t parameterSize	= parameter.IsPointer() ? sizeof(void*) : parameterInfo.Size;
+				const size_t parameterAlign	= parameter.IsPointer() ? alignof(void*) : std::max<size_t>(parameterInfo.Align, 1);
+
+				size = (size + parameterAlign - 1) / parameterAlign * parameterAlign;
+				align = std::max(align, parameterAlign);
+
+				layout.Offsets.emplace_back(static_cast<uint32_t>(size));
+				layout.Destructors.emplace_back(parameter.IsPointer() ? nullptr : parameterInfo.Destructor);
+				size += parameterSize;
+			}
+
+			assert(align <= BlockAlignment);
+
+			// the size is rounded up so that the next command starts aligned when it has the same layout
+			layout.Size = static_cast<uint32_t>((size + align - 1) / align * align);
+			layout.Align = static_cast<uint32_t>(align);
+
+			if (m_Arguments.size() < layout.Parameters.size())
+				m_Arguments.resize(layout.Parameters.size());
+
+			it = m_Layouts.emplace(function.GetId(), std::move(layout)).first;
+		}
+
+		m_LastFunction = function;
+		m_LastLayout = &it->second;
+		return it->second;
+	}
+
+	inline CommandBuffer::CommandHeader* CommandBuffer::Allocate(const CommandLayout& layout, void* subject)
+	{
+		for (;; ++m_CurrentBlock)
+		{
+			if (m_CurrentBlock == m_Blocks.size())
+			{
+				Block block{};
+				block.Size = std::max<size_t>(m_BlockSize, layout.Size);
+				block.Data = static_cast<std::byte*>(::operator new(block.Size, std::align_val_t{ BlockAlignment }));
+				m_Blocks.emplace_back(block);
+			}
+
+			Block& block = m_Blocks[m_CurrentBlock];
+			const size_t offset = (block.Used + layout.Align - 1) / layout.Align * layout.Align;
+			if (offset + layout.Size <= block.Size)
+			{
+				m_PreviousUsed = block.Used;
+				block.Used = offset + layout.Size;
+				return new (block.Data + offset) CommandHeader{ &layout, subject, nullptr };
+			}
+		}
+	}
+
+	inline void CommandBuffer::Commit(CommandHeader* command)
+	{
+		if (m_Last)
+			m_Last->Next = command;
+		else
+			m_First = command;
+
+		m_Last = command;
+		++m_Count;
+	}
+
+	inline void CommandBuffer::Rollback(CommandHeader* command, size_t constructedArguments)
+	{
+		DestroyArguments(command, constructedArguments);
+		m_Blocks[m_CurrentBlock].Used = m_PreviousUsed;
+	}
+
+	/**
+	 * EXECUTION
+	 */
+
+	inline void CommandBuffer::Execute(bool sortByFunction)
+	{
+		if (!sortByFunction)
+		{
+			for (const CommandHeader* command = m_First; command; command = command->Next)
+			{
+				ExecuteCommand(command);
+			}
+			return;
+		}
+
+		m_SortEntries.clear();
+		m_SortEntries.reserve(m_Count);
+
+		size_t sequence{};
+		for (CommandHeader* command = m_First; command; command = command->Next)
+		{
+			m_SortEntries.emplace_back(command->Layout->Function.GetId(), sequence++, command);
+		}
+
+		// the sequence keeps the recorded order of each function, so a regular sort is enough
+		std::sort(m_SortEntries.begin(), m_SortEntries.end(), [](const SortEntry& lhs, const SortEntry& rhs)
+			{
+				return lhs.Function != rhs.Function ? lhs.Function < rhs.Function : lhs.Sequence < rhs.Sequence;
+			});
+
+		for (const SortEntry& entry : m_SortEntries)
+		{
+			ExecuteCommand(entry.Command);
+		}
+	}
+
+	inline void CommandBuffer::ExecuteCommand(const CommandHeader* command)
+	{
+		const CommandLayout& layout = *command->Layout;
+		for (size_t i{}; i < layout.Parameters.size(); ++i)
+		{
+			m_Arguments[i] = GetArgument(command, i);
+		}
+
+#ifdef GLAS_PROFILER
+		Profiler::CallTimer timer{ layout.Info };
+#endif
+
+		layout.Info->ArgumentCaller(layout.Info->FunctionAddress, command->Subject, m_Arguments.data(), nullptr);
+	}
+
+	/**
+	 * RESETTING
+	 */
+
+	inline void CommandBuffer::Reset()
+	{
+		for (const CommandHeader* command = m_First; command; command = command->Next)
+		{
+			DestroyArguments(command, command->Layout->Parameters.size());
+		}
+
+		for (Block& block : m_Blocks)
+		{
+			block.Used = 0;
+		}
+
+		m_CurrentBlock = 0;
+		m_First = nullptr;
+		m_Last = nullptr;
+		m_Count = 0;
+	}
+
+	inline void CommandBuffer::DestroyArguments(const CommandHeader* command, size_t argumentCount)
+	{
+		const CommandLayout& layout = *command->Layout;
+		for (size_t i{}; i < argumentCount; ++i)
+		{
+			if (layout.Destructors[i])
+				layout.Destructors[i](GetArgument(command, i));
+		}
+	}
+
+	inline void* CommandBuffer::GetArgument(const CommandHeader* command, size_t index)
+	{
+		const auto data = reinterpret_cast<std::byte*>(const_cast<CommandHeader*>(command));
+		return data + command->Layout->Offsets[index];
+	}
+}
+
+#endif
@@ -0,0 +1,148 @@
+#pragma once
+
+#ifdef GLAS_COMMAND_BUFFER
+
+#ifndef GLAS_STORAGE
+#error "GLAS_COMMAND_BUFFER requires the GLAS_STORAGE addon to be enabled"
+#endif
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+#include "../storage/glas_storage_config.h"
+
+/**
+ * Settings
+ */
+
+/**
+ * Size in bytes of the memory blocks that commands are recorded into.
+ * Commands that are larger than a block get a block of their own.
+ */
+#ifndef GLAS_COMMAND_BUFFER_BLOCK_SIZE
+#define GLAS_COMMAND_BUFFER_BLOCK_SIZE 16384
+#endif
+
+namespace glas
+{
+	/**
+	 * Records reflected calls so that they can be executed later, for example once per frame on a single thread.
+	 * Every command stores the function, the subject and its arguments packed inside of a byte arena,
+	 * using the sizes and alignments of the parameter types that are stored in the reflection system.
+	 * The arena only grows, Reset destroys the arguments and keeps the memory, so recording in the steady state does not allocate.
+	 * Return values are discarded and a buffer is not thread safe.
+	 * @see FunctionInfo::ArgumentCaller
+	 */
+	class CommandBuffer final
+	{
+	public:
+		explicit CommandBuffer(size_t blockSize = GLAS_COMMAND_BUFFER_BLOCK_SIZE);
+		~CommandBuffer();
+
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer(CommandBuffer&&) noexcept = delete;
+		CommandBuffer& operator=(const CommandBuffer&) = delete;
+		CommandBuffer& operator=(CommandBuffer&&) noexcept = delete;
+
+	public:
+		/**
+		 * Records a call to a function.
+		 * The arguments are copied or moved into the buffer, their types must match the parameter types without references.
+		 */
+		template <typename... Arguments>
+		void				Add				(FunctionId function, Arguments&&... arguments);
+
+		/**
+		 * Records a call to a method, the subject must stay alive until the command has been executed.
+		 * The arguments are copied or moved into the buffer, their types must match the parameter types without references.
+		 */
+		template <typename... Arguments>
+		void				AddMember		(FunctionId function, void* subject, Arguments&&... arguments);
+
+		/**
+		 * Records a call using copies of the values inside of the type tuple.
+		 * @param subject instance of the owning class, or nullptr if the function is not a method.
+		 */
+		void				AddTuple		(FunctionId function, void* subject, const Storage::TypeTuple& arguments);
+
+		/**
+		 * Executes all recorded commands.
+		 * The commands stay recorded until Reset is called.
+		 * @param sortByFunction executes the commands grouped by function, commands of the same function keep their recorded order.
+		 */
+		void				Execute			(bool sortByFunction = false);
+
+		/** Destroys the arguments of all the commands, the memory is kept for the next commands. */
+		void				Reset			();
+
+		size_t				Size			()	const	{ return m_Count; }
+		bool				Empty			()	const	{ return m_Count == 0; }
+
+	private:
+		/** Layout of the arguments of a function inside of a command, calculated once per function. */
+		struct CommandLayout
+		{
+			FunctionId									Function		{ };
+			const FunctionInfo*							Info			{ };
+			std::vector<VariableId>						Parameters		{ };
+			std::vector<uint32_t>						Offsets			{ }; /**< Offset of each argument from the start of the command*/
+			std::vector<void(*)(void*)>					Destructors		{ }; /**< Destructor of each argument, nullptr for pointers*/
+			uint32_t									Size			{ };
+			uint32_t									Align			{ };
+		};
+
+		struct CommandHeader
+		{
+			const CommandLayout*	Layout	{ };
+			void*					Subject	{ };
+			CommandHeader*			Next	{ };
+		};
+
+		struct Block
+		{
+			std::byte*	Data	{ };
+			size_t		Size	{ };
+			size_t		Used	{ };
+		};
+
+		struct SortEntry
+		{
+			uint64_t		Function	{ };
+			size_t			Sequence	{ };
+			CommandHeader*	Command		{ };
+		};
+
+		static constexpr size_t BlockAlignment = 64;
+
+		const CommandLayout&	GetLayout		(FunctionId function);
+		CommandHeader*			Allocate		(const CommandLayout& layout, void* subject);
+		void					Commit			(CommandHeader* command);
+		void					Rollback		(CommandHeader* command, size_t constructedArguments);
+		void					ExecuteCommand	(const CommandHeader* command);
+		void					DestroyArguments(const CommandHeader* command, size_t argumentCount);
+
+		static void*			GetArgument		(const CommandHeader* command, size_t index);
+
+	private:
+		std::unordered_map<uint64_t, CommandLayout>		m_Layouts		{ };
+		FunctionId										m_LastFunction	{ };
+		const CommandLayout*							m_LastLayout	{ };
+
+		std::vector<Block>								m_Blocks		{ };
+		size_t											m_CurrentBlock	{ };
+		size_t											m_BlockSize		{ };
+		size_t											m_PreviousUsed	{ }; /**< Used bytes of the current block before the last allocation*/
+
+		CommandHeader*									m_First			{ };
+		CommandHeader*									m_Last			{ };
+		size_t											m_Count			{ };
+
+		std::vector<void*>								m_Arguments		{ };
+		std::vector<SortEntry>							m_SortEntries	{ };
+	};
+}
+
+#endif
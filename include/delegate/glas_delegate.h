@@ -0,0 +1,206 @@
+#pragma once
+
+#ifdef GLAS_DELEGATE
+
+#include <new>
+#include <tuple>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "../glas_decl.h"
+#include "glas_delegate_config.h"
+
+namespace glas
+{
+	static_assert(sizeof(void*) != 8 || GLAS_DELEGATE_BUFFER_SIZE != 24 || sizeof(Delegate) == 64);
+
+	inline Delegate::~Delegate()
+	{
+		if (m_BoundArguments)
+			m_BoundArguments->Destructor(m_Buffer);
+	}
+
+	inline Delegate::Delegate(const Delegate& other)
+		: m_Caller{ other.m_Caller }
+		, m_Address{ other.m_Address }
+		, m_Subject{ other.m_Subject }
+		, m_Function{ other.m_Function }
+		, m_BoundArguments{ other.m_BoundArguments }
+	{
+		if (m_BoundArguments)
+			m_BoundArguments->CopyConstructor(m_Buffer, other.m_Buffer);
+	}
+
+	inline Delegate::Delegate(Delegate&& other) noexcept
+		: m_Caller{ other.m_Caller }
+		, m_Address{ other.m_Address }
+		, m_Subject{ other.m_Subject }
+		, m_Function{ other.m_Function }
+		, m_BoundArguments{ other.m_BoundArguments }
+	{
+		if (m_BoundArguments)
+			m_BoundArguments->MoveConstructor(m_Buffer, other.m_Buffer);
+	}
+
+	inline Delegate& Delegate::operator=(const Delegate& other)
+	{
+		// copying the bound arguments can throw, so this delegate is only changed once the copy succeeded
+		Delegate copy{ other };
+		*this = std::move(copy);
+		return *this;
+	}
+
+	inline Delegate& Delegate::operator=(Delegate&& other) noexcept
+	{
+		if (this == &other)
+			return *this;
+
+		if (m_BoundArguments)
+			m_BoundArguments->Destructor(m_Buffer);
+
+		m_Caller			= other.m_Caller;
+		m_Address			= other.m_Address;
+		m_Subject			= other.m_Subject;
+		m_Function			= other.m_Function;
+		m_BoundArguments	= other.m_BoundArguments;
+
+		if (m_BoundArguments)
+			m_BoundArguments->MoveConstructor(m_Buffer, other.m_Buffer);
+		return *this;
+	}
+
+	template <typename ... BoundArguments>
+	Delegate Delegate::Create(FunctionId function, BoundArguments&&... boundArguments)
+	{
+		return CreateMember(function, nullptr, std::forward<BoundArguments>(boundArguments)...);
+	}
+
+	template <typename ... BoundArguments>
+	Delegate Delegate::CreateMember(FunctionId method, void* subject, BoundArguments&&... boundArguments)
+	{
+		using BoundTuple = std::tuple<std::remove_cvref_t<BoundArguments>...>;
+		static_assert(sizeof...(BoundArguments) <= MaxBoundArguments, "Too many bound arguments");
+		static_assert(sizeof(BoundTuple) <= GLAS_DELEGATE_BUFFER_SIZE, "Bound arguments do not fit inside of the delegate, bind them by pointer or increase GLAS_DELEGATE_BUFFER_SIZE");
+		static_assert(alignof(BoundTuple) <= alignof(void*), "Bound arguments are over aligned");
+		static_assert(std::is_nothrow_move_constructible_v<BoundTuple>, "Bound arguments must be nothrow move constructible");
+
+		const FunctionInfo* info = method.GetInfo();
+		assert(info && info->ArgumentCaller);
+		assert(info->IsMethod() == (subject != nullptr));
+		assert(info->ParameterTypes.size() >= sizeof...(BoundArguments));
+
+#ifndef NDEBUG
+		size_t index{};
+		((assert(VariableId::Create<std::remove_cvref_t<BoundArguments>>().GetTypeId().GetId() == info->ParameterTypes[index].GetTypeId().GetId()),
+			assert(!info->ParameterTypes[index].IsRValReference()),
+			++index), ...);
+#endif
+
+		Delegate delegate{};
+		delegate.m_Caller	= info->ArgumentCaller;
+		delegate.m_Address	= info->FunctionAddress;
+		delegate.m_Subject	= subject;
+		delegate.m_Function	= method;
+
+		if constexpr (sizeof...(BoundArguments) != 0)
+		{
+			new (delegate.m_Buffer) BoundTuple(std::forward<BoundArguments>(boundArguments)...);
+			delegate.m_BoundArguments = GetBoundArgumentsInfo<std::remove_cvref_t<BoundArguments>...>();
+		}
+
+		return delegate;
+	}
+
+	template <typename ReturnType, typename ... Arguments>
+	ReturnType Delegate::Invoke(Arguments&&... arguments) const
+	{
+		assert(m_Caller);
+		assert(m_Function.GetInfo()->ParameterTypes.size() == GetBoundArgumentCount() + sizeof...(Arguments));
+		assert(std::is_void_v<ReturnType> || VariableId::Create<ReturnType>().GetTypeId().GetId() == m_Function.GetInfo()->ReturnType.GetTypeId().GetId());
+
+#ifndef NDEBUG
+		// the arguments are passed by address, so their types have to match the parameters that follow the bound arguments
+		const std::vector<VariableId>& parameters = m_Function.GetInfo()->ParameterTypes;
+		size_t parameterIndex{ GetBoundArgumentCount() };
+		((assert(VariableId::Create<std::remove_cvref_t<Arguments>>().GetTypeId().GetId() == parameters[parameterIndex].GetTypeId().GetId()),
+			assert(VariableId::Create<std::remove_cvref_t<Arguments>>().GetPointerAmount() == parameters[parameterIndex].GetPointerAmount()),
+			// a non const reference parameter can write to the argument, so it can not be bound to a const or temporary argument
+			assert(!parameters[parameterIndex].IsReference() || parameters[parameterIndex].IsConst()
+				|| (std::is_lvalue_reference_v<Arguments> && !std::is_const_v<std::remove_reference_t<Arguments>>)),
+			++parameterIndex), ...);
+#endif
+
+		// the bound arguments are followed by the given arguments
+		void* argumentArray[MaxBoundArguments + sizeof...(Arguments) + 1]{};
+		size_t index{};
+		if (m_BoundArguments)
+		{
+			m_BoundArguments->GetArguments(m_Buffer, argumentArray);
+			index = m_BoundArguments->Count;
+		}
+		((argumentArray[index++] = const_cast<void*>(static_cast<const void*>(std::addressof(arguments)))), ...);
+
+		if constexpr (std::is_void_v<ReturnType>)
+		{
+			m_Caller(m_Address, m_Subject, argumentArray, nullptr);
+		}
+		else if constexpr (std::is_reference_v<ReturnType>)
+		{
+			std::remove_reference_t<ReturnType>* result{};
+			m_Caller(m_Address, m_Subject, argumentArray, &result);
+			return static_cast<ReturnType>(*result);
+		}
+		else
+		{
+			alignas(ReturnType) std::byte buffer[sizeof(ReturnType)];
+			m_Caller(m_Address, m_Subject, argumentArray, buffer);
+
+			ReturnType* result = std::launder(reinterpret_cast<ReturnType*>(buffer));
+			ReturnType value{ std::move(*result) };
+			result->~ReturnType();
+			return value;
+		}
+	}
+
+	inline size_t Delegate::GetBoundArgumentCount() const
+	{
+		return m_BoundArguments ? m_BoundArguments->Count : 0;
+	}
+
+	template <typename ... BoundArguments>
+	const Delegate::BoundArgumentsInfo* Delegate::GetBoundArgumentsInfo()
+	{
+		using BoundTuple = std::tuple<BoundArguments...>;
+
+		static constexpr BoundArgumentsInfo info
+		{
+			sizeof...(BoundArguments),
+			[](void* destination, const void* source)
+			{
+				new (destination) BoundTuple(*static_cast<const BoundTuple*>(source));
+			},
+			[](void* destination, void* source)
+			{
+				new (destination) BoundTuple(std::move(*static_cast<BoundTuple*>(source)));
+			},
+			[](void* data)
+			{
+				static_cast<BoundTuple*>(data)->~BoundTuple();
+			},
+			[](void* data, void** arguments)
+			{
+				std::apply([arguments](auto&... values)
+					{
+						size_t index{};
+						((arguments[index++] = static_cast<void*>(std::addressof(values))), ...);
+					}, *static_cast<BoundTuple*>(data));
+			}
+		};
+
+		return &info;
+	}
+}
+
+#endif
@@ -0,0 +1,102 @@
+#pragma once
+
+#ifdef GLAS_DELEGATE
+
+#include <cstddef>
+#include <cstdint>
+
+#include "../glas_decl.h"
+
+/**
+ * Settings
+ */
+
+/**
+ * Size in bytes of the inline buffer that stores the pre-bound arguments of a delegate.
+ * The default keeps a delegate at 64 bytes on 64 bit platforms.
+ */
+#ifndef GLAS_DELEGATE_BUFFER_SIZE
+#define GLAS_DELEGATE_BUFFER_SIZE 24
+#endif
+
+namespace glas
+{
+	/**
+	 * Reflected function or method that is bound to a subject and optional leading arguments.
+	 * The call thunk and function address are resolved when the delegate is created,
+	 * so invoking a delegate is a single indirect call without registry lookups or allocations.
+	 * Bound arguments are copied into an inline buffer and are passed to the function as lvalues.
+	 * @see FunctionInfo::ArgumentCaller
+	 */
+	class Delegate final
+	{
+	public:
+		static constexpr size_t MaxBoundArguments = 4;
+
+		constexpr Delegate() = default;
+		~Delegate();
+
+		Delegate(const Delegate& other);
+		Delegate(Delegate&& other) noexcept;
+		Delegate& operator=(const Delegate& other);
+		Delegate& operator=(Delegate&& other) noexcept;
+
+	public:
+		/**
+		 * Creates a delegate of a function.
+		 * @param boundArguments values of the leading parameters, their types must match the parameter types without references.
+		 */
+		template <typename... BoundArguments>
+		static Delegate		Create			(FunctionId function, BoundArguments&&... boundArguments);
+
+		/**
+		 * Creates a delegate of a method, the subject must stay alive while the delegate is used.
+		 * @param boundArguments values of the leading parameters, their types must match the parameter types without references.
+		 */
+		template <typename... BoundArguments>
+		static Delegate		CreateMember	(FunctionId method, void* subject, BoundArguments&&... boundArguments);
+
+		/**
+		 * Calls the function with the bound arguments followed by the given arguments.
+		 * The argument types must match the remaining parameter types without references.
+		 * @tparam ReturnType return type of the function, or void to discard the return value.
+		 */
+		template <typename ReturnType = void, typename... Arguments>
+		ReturnType			Invoke			(Arguments&&... arguments)	const;
+
+		template <typename... Arguments>
+		void				operator()		(Arguments&&... arguments)	const	{ Invoke<void>(std::forward<Arguments>(arguments)...); }
+
+		FunctionId			GetFunction				()	const	{ return m_Function; }
+		void*				GetSubject				()	const	{ return m_Subject; }
+		size_t				GetBoundArgumentCount	()	const;
+
+		explicit			operator bool	()	const	{ return m_Caller; }
+
+		/** Delegates are equal when they call the same function on the same subject, bound arguments are not compared. */
+		bool				operator==		(const Delegate& other)	const	{ return m_Function.GetId() == other.m_Function.GetId() && m_Subject == other.m_Subject; }
+
+	private:
+		/** Type erased operations on the tuple of bound arguments that is stored inside of the buffer. */
+		struct BoundArgumentsInfo
+		{
+			size_t	Count											{ };
+			void	(*CopyConstructor)(void*, const void*)			{ };
+			void	(*MoveConstructor)(void*, void*)				{ };
+			void	(*Destructor)(void*)							{ };
+			void	(*GetArguments)(void*, void**)					{ }; /**< Writes the address of every bound argument into the array*/
+		};
+
+		template <typename... BoundArguments>
+		static const BoundArgumentsInfo* GetBoundArgumentsInfo();
+
+		void(*							m_Caller)(const void*, void*, void* const*, void*)	{ };
+		const void*						m_Address			{ };
+		void*							m_Subject			{ };
+		FunctionId						m_Function			{ };
+		const BoundArgumentsInfo*		m_BoundArguments	{ };
+		alignas(void*) mutable std::byte	m_Buffer[GLAS_DELEGATE_BUFFER_SIZE]	{ };
+	};
+}
+
+#endif
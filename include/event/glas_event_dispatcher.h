@@ -0,0 +1,255 @@
+#pragma once
+
+#ifdef GLAS_EVENT_DISPATCHER
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "../glas_decl.h"
+#include "glas_event_dispatcher_config.h"
+
+namespace glas
+{
+	template <typename Event>
+	EventReference EventReference::Create(const Event& event)
+	{
+		// the TypeInfo is looked up once per event type
+		static const TypeInfo& info = TypeId::Create<Event>().GetInfo();
+		return { &info, &event };
+	}
+
+	/**
+	 * SUBSCRIBING
+	 */
+
+	template <typename Event, typename Function>
+	EventHandlerId EventDispatcher::Subscribe(Function&& function) requires std::invocable<Function&, const Event&>
+	{
+		using StoredFunction = std::remove_cvref_t<Function>;
+
+		Handler handler{};
+		handler.Invoke = [](void* context, const void* event)
+			{
+				(*static_cast<StoredFunction*>(context))(*static_cast<const Event*>(event));
+			};
+		handler.Owned = { new StoredFunction(std::forward<Function>(function)), [](void* data) { delete static_cast<StoredFunction*>(data); } };
+		handler.Context = handler.Owned.get();
+
+		return AddHandler(TypeId::Create<Event>().GetInfo(), std::move(handler));
+	}
+
+	inline EventHandlerId EventDispatcher::Subscribe(TypeId type, void(*handler)(void*, const void*), void* context)
+	{
+		assert(handler);
+
+		Handler entry{};
+		entry.Invoke = handler;
+		entry.Context = context;
+
+		return AddHandler(type.GetInfo(), std::move(entry));
+	}
+
+	inline bool EventDispatcher::Unsubscribe(EventHandlerId handler)
+	{
+		assert(m_PublishDepth == 0 && "Handlers can not unsubscribe while an event is being published");
+
+		for (std::vector<Handler>& handlers : m_Handlers)
+		{
+			const auto it = std::ranges::find(handlers, handler, &Handler::Id);
+			if (it != handlers.end())
+			{
+				handlers.erase(it);
+				InvalidateRoutes();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	inline EventHandlerId EventDispatcher::AddHandler(const TypeInfo& info, Handler handler)
+	{
+		assert(m_PublishDepth == 0 && "Handlers can not subscribe while an event is being published");
+
+		// every type gets its hierarchy index when it is registered, so subscribing does not change the global TypeInfo
+		assert(info.HierarchyIndex != InvalidHierarchyIndex);
+
+		if (m_Handlers.size() <= info.HierarchyIndex)
+			m_Handlers.resize(info.HierarchyIndex + 1);
+
+		handler.Id = m_NextId++;
+		const EventHandlerId id = handler.Id;
+		m_Handlers[info.HierarchyIndex].emplace_back(std::move(handler));
+
+		InvalidateRoutes();
+		return id;
+	}
+
+	/**
+	 * PUBLISHING
+	 */
+
+	template <typename Event>
+	void EventDispatcher::Publish(const Event& event) requires (!SpanType<Event>)
+	{
+		const EventReference reference = EventReference::Create(event);
+		Publish(*reference.Info, reference.Data);
+	}
+
+	template <typename Event, size_t Extent>
+	void EventDispatcher::Publish(std::span<Event, Extent> events)
+	{
+		if constexpr (std::is_same_v<std::remove_const_t<Event>, EventReference>)
+		{
+			PublishReferences(events);
+		}
+		else
+		{
+			if (events.empty())
+				return;
+
+			const std::span<const RouteEntry> route = GetRoute(*EventReference::Create(events.front()).Info);
+			if (route.empty())
+				return;
+
+			const PublishScope scope{ m_PublishDepth };
+			for (const Event& event : events)
+			{
+				Dispatch(route, &event);
+			}
+		}
+	}
+
+	inline void EventDispatcher::Publish(const TypeInfo& type, const void* event)
+	{
+		const std::span<const RouteEntry> route = GetRoute(type);
+		if (route.empty())
+			return;
+
+		const PublishScope scope{ m_PublishDepth };
+		Dispatch(route, event);
+	}
+
+	inline void EventDispatcher::Publish(TypeId type, const void* event)
+	{
+		Publish(type.GetInfo(), event);
+	}
+
+	inline void EventDispatcher::PublishReferences(std::span<const EventReference> events)
+	{
+		// a nested publish from inside of a handler gets its own sort buffer
+		std::vector<SortEntry> sortEntries{ std::move(m_SortEntries) };
+		sortEntries.clear();
+
+		for (uint32_t i{}; i < events.size(); ++i)
+		{
+			// types without a hierarchy index have no handlers
+			if (events[i].Info->HierarchyIndex != InvalidHierarchyIndex)
+				sortEntries.emplace_back(events[i].Info->HierarchyIndex, i);
+		}
+
+		// the sequence keeps the order of the events of each type, so a regular sort is enough
+		std::sort(sortEntries.begin(), sortEntries.end(), [](const SortEntry& lhs, const SortEntry& rhs)
+			{
+				return lhs.HierarchyIndex != rhs.HierarchyIndex ? lhs.HierarchyIndex < rhs.HierarchyIndex : lhs.Sequence < rhs.Sequence;
+			});
+
+		const PublishScope scope{ m_PublishDepth };
+		std::span<const RouteEntry> route{};
+		uint32_t routeIndex{ InvalidHierarchyIndex };
+		for (const SortEntry& entry : sortEntries)
+		{
+			const EventReference& event = events[entry.Sequence];
+			if (entry.HierarchyIndex != routeIndex)
+			{
+				route = GetRoute(*event.Info);
+				routeIndex = entry.HierarchyIndex;
+			}
+
+			Dispatch(route, event.Data);
+		}
+
+		m_SortEntries = std::move(sortEntries);
+	}
+
+	inline size_t EventDispatcher::GetHandlerCount(TypeId type)
+	{
+		return GetRoute(type.GetInfo()).size();
+	}
+
+	inline void EventDispatcher::Dispatch(std::span<const RouteEntry> route, const void* event)
+	{
+		for (const RouteEntry& entry : route)
+		{
+			entry.Invoke(entry.Context, static_cast<const uint8_t*>(event) + entry.Offset);
+		}
+	}
+
+	/**
+	 * ROUTES
+	 */
+
+	inline std::span<const EventDispatcher::RouteEntry> EventDispatcher::GetRoute(const TypeInfo& info)
+	{
+		if (info.HierarchyIndex == InvalidHierarchyIndex)
+			return {};
+
+		// nested publishes can grow m_Routes, so callers keep a view of the entries instead of the Route
+		// the entries survive the move and routes are not rebuilt while an event is being published
+		if (m_Routes.size() <= info.HierarchyIndex)
+			m_Routes.resize(std::max<size_t>(info.HierarchyIndex + 1, GetGlobalData().HierarchyIndexCount));
+
+		Route& route = m_Routes[info.HierarchyIndex];
+		if (!route.IsBuilt)
+			BuildRoute(info, route);
+
+		return route.Entries;
+	}
+
+	inline void EventDispatcher::BuildRoute(const TypeInfo& info, Route& route) const
+	{
+		route.Entries.clear();
+
+		std::vector<uint32_t> visited{};
+		AddRouteEntries(info, 0, route, visited);
+
+		route.IsBuilt = true;
+	}
+
+	inline void EventDispatcher::AddRouteEntries(const TypeInfo& info, size_t offset, Route& route, std::vector<uint32_t>& visited) const
+	{
+		// a base class that is inherited through multiple paths only receives the event once
+		if (std::ranges::find(visited, info.HierarchyIndex) != visited.end())
+			return;
+		visited.emplace_back(info.HierarchyIndex);
+
+		if (info.HierarchyIndex < m_Handlers.size())
+		{
+			for (const Handler& handler : m_Handlers[info.HierarchyIndex])
+			{
+				route.Entries.emplace_back(handler.Invoke, handler.Context, offset);
+			}
+		}
+
+		for (const BaseClassInfo& baseClass : info.BaseClasses)
+		{
+			AddRouteEntries(baseClass.BaseId.GetInfo(), offset + baseClass.ClassOffset, route, visited);
+		}
+	}
+
+	inline void EventDispatcher::InvalidateRoutes()
+	{
+		// the entries keep their memory, so rebuilding a route usually does not allocate
+		for (Route& route : m_Routes)
+		{
+			route.IsBuilt = false;
+		}
+	}
+}
+
+#endif
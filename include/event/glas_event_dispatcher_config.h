@@ -0,0 +1,159 @@
+#pragma once
+
+#ifdef GLAS_EVENT_DISPATCHER
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <type_traits>
+
+#include "../glas_decl.h"
+
+namespace glas
+{
+	/** Identifier of a subscribed handler, used to unsubscribe it. */
+	using EventHandlerId = uint64_t;
+
+	constexpr EventHandlerId InvalidEventHandlerId = 0;
+
+	template <typename T>
+	struct IsSpan : std::false_type {};
+
+	template <typename T, size_t Extent>
+	struct IsSpan<std::span<T, Extent>> : std::true_type {};
+
+	template <typename T>
+	concept SpanType = IsSpan<T>::value;
+
+	/**
+	 * Type erased reference to an event, used to publish events of different types in a single batch.
+	 * The TypeInfo is stored so that publishing does not have to look it up.
+	 */
+	struct EventReference
+	{
+		const TypeInfo*		Info	{ };
+		const void*			Data	{ };
+
+		template <typename Event>
+		static EventReference Create(const Event& event);
+	};
+
+	/**
+	 * Routes events to handlers by the reflected type of the event.
+	 * Handlers that are subscribed to a base class (see GLAS_CHILD) also receive the events of its derived classes,
+	 * with the event pointer adjusted to the base class.
+	 * The handlers are stored in flat arrays indexed by TypeInfo::HierarchyIndex. The route of an event type
+	 * holds the handlers of the type and of all its ancestors together with their base offsets, and is built the first time the type is published.
+	 * Publishing an event does not allocate or hash, handlers must not subscribe or unsubscribe while an event is being published.
+	 * A dispatcher is not thread safe.
+	 */
+	class EventDispatcher final
+	{
+	public:
+		EventDispatcher() = default;
+		~EventDispatcher() = default;
+
+		EventDispatcher(const EventDispatcher&) = delete;
+		EventDispatcher(EventDispatcher&&) noexcept = default;
+		EventDispatcher& operator=(const EventDispatcher&) = delete;
+		EventDispatcher& operator=(EventDispatcher&&) noexcept = default;
+
+	public:
+		/**
+		 * Subscribes a function object to the events of the type and of its derived types.
+		 * The function object is stored inside of the dispatcher until it is unsubscribed.
+		 */
+		template <typename Event, typename Function>
+		EventHandlerId		Subscribe		(Function&& function) requires std::invocable<Function&, const Event&>;
+
+		/**
+		 * Subscribes a type erased handler to the events of the type and of its derived types.
+		 * @param handler is called with the context and a pointer to the event, adjusted to the subscribed type.
+		 */
+		EventHandlerId		Subscribe		(TypeId type, void(*handler)(void*, const void*), void* context);
+
+		/** @returns false if no handler has the id. */
+		bool				Unsubscribe		(EventHandlerId handler);
+
+		/** Publishes the event to the handlers of its static type and of the ancestors of that type. */
+		template <typename Event>
+		void				Publish			(const Event& event) requires (!SpanType<Event>);
+
+		/**
+		 * Publishes all events in order, the route of the type is only resolved once.
+		 * A span of EventReferences publishes events of different types, grouped by type.
+		 * Events of the same type keep their order, but events of different types can be delivered in a different order.
+		 */
+		template <typename Event, size_t Extent>
+		void				Publish			(std::span<Event, Extent> events);
+
+		void				Publish			(const TypeInfo& type, const void* event);
+		void				Publish			(TypeId type, const void* event);
+
+		/** @returns the amount of handlers that receive events of the type, including the handlers of its ancestors. */
+		size_t				GetHandlerCount	(TypeId type);
+
+	private:
+		struct Handler
+		{
+			EventHandlerId								Id			{ };
+			void(*										Invoke)(void*, const void*)	{ };
+			void*										Context		{ };
+			std::unique_ptr<void, void(*)(void*)>		Owned		{ nullptr, nullptr }; /**< Function object that is owned by the dispatcher*/
+		};
+
+		struct RouteEntry
+		{
+			void(*		Invoke)(void*, const void*)	{ };
+			void*		Context		{ };
+			size_t		Offset		{ }; /**< Offset of the subscribed type inside of the event type*/
+		};
+
+		struct Route
+		{
+			std::vector<RouteEntry>		Entries		{ };
+			bool						IsBuilt		{ };
+		};
+
+		/** Counts a publish that is in progress until the scope ends, also when a handler throws. */
+		class PublishScope final
+		{
+		public:
+			explicit PublishScope(uint32_t& depth) : m_Depth{ depth } { ++m_Depth; }
+			~PublishScope() { --m_Depth; }
+
+			PublishScope(const PublishScope&) = delete;
+			PublishScope& operator=(const PublishScope&) = delete;
+
+		private:
+			uint32_t& m_Depth;
+		};
+
+		struct SortEntry
+		{
+			uint32_t		HierarchyIndex	{ };
+			uint32_t		Sequence		{ };
+		};
+
+		void				PublishReferences(std::span<const EventReference> events);
+		EventHandlerId		AddHandler		(const TypeInfo& info, Handler handler);
+		std::span<const RouteEntry>	GetRoute(const TypeInfo& info);
+		void				BuildRoute		(const TypeInfo& info, Route& route)	const;
+		void				AddRouteEntries	(const TypeInfo& info, size_t offset, Route& route, std::vector<uint32_t>& visited)	const;
+		void				InvalidateRoutes();
+
+		static void			Dispatch		(std::span<const RouteEntry> route, const void* event);
+
+	private:
+		std::vector<std::vector<Handler>>	m_Handlers		{ }; /**< Handlers of each type, indexed by hierarchy index*/
+		std::vector<Route>					m_Routes		{ }; /**< Routes of each type, indexed by hierarchy index*/
+		std::vector<SortEntry>				m_SortEntries	{ };
+		EventHandlerId						m_NextId		{ 1 };
+		uint32_t							m_PublishDepth	{ };
+	};
+}
+
+#endif
@@ -8,6 +8,13 @@
 //#define GLAS_SERIALIZATION_BINARY
 //#define GLAS_SERIALIZATION_JSON
 //#define GLAS_SERIALIZATION_YAML
+//#define GLAS_ASYNC
+//#define GLAS_RPC
+//#define GLAS_PROFILER
+//#define GLAS_MEMOIZATION
+//#define GLAS_COMMAND_BUFFER
+//#define GLAS_DELEGATE
+//#define GLAS_EVENT_DISPATCHER
 
 #include <span>
 #include <array>
@@ -15,6 +22,7 @@
 #include <tuple>
 #include <string>
 #include <vector>
+#include <limits>
 #include <cstdint>
 #include <iostream>
 #include <functional>
@@ -79,6 +87,7 @@ namespace glas
 		None = 0,
 		Method = 1 << 0,
 		ConstMethod = 1 << 1,
+		Pure = 1 << 2, /**< The function has no side effects and always returns the same value for the same arguments*/
 
 		/** Custom properties example*/
 		ServerCallable = 1 << 16,
@@ -228,6 +237,25 @@ namespace glas
 	namespace Storage
 	{
 		class TypeTuple;
+		class TypeStorage;
+	}
+
+	namespace Async
+	{
+		class CallHandle;
+
+		/**
+		 * Callback that is executed once an asynchronous call has finished.
+		 * @param 0 handle to the finished call, the result can be retrieved without blocking.
+		 * @param 1 user data that was given when setting the callback.
+		 * @see CallHandle::OnComplete
+		 */
+		using CallCallback = void(*)(CallHandle&, void*);
+	}
+
+	namespace Memoization
+	{
+		class FunctionCache;
 	}
 
 	/**
@@ -445,7 +473,7 @@ namespace glas
 		 * Function pointer containing a call to a lambda that will execute the registered function with the parameters inside a TypeTuple.
 		 * @param 0 address of the function
 		 * @param 1 TypeTuple containing the data of the parameters to call the function
-		 * @param 2 optional address of a uninitialized variable that will be set when the function returns a value.
+		 * @param 2 optional address of uninitialized memory that the return value will be constructed in.
 		 * @see Call
 		 * @see TypeTuple
 		 */
@@ -456,12 +484,31 @@ namespace glas
 		 * @param 0 address of the function
 		 * @param 1 address instance of the owning type
 		 * @param 2 TypeTuple containing the data of the parameters to call the function
-		 * @param 3 optional address of a uninitialized variable that will be set when the function returns a value.
+		 * @param 3 optional address of uninitialized memory that the return value will be constructed in.
 		 * @see MethodCall
 		 * @see TypeTuple
 		 */
 		void(*MethodCaller)(const void*, void*, Storage::TypeTuple&, void*);
 
+		/**
+		 * Function pointer that executes the registered function or method with the arguments given as an array of pointers.
+		 * Does not need a TypeTuple, so calls can be executed from any memory layout.
+		 * @param 0 address of the function
+		 * @param 1 address instance of the owning type, ignored for functions
+		 * @param 2 array with a pointer to the value of each argument. Pointer parameters point to the pointer value.
+		 * @param 3 optional address of uninitialized memory that the return value will be constructed in.
+		 */
+		void(*ArgumentCaller)(const void*, void*, void* const*, void*) { };
+
+#ifdef GLAS_MEMOIZATION
+		/**
+		 * Cache of the results of the function, is set the first time that the cache is requested.
+		 * Calls of Pure functions use it without looking up the cache inside of the global map.
+		 * @see Memoization::GetFunctionCache
+		 */
+		mutable Memoization::FunctionCache* MemoizationCache { };
+#endif
+
 	public:
 
 		/**
@@ -504,21 +551,44 @@ namespace glas
 
 		/**
 		 * Call the function with the given parameters that are stored inside of the type tuple.
+		 * The return value is constructed in place, so the caller is responsible for destroying it.
+		 * When the function returns a reference, the address of the referenced object is stored as a pointer.
 		 * @param parameters TypeTuple containing the data of the parameters.
-		 * @param pReturnValue optional address of an uninitialized variable to be initialized when the function returns a value.
+		 * @param pReturnValue optional address of uninitialized memory that the return value will be constructed in.
 		 * @see TypeTuple
 		 */
 		inline void Call(Storage::TypeTuple& parameters, void* pReturnValue = nullptr) const;
 
 		/**
 		 * Call the member methods with the given parameters that are stored inside of the type tuple.
+		 * The return value is constructed in place, so the caller is responsible for destroying it.
+		 * When the method returns a reference, the address of the referenced object is stored as a pointer.
 		 * @param subject pointer to the instance of the owning class
 		 * @param parameters TypeTuple containing the data of the parameters.
-		 * @param pReturnValue optional address of an uninitialized variable to be initialized when the function returns a value.
+		 * @param pReturnValue optional address of uninitialized memory that the return value will be constructed in.
 		 * @see TypeTuple
 		 */
 		inline void MemberCall(void* subject, Storage::TypeTuple& parameters, void* pReturnValue = nullptr) const;
 
+#ifdef GLAS_STORAGE
+		/**
+		 * Call the function and construct its return value directly inside of a TypeStorage.
+		 * @returns the return value, or an empty storage when the function returns void, a reference or a pointer.
+		 * @see Call
+		 */
+		inline Storage::TypeStorage Invoke(Storage::TypeTuple& parameters) const;
+
+		/**
+		 * Call the method and construct its return value directly inside of a TypeStorage.
+		 * @returns the return value, or an empty storage when the method returns void, a reference or a pointer.
+		 * @see MemberCall
+		 */
+		inline Storage::TypeStorage MemberInvoke(void* subject, Storage::TypeTuple& parameters) const;
+
+		/** Returns true if the return value of the function can be owned by a TypeStorage. */
+		constexpr bool HasStorableReturnType() const;
+#endif
+
 		/**
 		 * Check whether a property is set in this function/method
 		 * @see FunctionProperties
@@ -639,8 +709,9 @@ namespace glas
 		/**
 		 * Call the function associated with this function ID with the given parameters.
 		 * @param parameters the values of the parameters that will used to call the function
-		 * @param pReturnValue the address of an uninitialized variable that will be filled in case the function has a return value.
+		 * @param pReturnValue the address of uninitialized memory that the return value will be constructed in.
 		 * @see TypeTuple
+		 * @see FunctionInfo::Call
 		 */
 		inline void Call(Storage::TypeTuple& parameters, void* pReturnValue = nullptr) const;
 
@@ -648,11 +719,51 @@ namespace glas
 		 * Call the function associated with this function ID with the given parameters.
 		 * @param subject instance of the class that the method belongs to.
 		 * @param parameters the values of the parameters that will used to call the function
-		 * @param pReturnValue the address of an uninitialized variable that will be filled in case the function has a return value.
+		 * @param pReturnValue the address of uninitialized memory that the return value will be constructed in.
 		 * @see TypeTuple
+		 * @see FunctionInfo::MemberCall
 		 */
 		inline void MemberCall(void* subject, Storage::TypeTuple& parameters, void* pReturnValue = nullptr) const;
 
+#ifdef GLAS_STORAGE
+		/**
+		 * Call the function associated with this function ID and return the return value inside of a TypeStorage.
+		 * @see FunctionInfo::Invoke
+		 */
+		inline Storage::TypeStorage Invoke(Storage::TypeTuple& parameters) const;
+
+		/**
+		 * Call the method associated with this function ID and return the return value inside of a TypeStorage.
+		 * @see FunctionInfo::MemberInvoke
+		 */
+		inline Storage::TypeStorage MemberInvoke(void* subject, Storage::TypeTuple& parameters) const;
+#endif
+
+#ifdef GLAS_ASYNC
+		/**
+		 * Call the function associated with this function ID on the default thread pool.
+		 * @param parameters the values of the parameters, ownership is transferred to the call.
+		 * @param callback optional callback that is executed once the call has finished.
+		 * @param userData user data that is passed to the callback.
+		 * @returns handle that owns the return value once the call has finished.
+		 * @see Async::CallHandle
+		 * @see Async::GetThreadPool
+		 */
+		Async::CallHandle CallAsync(Storage::TypeTuple&& parameters, Async::CallCallback callback = nullptr, void* userData = nullptr) const;
+
+		/**
+		 * Call the method associated with this function ID on the default thread pool.
+		 * The subject must stay alive until the call has finished.
+		 * @param subject instance of the class that the method belongs to.
+		 * @param parameters the values of the parameters, ownership is transferred to the call.
+		 * @param callback optional callback that is executed once the call has finished.
+		 * @param userData user data that is passed to the callback.
+		 * @returns handle that owns the return value once the call has finished.
+		 * @see Async::CallHandle
+		 */
+		Async::CallHandle MemberCallAsync(void* subject, Storage::TypeTuple&& parameters, Async::CallCallback callback = nullptr, void* userData = nullptr) const;
+#endif
+
 	private:
 		uint64_t m_FunctionHash{};
 	};
@@ -684,6 +795,50 @@ namespace glas
 		static constexpr BaseClassInfo Create();
 	};
 
+	/**
+	 * METHOD DISPATCH TABLE
+	 */
+
+	/**
+	 * Index of a method inside of the method table of a type.
+	 * @see TypeInfo::MethodTable
+	 * @see TypeInfo::GetMethodSlot
+	 */
+	using MethodSlot = uint32_t;
+
+	constexpr MethodSlot InvalidMethodSlot = std::numeric_limits<MethodSlot>::max();
+
+	/**
+	 * Index of a type inside of the registered inheritance hierarchy.
+	 * @see TypeInfo::HierarchyIndex
+	 * @see IsA
+	 */
+	constexpr uint32_t InvalidHierarchyIndex = std::numeric_limits<uint32_t>::max();
+
+	/**
+	 * Offset used for types that are not a base class of another type.
+	 * @see TypeInfo::AncestorOffsets
+	 */
+	constexpr uint32_t InvalidClassOffset = std::numeric_limits<uint32_t>::max();
+
+	/**
+	 * Entry inside of the method table of a type, contains everything needed to call the method without any lookups.
+	 */
+	struct MethodTableEntry
+	{
+		const FunctionInfo*		Info			{ }; /**< Information of the method*/
+		const void*				FunctionAddress	{ }; /**< Address of the method*/
+
+		/**
+		 * Invoke thunk of the method.
+		 * @see FunctionInfo::MethodCaller
+		 */
+		void(*MethodCaller)(const void*, void*, Storage::TypeTuple&, void*) { };
+
+		/** Offset of the class that owns the method inside of the type of the table, used for methods of base classes.*/
+		uint32_t				SubjectOffset	{ };
+	};
+
 	/**
 	* TypeInfo holds information about each type
 	*/
@@ -707,6 +862,7 @@ namespace glas
 
 		/**
 		 * v-table pointer of the type in case the type is polymorphic
+		 * @see VTableTag
 		 * @warning experimental
 		 */
 		const void*					VTable{ };
@@ -743,6 +899,62 @@ namespace glas
 		 */
 		std::vector<TypeId>			ChildClasses{ };
 
+		/**
+		 * Dense index of this type inside of the inheritance hierarchy.
+		 * Is assigned when the type is registered.
+		 * @see IsA
+		 */
+		uint32_t					HierarchyIndex{ InvalidHierarchyIndex };
+
+		/**
+		 * Bitset of the hierarchy indices of this type and all of its direct and indirect base classes.
+		 * Is updated whenever a base class is registered anywhere above this type.
+		 * @see IsA
+		 */
+		std::vector<uint64_t>		Ancestors{ };
+
+		/**
+		 * Offset of every direct and indirect base class inside of this type, indexed by the hierarchy index of the base class.
+		 * Contains InvalidClassOffset for types that are not a base class of this type.
+		 * @see Cast
+		 */
+		std::vector<uint32_t>		AncestorOffsets{ };
+
+		/**
+		 * Dispatch table containing the methods of this type and the methods of its base classes.
+		 * Every method gets a slot when it is registered, slots never change after they are assigned.
+		 * Methods of base classes are added to the table of the child when either is registered.
+		 * @see MethodSlot
+		 * @see CallMethod
+		 */
+		std::vector<MethodTableEntry>	MethodTable{ };
+
+		/**
+		 * Get the slot of the method inside of the method table of this type.
+		 * Methods of base classes can be found using the FunctionId of the base class method.
+		 * @returns slot of the method or InvalidMethodSlot if the method is not found.
+		 */
+		MethodSlot					GetMethodSlot	(FunctionId method)		const;
+
+		/**
+		 * Get the slot of the first method with the given name inside of the method table of this type.
+		 * @returns slot of the method or InvalidMethodSlot if the method is not found.
+		 */
+		MethodSlot					GetMethodSlot	(std::string_view name)	const;
+
+#ifdef GLAS_STORAGE
+		/**
+		 * Calls the method inside of the given slot of the method table.
+		 * The subject is adjusted to the class that owns the method, so base class methods can be called on an instance of this type.
+		 * @param slot slot of the method gathered with GetMethodSlot.
+		 * @param subject instance of this type.
+		 * @param parameters TypeTuple containing the data of the parameters.
+		 * @param pReturnValue optional address of uninitialized memory that the return value will be constructed in.
+		 * @see FunctionInfo::MemberCall
+		 */
+		void						CallMethod		(MethodSlot slot, void* subject, Storage::TypeTuple& parameters, void* pReturnValue = nullptr) const;
+#endif
+
 #ifdef GLAS_STORAGE
 		/**
 		 * Function pointer that constructs the type in place at the given address.
@@ -766,18 +978,107 @@ namespace glas
 		 */
 		void (*MoveConstructor)		(void*, void*) { };
 
+		/**
+		 * True if the move constructor of the type does not throw.
+		 * Such types can be stored inside of the inline buffer of a TypeStorage, which is relocated when the storage is moved.
+		 * @see EnableMoveConstructor
+		 */
+		bool NothrowMoveConstructor	{ };
+
+		/**
+		 * True if the type can be copied by copying its bytes.
+		 * @see std::is_trivially_copyable
+		 */
+		bool TriviallyCopyable		{ };
+
+		/**
+		 * True if the type can be moved to another address by copying its bytes, without calling the move constructor and destructor.
+		 * @see IsTriviallyRelocatable
+		 * @see GLAS_STORAGE_TRIVIALLY_RELOCATABLE
+		 */
+		bool TriviallyRelocatable	{ };
+
+		/**
+		 * True if two instances are equal exactly when their bytes are equal, so they can be compared with memcmp and hashed as bytes.
+		 * @see glas::Storage::IsTriviallyComparable
+		 */
+		bool TriviallyComparable	{ };
+
+		/**
+		 * True if Hash and Equals use the reflected base classes and members of the type.
+		 * @see HashMembers
+		 * @see IsComparable
+		 */
+		bool MemberComparison		{ };
+
 		/**
 		 * Function pointer that destructs the type at the given address
 		 * @param 0 address for destruction
 		 */
 		void (*Destructor)			(void*) { };
 
+		/**
+		 * Function pointer that value initializes an array of instances of the type at the given address.
+		 * Scalars are zeroed with memset.
+		 * @param 0 address of the first instance
+		 * @param 1 amount of instances
+		 * @see Constructor
+		 */
+		void (*ConstructN)			(void*, size_t) { };
+
+		/**
+		 * Function pointer that copy constructs an array of instances of the type at the given address.
+		 * Trivially copyable types are copied with memcpy.
+		 * @param 0 address of the first instance that will be constructed
+		 * @param 1 address of the first instance that will be copied, the arrays must not overlap
+		 * @param 2 amount of instances
+		 * @see CopyConstructor
+		 */
+		void (*CopyConstructN)		(void*, const void*, size_t) { };
+
+		/**
+		 * Function pointer that move constructs an array of instances of the type at the given address.
+		 * Trivially copyable types are copied with memcpy.
+		 * @param 0 address of the first instance that will be constructed
+		 * @param 1 address of the first instance that will be moved, the arrays must not overlap
+		 * @param 2 amount of instances
+		 * @see MoveConstructor
+		 */
+		void (*MoveConstructN)		(void*, void*, size_t) { };
+
+		/**
+		 * Function pointer that destructs an array of instances of the type, does nothing for trivially destructible types.
+		 * @param 0 address of the first instance
+		 * @param 1 amount of instances
+		 * @see Destructor
+		 */
+		void (*DestructN)			(void*, size_t) { };
+
 		/**
 		 * Function pointer that swaps two instances of a type
 		 * @param 0 address of type instance 1
 		 * @param 1 address of type instance 2
 		 */
 		void (*Swap)				(void*, void*) { };
+
+		/**
+		 * Function pointer that hashes an instance of a type using std::hash.
+		 * Trivially comparable types without std::hash hash their bytes, other classes hash their reflected members once a member is registered.
+		 * @param 0 address of type instance
+		 * @see EnableHashing
+		 * @see HashMembers
+		 */
+		size_t (*Hash)				(const void*) { };
+
+		/**
+		 * Function pointer that compares two instances of a type using operator==.
+		 * Trivially comparable types without operator== are compared with memcmp, other classes compare their reflected members once a member is registered.
+		 * @param 0 address of type instance 1
+		 * @param 1 address of type instance 2
+		 * @see EnableEquality
+		 * @see EqualsMembers
+		 */
+		bool (*Equals)				(const void*, const void*) { };
 #endif // GLASS_STORAGE
 #ifdef GLAS_SERIALIZATION_JSON
 		using RapidJsonAllocator = RAPIDJSON_DEFAULT_ALLOCATOR;
@@ -883,6 +1184,82 @@ namespace glas
 	 * GLOBAL DATA
 	 */
 
+	/**
+	 * Tag that polymorphic types can accept in a constructor, so that their v-table can be read without running their regular constructors.
+	 * The constructor should pass the tag on to its base classes and do as little work as possible, the instance is never used or destructed.
+	 * Types without such a constructor are default constructed instead, and are skipped if they are not default constructible.
+	 * @see TypeInfo::VTable
+	 * @see RegisterChild
+	 */
+	struct VTableTag final
+	{
+		explicit constexpr VTableTag() = default;
+	};
+
+	/**
+	 * Open addressing hash table between v-table addresses and the TypeId of their polymorphic type.
+	 * Uses linear probing over a flat array, which is faster than a node based map for pointer keys.
+	 * Entries are never removed, the first TypeId that is registered for a v-table is kept.
+	 * @see GetTypeIDFromPolymorphic
+	 */
+	class VTableRegistry final
+	{
+	public:
+		/**
+		 * Adds the v-table to the table if it is not present yet.
+		 * @returns false if the v-table was already present.
+		 */
+		bool		Emplace		(const void* vTable, TypeId type);
+
+		/**
+		 * Get the type of the given v-table.
+		 * @returns the TypeId, or an invalid TypeId if the v-table has not been registered.
+		 */
+		TypeId		Find		(const void* vTable)	const;
+
+		size_t		Size		()	const	{ return m_Size; }
+
+	private:
+		struct Entry
+		{
+			const void*	VTable	{ };
+			TypeId		Type	{ };
+		};
+
+		size_t		GetSlot		(const void* vTable)	const;
+		void		Grow		();
+
+		std::vector<Entry>	m_Entries	{ };
+		size_t				m_Size		{ };
+		uint32_t			m_Shift		{ 64 };
+	};
+
+	/**
+	 * Small cache that remembers the types of the last v-tables that were resolved, to be used at a single call site.
+	 * When the same few dynamic types are looked up repeatedly, a lookup costs a few pointer compares instead of a hash probe.
+	 * A cache is not thread safe, use a thread_local or function local cache per call site.
+	 * @tparam EntryCount amount of v-tables that are cached, 1 creates a monomorphic cache.
+	 * @see GetTypeIDFromPolymorphic
+	 */
+	template <size_t EntryCount = 4>
+	class VTableCache final
+	{
+	public:
+		static_assert(EntryCount > 0);
+
+		/** Get the type of the given v-table, looking it up in the global VTableRegistry on a miss. */
+		TypeId		Get		(const void* vTable);
+
+		/** Get the dynamic type of the polymorphic instance. */
+		template <typename T>
+		TypeId		Get		(const T* instance) requires std::is_polymorphic_v<T>;
+
+	private:
+		std::array<const void*, EntryCount>	m_VTables	{ };
+		std::array<TypeId, EntryCount>		m_Types		{ };
+		size_t								m_Next		{ }; /**< Entry that is replaced on the next miss*/
+	};
+
 	/**
 	 * This struct contains data about the reflection system that can be accessed anywhere in the program using glas::GetGlobalData().
 	 * @see GetGlobalData
@@ -934,9 +1311,16 @@ namespace glas
 
 		/**
 		 * Map between v-table and TypeId in case the type is polymorphic. Type must have been registered.
+		 * @see VTableRegistry
 		 * @warning experimental feature
 		 */
-		std::unordered_map<const void*, TypeId>			VTableMap{ };
+		VTableRegistry									VTableMap{ };
+
+		/**
+		 * Amount of hierarchy indices that have been assigned.
+		 * @see TypeInfo::HierarchyIndex
+		 */
+		uint32_t										HierarchyIndexCount{ };
 	};
 
 	/**
@@ -1112,6 +1496,58 @@ namespace glas
 	template <typename Parent, typename Child>
 	void RegisterChild();
 
+	/**
+	 * Gives the type a hierarchy index if it does not have one yet.
+	 * The hierarchy index is dense, so it can also be used to store data per type inside of flat arrays.
+	 * @see TypeInfo::HierarchyIndex
+	 */
+	void AssignHierarchyIndex(TypeInfo& info);
+
+	/**
+	 * Stores the offset of the type to itself inside of TypeInfo::AncestorOffsets, so that its children can copy it.
+	 * Called when the type is used in RegisterChild.
+	 * @see TypeInfo::AncestorOffsets
+	 */
+	void AddHierarchyOffsets(TypeInfo& info);
+
+	/**
+	 * Checks whether the derived type is the base type or inherits from it, directly or indirectly.
+	 * Uses the ancestor bitsets that are built by RegisterChild, so the check takes constant time.
+	 * @see GLAS_CHILD
+	 */
+	bool IsA(TypeId derived, TypeId base);
+
+	/**
+	 * Checks whether the derived type is the base type or inherits from it, without looking up the TypeInfos.
+	 * @see IsA
+	 */
+	bool IsA(const TypeInfo& derived, const TypeInfo& base);
+
+	/**
+	 * Converts a pointer to an instance of the derived type into a pointer to one of its direct or indirect base classes.
+	 * @returns the adjusted pointer, or nullptr if the base type is not a base class of the derived type.
+	 * @see TypeInfo::AncestorOffsets
+	 */
+	void* UpCast(void* instance, TypeId derived, TypeId base);
+	void* UpCast(void* instance, const TypeInfo& derived, const TypeInfo& base);
+
+	/**
+	 * Converts a pointer to a base class into a pointer to the derived type that contains it.
+	 * Like static_cast the instance must actually be part of an instance of the derived type, use GetTypeIDFromPolymorphic to check this.
+	 * @returns the adjusted pointer, or nullptr if the base type is not a base class of the derived type.
+	 */
+	void* DownCast(void* instance, TypeId base, TypeId derived);
+	void* DownCast(void* instance, const TypeInfo& base, const TypeInfo& derived);
+
+	/**
+	 * Converts a pointer between two types of the same hierarchy, using an UpCast or a DownCast.
+	 * @returns the adjusted pointer, or nullptr if the types are not related.
+	 * @see UpCast
+	 * @see DownCast
+	 */
+	void* Cast(void* instance, TypeId from, TypeId to);
+	void* Cast(void* instance, const TypeInfo& from, const TypeInfo& to);
+
 	template <typename T>
 	const void* GetVTable(const T* instance) requires std::is_polymorphic_v<T>;
 
@@ -1163,6 +1599,8 @@ struct GlasAutoRegisterType
 template <typename T>
 struct GlasAutoRegisterTypeOnce
 {
+	/** Odr-uses the static member so that it is instantiated on every compiler. */
+	constexpr GlasAutoRegisterTypeOnce() { (void)&StaticRegisterType; }
 private:
 	struct GlasAutoRegisterTypeOnce_Internal
 	{
@@ -1325,6 +1763,8 @@ struct GlasAutoRegisterChild
 template <typename Parent, typename Child>
 struct GlasAutoRegisterChildOnce
 {
+	/** Odr-uses the static member so that it is instantiated on every compiler. */
+	constexpr GlasAutoRegisterChildOnce() { (void)&StaticRegisterType; }
 private:
 	struct GlasAutoRegisterChildOnce_Internal
 	{
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <bit>
+#include <new>
 #include <span>
 #include <array>
 #include <tuple>
 #include <string>
 #include <vector>
 #include <ranges>
+#include <cstddef>
 #include <cstdint>
 #include <cassert>
+#include <cstring>
 #include <utility>
 #include <iostream>
 #include <algorithm>
@@ -23,6 +27,8 @@
 #ifdef GLAS_STORAGE
 #include "storage/glas_storage_config.h"
 #include "storage/glas_storage.h"
+#include "storage/glas_archetype_config.h"
+#include "storage/glas_archetype.h"
 #endif
 #ifdef GLAS_SERIALIZATION_BINARY
 #include "serialization/glas_serialization_config_binary.h"
@@ -36,6 +42,34 @@
 #include "serialization/glas_serialization_config_yaml.h"
 #include "serialization/glas_serialization_yaml.h"
 #endif
+#ifdef GLAS_PROFILER
+#include "profiler/glas_profiler_config.h"
+#include "profiler/glas_profiler.h"
+#endif
+#ifdef GLAS_MEMOIZATION
+#include "memoization/glas_memoization_config.h"
+#include "memoization/glas_memoization.h"
+#endif
+#ifdef GLAS_COMMAND_BUFFER
+#include "command/glas_command_buffer_config.h"
+#include "command/glas_command_buffer.h"
+#endif
+#ifdef GLAS_DELEGATE
+#include "delegate/glas_delegate_config.h"
+#include "delegate/glas_delegate.h"
+#endif
+#ifdef GLAS_EVENT_DISPATCHER
+#include "event/glas_event_dispatcher_config.h"
+#include "event/glas_event_dispatcher.h"
+#endif
+#ifdef GLAS_ASYNC
+#include "async/glas_async_config.h"
+#include "async/glas_async.h"
+#endif
+#ifdef GLAS_RPC
+#include "rpc/glas_rpc_config.h"
+#include "rpc/glas_rpc.h"
+#endif
 
 namespace glas
 {
@@ -214,6 +248,34 @@ namespace glas
 		return GetVariableArrayTupleHelper<Tuple>(std::make_index_sequence<size>{});
 	}
 
+	/**
+	 * Creates an instance of the type and passes it to the visitor, so that its v-table pointers can be read.
+	 * Types that are constructible from a VTableTag are constructed into raw storage and are never destructed,
+	 * other types are default constructed.
+	 * @returns false if no instance could be created.
+	 * @see VTableTag
+	 */
+	template <typename T, typename Visitor>
+	bool VisitVTableInstance(Visitor&& visitor)
+	{
+		if constexpr (std::is_constructible_v<T, VTableTag>)
+		{
+			alignas(T) std::byte storage[sizeof(T)];
+			visitor(*new (storage) T(VTableTag{}));
+			return true;
+		}
+		else if constexpr (std::is_default_constructible_v<T>)
+		{
+			T instance{};
+			visitor(instance);
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
 	template <typename T>
 	const TypeInfo& RegisterType()
 	{
@@ -230,6 +292,12 @@ namespace glas
 				TypeInfo::Create<T>()
 			).first->second;
 
+			if (createdTypeInfo.VTable)
+				GetGlobalData().VTableMap.Emplace(createdTypeInfo.VTable, hash);
+
+			// registration happens before the types are used, so the index does not change the TypeInfo while it is being read
+			AssignHierarchyIndex(createdTypeInfo);
+
 			return createdTypeInfo;
 		}
 		return it->second;
@@ -255,6 +323,201 @@ namespace glas
 		return nullptr;
 	}
 
+	inline MethodSlot TypeInfo::GetMethodSlot(FunctionId method) const
+	{
+		const FunctionInfo* info = method.GetInfo();
+		if (!info)
+			return InvalidMethodSlot;
+
+		const auto it = std::ranges::find(MethodTable, info, &MethodTableEntry::Info);
+		return it != MethodTable.end() ? static_cast<MethodSlot>(it - MethodTable.begin()) : InvalidMethodSlot;
+	}
+
+	inline MethodSlot TypeInfo::GetMethodSlot(std::string_view name) const
+	{
+		const auto it = std::ranges::find_if(MethodTable, [name](const MethodTableEntry& entry) { return entry.Info->Name == name; });
+		return it != MethodTable.end() ? static_cast<MethodSlot>(it - MethodTable.begin()) : InvalidMethodSlot;
+	}
+
+	/**
+	 * Adds the entry to the method table of the type and to the method tables of all its child classes.
+	 * @see TypeInfo::MethodTable
+	 */
+	inline void AddMethodTableEntry(TypeInfo& info, MethodTableEntry entry)
+	{
+		info.MethodTable.emplace_back(entry);
+
+		for (const TypeId child : info.ChildClasses)
+		{
+			auto& childInfo = const_cast<TypeInfo&>(child.GetInfo());
+			for (const BaseClassInfo& baseClass : childInfo.BaseClasses)
+			{
+				if (&baseClass.BaseId.GetInfo() == &info)
+				{
+					MethodTableEntry childEntry = entry;
+					childEntry.SubjectOffset += static_cast<uint32_t>(baseClass.ClassOffset);
+					AddMethodTableEntry(childInfo, childEntry);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Gives the type a hierarchy index if it does not have one yet.
+	 * @see TypeInfo::HierarchyIndex
+	 */
+	inline void AssignHierarchyIndex(TypeInfo& info)
+	{
+		if (info.HierarchyIndex != InvalidHierarchyIndex)
+			return;
+
+		info.HierarchyIndex = GetGlobalData().HierarchyIndexCount++;
+
+		const size_t word = info.HierarchyIndex / 64;
+		if (info.Ancestors.size() <= word)
+			info.Ancestors.resize(word + 1);
+		info.Ancestors[word] |= uint64_t{ 1 } << (info.HierarchyIndex % 64);
+	}
+
+	inline void AddHierarchyOffsets(TypeInfo& info)
+	{
+		AssignHierarchyIndex(info);
+
+		// only types with relations store their own offset, which their children copy
+		if (info.AncestorOffsets.size() <= info.HierarchyIndex)
+			info.AncestorOffsets.resize(info.HierarchyIndex + 1, InvalidClassOffset);
+		info.AncestorOffsets[info.HierarchyIndex] = 0;
+	}
+
+	/**
+	 * Adds the parent and its ancestors to the type and to all of its child classes.
+	 * @param parentOffset offset of the parent inside of the type.
+	 * @see TypeInfo::Ancestors
+	 * @see TypeInfo::AncestorOffsets
+	 */
+	inline void AddAncestors(TypeInfo& info, const TypeInfo& parent, size_t parentOffset)
+	{
+		if (info.Ancestors.size() < parent.Ancestors.size())
+			info.Ancestors.resize(parent.Ancestors.size());
+		if (info.AncestorOffsets.size() < parent.AncestorOffsets.size())
+			info.AncestorOffsets.resize(parent.AncestorOffsets.size(), InvalidClassOffset);
+
+		bool changed{};
+		for (size_t i{}; i < parent.AncestorOffsets.size(); ++i)
+		{
+			// when a base class can be reached through multiple paths, the first registered path is used
+			if (parent.AncestorOffsets[i] == InvalidClassOffset || info.AncestorOffsets[i] != InvalidClassOffset)
+				continue;
+
+			info.AncestorOffsets[i] = static_cast<uint32_t>(parentOffset + parent.AncestorOffsets[i]);
+			info.Ancestors[i / 64] |= uint64_t{ 1 } << (i % 64);
+			changed = true;
+		}
+
+		// children already contain every ancestor of this type when nothing changed
+		if (!changed)
+			return;
+
+		for (const TypeId child : info.ChildClasses)
+		{
+			auto& childInfo = const_cast<TypeInfo&>(child.GetInfo());
+			for (const BaseClassInfo& baseClass : childInfo.BaseClasses)
+			{
+				if (&baseClass.BaseId.GetInfo() == &info)
+					AddAncestors(childInfo, info, baseClass.ClassOffset);
+			}
+		}
+	}
+
+	inline bool IsA(const TypeInfo& derived, const TypeInfo& base)
+	{
+		if (&derived == &base)
+			return true;
+
+		if (base.HierarchyIndex == InvalidHierarchyIndex)
+			return false;
+
+		const size_t word = base.HierarchyIndex / 64;
+		return word < derived.Ancestors.size() && ((derived.Ancestors[word] >> (base.HierarchyIndex % 64)) & 1);
+	}
+
+	inline bool IsA(TypeId derived, TypeId base)
+	{
+		if (derived == base)
+			return true;
+
+		auto& typeInfoMap = GetTypeInfoMap();
+		const auto derivedIt = typeInfoMap.find(derived);
+		const auto baseIt = typeInfoMap.find(base);
+
+		return derivedIt != typeInfoMap.end() && baseIt != typeInfoMap.end() && IsA(derivedIt->second, baseIt->second);
+	}
+
+	inline void* UpCast(void* instance, const TypeInfo& derived, const TypeInfo& base)
+	{
+		if (&derived == &base)
+			return instance;
+
+		if (!instance || !IsA(derived, base))
+			return nullptr;
+
+		return VoidOffset(instance, derived.AncestorOffsets[base.HierarchyIndex]);
+	}
+
+	inline void* DownCast(void* instance, const TypeInfo& base, const TypeInfo& derived)
+	{
+		if (&derived == &base)
+			return instance;
+
+		if (!instance || !IsA(derived, base))
+			return nullptr;
+
+		return static_cast<uint8_t*>(instance) - derived.AncestorOffsets[base.HierarchyIndex];
+	}
+
+	inline void* Cast(void* instance, const TypeInfo& from, const TypeInfo& to)
+	{
+		if (IsA(from, to))
+			return UpCast(instance, from, to);
+		return DownCast(instance, from, to);
+	}
+
+	inline void* UpCast(void* instance, TypeId derived, TypeId base)
+	{
+		if (derived == base)
+			return instance;
+
+		auto& typeInfoMap = GetTypeInfoMap();
+		const auto derivedIt = typeInfoMap.find(derived);
+		const auto baseIt = typeInfoMap.find(base);
+
+		return derivedIt != typeInfoMap.end() && baseIt != typeInfoMap.end() ? UpCast(instance, derivedIt->second, baseIt->second) : nullptr;
+	}
+
+	inline void* DownCast(void* instance, TypeId base, TypeId derived)
+	{
+		if (derived == base)
+			return instance;
+
+		auto& typeInfoMap = GetTypeInfoMap();
+		const auto derivedIt = typeInfoMap.find(derived);
+		const auto baseIt = typeInfoMap.find(base);
+
+		return derivedIt != typeInfoMap.end() && baseIt != typeInfoMap.end() ? DownCast(instance, baseIt->second, derivedIt->second) : nullptr;
+	}
+
+	inline void* Cast(void* instance, TypeId from, TypeId to)
+	{
+		if (from == to)
+			return instance;
+
+		auto& typeInfoMap = GetTypeInfoMap();
+		const auto fromIt = typeInfoMap.find(from);
+		const auto toIt = typeInfoMap.find(to);
+
+		return fromIt != typeInfoMap.end() && toIt != typeInfoMap.end() ? Cast(instance, fromIt->second, toIt->second) : nullptr;
+	}
+
 	inline const TypeInfo& GetTypeInfo(TypeId id)
 	{
 		assert(GetTypeInfoMap().contains(id));
@@ -280,7 +543,13 @@ namespace glas
 
 		auto& memberInfo = const_cast<TypeInfo&>(RegisterType<Class>());
 
-		return *memberInfo.Members.emplace(std::upper_bound(memberInfo.Members.begin(), memberInfo.Members.end(), info), std::move(info));
+		const auto it = memberInfo.Members.emplace(std::upper_bound(memberInfo.Members.begin(), memberInfo.Members.end(), info), std::move(info));
+
+#ifdef GLAS_STORAGE
+		Storage::FillMemberComparison<Class>(memberInfo);
+#endif
+
+		return *it;
 	}
 
 	template<typename Class, typename Field>
@@ -325,6 +594,12 @@ namespace glas
 	template <typename Class, typename ReturnType, typename ... ParameterTypes>
 	void MethodCallerHelper(const void* address, void* subject, Storage::TypeTuple& tupleStorage, void* returnAddress);
 
+	template <typename ReturnType, typename ... ParameterTypes>
+	void FunctionArgumentCallerHelper(const void* address, void* subject, void* const* arguments, void* returnAddress);
+
+	template <typename Class, typename ReturnType, typename ... ParameterTypes>
+	void MethodArgumentCallerHelper(const void* address, void* subject, void* const* arguments, void* returnAddress);
+
 	template <typename ReturnType, typename ... ParameterTs>
 	FunctionInfo FillFunctionInfo(const void* address, std::string_view name, FunctionProperties properties)
 	{
@@ -354,6 +629,7 @@ namespace glas
 	{
 		FunctionInfo info = FillFunctionInfo<TReturnType, TParameterTypes...>(std::bit_cast<const void*>(function), name, properties);
 		info.FunctionCaller = &FunctionCallerHelper<TReturnType, TParameterTypes...>;
+		info.ArgumentCaller = &FunctionArgumentCallerHelper<TReturnType, TParameterTypes...>;
 		return info;
 	}
 
@@ -363,6 +639,7 @@ namespace glas
 		FunctionInfo info = FillFunctionInfo<TReturnType, TParameterTypes...>(std::bit_cast<const void*>(function), name, properties);
 		info.OwningType = TypeId::Create<Class>();
 		info.MethodCaller = &MethodCallerHelper<Class, TReturnType, TParameterTypes...>;
+		info.ArgumentCaller = &MethodArgumentCallerHelper<Class, TReturnType, TParameterTypes...>;
 		return info;
 	}
 
@@ -372,6 +649,7 @@ namespace glas
 		FunctionInfo info = FillFunctionInfo<TReturnType, TParameterTypes...>(std::bit_cast<const void*>(function), name, properties);
 		info.OwningType = TypeId::Create<Class>();
 		info.MethodCaller = &MethodCallerHelper<Class, TReturnType, TParameterTypes...>;
+		info.ArgumentCaller = &MethodArgumentCallerHelper<Class, TReturnType, TParameterTypes...>;
 		return info;
 	}
 
@@ -493,19 +771,30 @@ namespace glas
 	inline void FunctionInfo::Call(Storage::TypeTuple& parameters, void* pReturnValue) const
 	{
 		assert(FunctionCaller && IsCompatible(parameters.GetVariableIds()));
+#ifdef GLAS_PROFILER
+		Profiler::CallTimer timer{ this };
+#endif
 		FunctionCaller(FunctionAddress, parameters, pReturnValue);
 	}
 
 	inline void FunctionInfo::MemberCall(void* subject, Storage::TypeTuple& parameters, void* pReturnValue) const
 	{
 		assert(MethodCaller && subject && IsCompatible(parameters.GetVariableIds()));
+#ifdef GLAS_PROFILER
+		Profiler::CallTimer timer{ this };
+#endif
 		MethodCaller(FunctionAddress, subject, parameters, pReturnValue);
 	}
 
 	inline void FunctionId::Call(Storage::TypeTuple& parameters, void* pReturnValue) const
 	{
-		assert(GetInfo());
-		GetInfo()->Call(parameters, pReturnValue);
+		const FunctionInfo* info = GetInfo();
+		assert(info);
+#ifdef GLAS_MEMOIZATION
+		if (info->IsPropertySet(FunctionProperties::Pure) && Memoization::TryCall(*info, parameters, pReturnValue))
+			return;
+#endif
+		info->Call(parameters, pReturnValue);
 	}
 
 	inline void FunctionId::MemberCall(void* subject, Storage::TypeTuple& parameters, void* pReturnValue) const
@@ -514,36 +803,96 @@ namespace glas
 		GetInfo()->MemberCall(subject, parameters, pReturnValue);
 	}
 
+	inline void TypeInfo::CallMethod(MethodSlot slot, void* subject, Storage::TypeTuple& parameters, void* pReturnValue) const
+	{
+		assert(slot < MethodTable.size() && subject);
+
+		const MethodTableEntry& entry = MethodTable[slot];
+		assert(entry.Info->IsCompatible(parameters.GetVariableIds()));
+#ifdef GLAS_PROFILER
+		Profiler::CallTimer timer{ entry.Info };
+#endif
+		entry.MethodCaller(entry.FunctionAddress, static_cast<uint8_t*>(subject) + entry.SubjectOffset, parameters, pReturnValue);
+	}
+
+	constexpr bool FunctionInfo::HasStorableReturnType() const
+	{
+		return !ReturnType.IsRefOrPointer() && ReturnType.GetTypeId() != TypeId::Create<void>();
+	}
+
+	inline Storage::TypeStorage FunctionInfo::Invoke(Storage::TypeTuple& parameters) const
+	{
+		if (!HasStorableReturnType())
+		{
+			Call(parameters);
+			return {};
+		}
+
+		return Storage::TypeStorage::ConstructInPlace(ReturnType.GetTypeId(), [this, &parameters](void* returnAddress)
+			{
+				Call(parameters, returnAddress);
+			});
+	}
+
+	inline Storage::TypeStorage FunctionInfo::MemberInvoke(void* subject, Storage::TypeTuple& parameters) const
+	{
+		if (!HasStorableReturnType())
+		{
+			MemberCall(subject, parameters);
+			return {};
+		}
+
+		return Storage::TypeStorage::ConstructInPlace(ReturnType.GetTypeId(), [this, subject, &parameters](void* returnAddress)
+			{
+				MemberCall(subject, parameters, returnAddress);
+			});
+	}
+
+	inline Storage::TypeStorage FunctionId::Invoke(Storage::TypeTuple& parameters) const
+	{
+		const FunctionInfo* info = GetInfo();
+		assert(info);
+#ifdef GLAS_MEMOIZATION
+		// goes through Call so that the result can come from the cache
+		if (info->IsPropertySet(FunctionProperties::Pure) && info->HasStorableReturnType())
+		{
+			return Storage::TypeStorage::ConstructInPlace(info->ReturnType.GetTypeId(), [this, &parameters](void* returnAddress)
+				{
+					Call(parameters, returnAddress);
+				});
+		}
+#endif
+		return info->Invoke(parameters);
+	}
+
+	inline Storage::TypeStorage FunctionId::MemberInvoke(void* subject, Storage::TypeTuple& parameters) const
+	{
+		assert(GetInfo() && subject);
+		return GetInfo()->MemberInvoke(subject, parameters);
+	}
+
 	template <typename FunctionParameterTuple, size_t Index>
-	auto& ConvertParameter(Storage::TypeTuple& typeTuple)
+	decltype(auto) ConvertParameter(Storage::TypeTuple& typeTuple)
 	{
 		auto Variable = typeTuple.GetVariable(Index);
 		using ParameterType = std::tuple_element_t<Index, FunctionParameterTuple>;
 
-		constexpr bool IsPtr = std::is_pointer_v<ParameterType>;
-
-		if (Variable.IsPointer())
+		if constexpr (std::is_pointer_v<ParameterType>)
 		{
-			if constexpr (IsPtr)
-			{
-				// both are pointers
-				return typeTuple.Get<ParameterType>(Index);
-			}
-			else
+			// pointers are passed by value, if the stored type is not a pointer we pass its address
+			return Variable.IsPointer() ?
+				typeTuple.Get<ParameterType>(Index) :
+				&typeTuple.Get<std::remove_pointer_t<ParameterType>>(Index);
+		}
+		else
+		{
+			if (Variable.IsPointer())
 			{
 				// the stored is pointer, the parameter is not.
 				auto typePointer = typeTuple.Get<std::remove_reference_t<ParameterType>*>(Index);
 				assert(typePointer);
 				return *typePointer;
 			}
-		}
-		else
-		{
-			if constexpr (IsPtr)
-			{
-				// the stored type is not a pointer, but the parameter is.
-				return *typeTuple.Get<std::remove_pointer_t<ParameterType>>(Index);
-			}
 			else
 			{
 				// both are not pointers
@@ -553,13 +902,13 @@ namespace glas
 	}
 
 	template <typename FunctionParameterTuple, typename Function, size_t... Index>
-	auto TupleFunctionCall(Function function, Storage::TypeTuple& typeTuple, std::index_sequence<Index...>)
+	decltype(auto) TupleFunctionCall(Function function, Storage::TypeTuple& typeTuple, std::index_sequence<Index...>)
 	{
 		return function(ConvertParameter<FunctionParameterTuple, Index>(typeTuple)...);
 	}
 
 	template <typename FunctionParameterTuple, typename Class, typename Function, size_t... Index>
-	auto TupleMethodCall(Function function, void* subject, Storage::TypeTuple& typeTuple, std::index_sequence<Index...>)
+	decltype(auto) TupleMethodCall(Function function, void* subject, Storage::TypeTuple& typeTuple, std::index_sequence<Index...>)
 	{
 		return (static_cast<Class*>(subject)->*function)(ConvertParameter<FunctionParameterTuple, Index>(typeTuple)...);
 	}
@@ -578,13 +927,24 @@ namespace glas
 				tupleStorage,
 				std::make_index_sequence<sizeof...(ParameterTypes)>());
 		}
+		else if constexpr (std::is_reference_v<ReturnType>)
+		{
+			auto& result = TupleFunctionCall<std::tuple<ParameterTypes...>>(
+				function,
+				tupleStorage,
+				std::make_index_sequence<sizeof...(ParameterTypes)>());
+
+			if (returnAddress)
+				new (returnAddress) std::remove_reference_t<ReturnType>*(&result);
+		}
 		else
 		{
+			// the result is a prvalue, so it is constructed directly inside of the return address
 			if (returnAddress)
-				*static_cast<ReturnType*>(returnAddress) = TupleFunctionCall<std::tuple<ParameterTypes...>>(
+				new (returnAddress) ReturnType(TupleFunctionCall<std::tuple<ParameterTypes...>>(
 					function,
 					tupleStorage,
-					std::make_index_sequence<sizeof...(ParameterTypes)>());
+					std::make_index_sequence<sizeof...(ParameterTypes)>()));
 			else
 				TupleFunctionCall<std::tuple<ParameterTypes...>>(
 					function,
@@ -596,8 +956,9 @@ namespace glas
 	template <typename Class, typename ReturnType, typename ... ParameterTypes>
 	void MethodCallerHelper(const void* address, void* subject, Storage::TypeTuple& tupleStorage, void* returnAddress)
 	{
-		ReturnType(Class::*function)(ParameterTypes...);
-		function = reinterpret_cast<decltype(function)&>(address);
+		// only the address is stored, the this-adjustment of the method pointer stays zero
+		ReturnType(Class::*function)(ParameterTypes...) {};
+		std::memcpy(&function, &address, sizeof(address));
 		if constexpr (std::is_same_v<ReturnType, void>)
 		{
 			(void)returnAddress;
@@ -608,14 +969,26 @@ namespace glas
 				tupleStorage,
 				std::make_index_sequence<sizeof...(ParameterTypes)>());
 		}
+		else if constexpr (std::is_reference_v<ReturnType>)
+		{
+			auto& result = TupleMethodCall<std::tuple<ParameterTypes...>, Class>(
+				function,
+				subject,
+				tupleStorage,
+				std::make_index_sequence<sizeof...(ParameterTypes)>());
+
+			if (returnAddress)
+				new (returnAddress) std::remove_reference_t<ReturnType>*(&result);
+		}
 		else
 		{
+			// the result is a prvalue, so it is constructed directly inside of the return address
 			if (returnAddress)
-				*static_cast<ReturnType*>(returnAddress) = TupleMethodCall<std::tuple<ParameterTypes...>, Class>(
+				new (returnAddress) ReturnType(TupleMethodCall<std::tuple<ParameterTypes...>, Class>(
 					function,
 					subject,
 					tupleStorage,
-					std::make_index_sequence<sizeof...(ParameterTypes)>());
+					std::make_index_sequence<sizeof...(ParameterTypes)>()));
 			else
 				TupleMethodCall<std::tuple<ParameterTypes...>, Class>(
 					function,
@@ -669,6 +1042,81 @@ namespace glas
 	}
 #endif
 
+	/**
+	 * Converts an element of an argument array to the parameter type.
+	 * The element points to a value of the parameter type without references, so pointers point to the pointer value.
+	 */
+	template <typename ParameterType>
+	decltype(auto) ConvertArgument(void* argument)
+	{
+		if constexpr (std::is_rvalue_reference_v<ParameterType>)
+			return std::move(*static_cast<std::remove_reference_t<ParameterType>*>(argument));
+		else
+			return *static_cast<std::remove_reference_t<ParameterType>*>(argument);
+	}
+
+	/**
+	 * Executes the invoker and constructs its result in place at the return address.
+	 * When the result is a reference, the address of the referenced object is stored as a pointer.
+	 */
+	template <typename ReturnType, typename Invoker>
+	void InvokeToReturnAddress(void* returnAddress, Invoker&& invoker)
+	{
+		if constexpr (std::is_same_v<ReturnType, void>)
+		{
+			(void)returnAddress;
+			invoker();
+		}
+		else if constexpr (std::is_reference_v<ReturnType>)
+		{
+			auto& result = invoker();
+			if (returnAddress)
+				new (returnAddress) std::remove_reference_t<ReturnType>*(&result);
+		}
+		else
+		{
+			if (returnAddress)
+				new (returnAddress) ReturnType(invoker());
+			else
+				invoker();
+		}
+	}
+
+	template <typename ReturnType, typename ... ParameterTypes>
+	void FunctionArgumentCallerHelper(const void* address, void* subject, void* const* arguments, void* returnAddress)
+	{
+		(void)subject;
+		(void)arguments;
+
+		const auto function = std::bit_cast<ReturnType(*)(ParameterTypes...)>(address);
+
+		[&]<size_t... Index>(std::index_sequence<Index...>)
+		{
+			InvokeToReturnAddress<ReturnType>(returnAddress, [&]() -> decltype(auto)
+				{
+					return function(ConvertArgument<ParameterTypes>(arguments[Index])...);
+				});
+		}(std::make_index_sequence<sizeof...(ParameterTypes)>());
+	}
+
+	template <typename Class, typename ReturnType, typename ... ParameterTypes>
+	void MethodArgumentCallerHelper(const void* address, void* subject, void* const* arguments, void* returnAddress)
+	{
+		(void)arguments;
+
+		// only the address is stored, the this-adjustment of the method pointer stays zero
+		ReturnType(Class::*function)(ParameterTypes...) {};
+		std::memcpy(&function, &address, sizeof(address));
+
+		[&]<size_t... Index>(std::index_sequence<Index...>)
+		{
+			InvokeToReturnAddress<ReturnType>(returnAddress, [&]() -> decltype(auto)
+				{
+					return (static_cast<Class*>(subject)->*function)(ConvertArgument<ParameterTypes>(arguments[Index])...);
+				});
+		}(std::make_index_sequence<sizeof...(ParameterTypes)>());
+	}
+
 	/** specialized TypeInfo creator for type void*/
 	template <>
 	inline TypeInfo TypeInfo::Create<void>()
@@ -689,10 +1137,9 @@ namespace glas
 		info.Size = sizeof(T);
 		info.Align = alignof(T);
 
-		if constexpr (std::is_polymorphic_v<T> && std::is_default_constructible_v<T>)
+		if constexpr (std::is_polymorphic_v<T>)
 		{
-			T instance{};
-			info.VTable = GetVTable(&instance);
+			VisitVTableInstance<T>([&info](const T& instance) { info.VTable = GetVTable(&instance); });
 		}
 
 #ifdef GLAS_STORAGE
@@ -749,6 +1196,8 @@ namespace glas
 
 		FunctionInfo info = FillFunctionInfo<ReturnType, ParameterTypes...>(function, name, properties);
 		info.OwningType = TypeId::Create<Class>();
+		info.MethodCaller = &MethodCallerHelper<Class, ReturnType, ParameterTypes...>;
+		info.ArgumentCaller = &MethodArgumentCallerHelper<Class, ReturnType, ParameterTypes...>;
 
 		auto& classInfo = const_cast<TypeInfo&>(RegisterType<Class>());
 		classInfo.MemberFunctions.emplace_back(functionId);
@@ -757,7 +1206,11 @@ namespace glas
 
 		globalFunctionData.NameToFunctionIdMap.emplace(name, functionId);
 		globalFunctionData.FunctionAddressToIdMap.emplace(info.FunctionAddress, functionId);
-		return globalFunctionData.FunctionInfoMap.emplace(functionId, std::move(info)).first->second;
+		const FunctionInfo& registeredInfo = globalFunctionData.FunctionInfoMap.emplace(functionId, std::move(info)).first->second;
+
+		AddMethodTableEntry(classInfo, MethodTableEntry{ &registeredInfo, registeredInfo.FunctionAddress, registeredInfo.MethodCaller, 0 });
+
+		return registeredInfo;
 	}
 
 	template <typename Class, typename ReturnType, typename ... ParameterTypes>
@@ -829,14 +1282,106 @@ namespace glas
 		if (!instance)
 			return {};
 
-		const void* vTable = GetVTable(instance);
+		return GetGlobalData().VTableMap.Find(GetVTable(instance));
+	}
+
+	/**
+	 * VTABLE REGISTRY
+	 */
+
+	inline size_t VTableRegistry::GetSlot(const void* vTable) const
+	{
+		// fibonacci hashing, the low bits of v-table addresses are always zero because of alignment
+		return static_cast<size_t>((std::bit_cast<uintptr_t>(vTable) * 0x9E3779B97F4A7C15ULL) >> m_Shift);
+	}
+
+	inline bool VTableRegistry::Emplace(const void* vTable, TypeId type)
+	{
+		assert(vTable);
+
+		if ((m_Size + 1) * 2 > m_Entries.size())
+			Grow();
+
+		const size_t mask = m_Entries.size() - 1;
+		for (size_t slot = GetSlot(vTable);; slot = (slot + 1) & mask)
+		{
+			Entry& entry = m_Entries[slot];
+			if (entry.VTable == vTable)
+				return false;
+
+			if (!entry.VTable)
+			{
+				entry = { vTable, type };
+				++m_Size;
+				return true;
+			}
+		}
+	}
+
+	inline TypeId VTableRegistry::Find(const void* vTable) const
+	{
+		if (m_Entries.empty())
+			return {};
+
+		const size_t mask = m_Entries.size() - 1;
+		for (size_t slot = GetSlot(vTable);; slot = (slot + 1) & mask)
+		{
+			const Entry& entry = m_Entries[slot];
+			if (entry.VTable == vTable)
+				return entry.Type;
+
+			if (!entry.VTable)
+				return {};
+		}
+	}
+
+	inline void VTableRegistry::Grow()
+	{
+		std::vector<Entry> entries = std::move(m_Entries);
 
-		auto it = GetGlobalData().VTableMap.find(vTable);
-		if (it != GetGlobalData().VTableMap.end())
+		const size_t capacity = entries.empty() ? 64 : entries.size() * 2;
+		m_Entries = std::vector<Entry>(capacity);
+		m_Shift = 64 - static_cast<uint32_t>(std::countr_zero(capacity));
+		m_Size = 0;
+
+		for (const Entry& entry : entries)
 		{
-			return it->second;
+			if (entry.VTable)
+				Emplace(entry.VTable, entry.Type);
 		}
-		return {};
+	}
+
+	/**
+	 * VTABLE CACHE
+	 */
+
+	template <size_t EntryCount>
+	TypeId VTableCache<EntryCount>::Get(const void* vTable)
+	{
+		for (size_t i{}; i < EntryCount; ++i)
+		{
+			if (m_VTables[i] == vTable)
+				return m_Types[i];
+		}
+
+		const TypeId type = GetGlobalData().VTableMap.Find(vTable);
+
+		// unknown v-tables are not cached, their type can still be registered later
+		if (type.IsValid())
+		{
+			m_VTables[m_Next] = vTable;
+			m_Types[m_Next] = type;
+			m_Next = (m_Next + 1) % EntryCount;
+		}
+
+		return type;
+	}
+
+	template <size_t EntryCount>
+	template <typename T>
+	TypeId VTableCache<EntryCount>::Get(const T* instance) requires std::is_polymorphic_v<T>
+	{
+		return instance ? Get(GetVTable(instance)) : TypeId{};
 	}
 
 	template <typename Parent, typename Child>
@@ -856,16 +1401,32 @@ namespace glas
 		assert(parentInfo.ChildClasses.end() == std::ranges::find(parentInfo.ChildClasses, TypeId::Create<Child>()));
 		assert(childInfo.BaseClasses.end() == std::ranges::find_if(childInfo.BaseClasses, [](BaseClassInfo info) { return info.BaseId == TypeId::Create<Parent>(); }));
 
-		if constexpr (std::is_default_constructible_v<Child>)
+		if constexpr (std::is_polymorphic_v<Parent>)
 		{
-			Child child{};
-			Parent* parent = &child;
-
-			// Register VTable
-			GetGlobalData().VTableMap.emplace(GetVTable(parent), TypeId::Create<Child>());
+			// the v-table of the parent inside of the child also identifies the child
+			VisitVTableInstance<Child>([](const Child& child)
+				{
+					GetGlobalData().VTableMap.Emplace(GetVTable(static_cast<const Parent*>(&child)), TypeId::Create<Child>());
+				});
 		}
 
 		parentInfo.ChildClasses.emplace_back(TypeId::Create<Child>());
 		childInfo.BaseClasses.emplace_back(BaseClassInfo::Create<Parent, Child>());
+
+		AddHierarchyOffsets(parentInfo);
+		AddHierarchyOffsets(childInfo);
+		AddAncestors(childInfo, parentInfo, childInfo.BaseClasses.back().ClassOffset);
+
+#ifdef GLAS_STORAGE
+		Storage::FillMemberComparison<Child>(childInfo);
+#endif
+
+		// inherit the methods that were registered before the relation
+		const uint32_t classOffset = static_cast<uint32_t>(childInfo.BaseClasses.back().ClassOffset);
+		for (MethodTableEntry entry : parentInfo.MethodTable)
+		{
+			entry.SubjectOffset += classOffset;
+			AddMethodTableEntry(childInfo, entry);
+		}
 	}
 }
@@ -0,0 +1,259 @@
+#pragma once
+
+#ifdef GLAS_MEMOIZATION
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+#include "glas_memoization_config.h"
+
+namespace glas::Memoization
+{
+	/**
+	 * FUNCTION CACHE
+	 */
+
+	/** Get the address of the argument, arguments can be stored as a pointer when the parameter is a reference. */
+	inline const void* GetArgument(const Storage::TypeTuple& parameters, size_t index)
+	{
+		const void* data = parameters.GetVoid(index);
+		return parameters.GetVariable(index).IsPointer() ? *static_cast<const void* const*>(data) : data;
+	}
+
+	inline FunctionCache::FunctionCache(const FunctionInfo& info)
+		: m_Info{ info }
+	{
+		m_Statistics.Capacity = m_Capacity;
+
+		if (info.IsMethod() || !info.FunctionCaller || !info.HasStorableReturnType() || !info.ReturnType.GetTypeId().GetInfo().CopyConstructor)
+			return;
+
+		for (const VariableId parameter : info.ParameterTypes)
+		{
+			// pointers and non const references can be used as output parameters
+			if (parameter.IsPointer() || parameter.IsRValReference() || (parameter.IsReference() && !parameter.IsConst()))
+				return;
+
+			const TypeInfo& parameterInfo = parameter.GetTypeId().GetInfo();
+			if (!Storage::IsComparable(parameterInfo) || !parameterInfo.CopyConstructor)
+				return;
+		}
+
+		m_Memoizable = true;
+	}
+
+	inline void FunctionCache::Call(Storage::TypeTuple& parameters, void* pReturnValue)
+	{
+		assert(m_Memoizable);
+
+		const uint64_t hash = HashArguments(parameters);
+		const TypeInfo& returnInfo = m_Info.ReturnType.GetTypeId().GetInfo();
+
+		{
+			std::lock_guard lock{ m_Mutex };
+
+			if (const auto it = Find(hash, parameters); it != m_Entries.end())
+			{
+				++m_Statistics.Hits;
+				m_Entries.splice(m_Entries.begin(), m_Entries, it);
+
+				if (pReturnValue)
+					returnInfo.CopyConstructor(pReturnValue, it->Result.GetData());
+				return;
+			}
+
+			++m_Statistics.Misses;
+		}
+
+		// the function is called without holding the lock, so that slow functions do not block other callers
+		Entry entry{};
+		entry.Hash = hash;
+		if (pReturnValue)
+		{
+			m_Info.Call(parameters, pReturnValue);
+			entry.Result = Storage::TypeStorage::CopyConstruct(m_Info.ReturnType.GetTypeId(), pReturnValue);
+		}
+		else
+		{
+			entry.Result = m_Info.Invoke(parameters);
+		}
+
+		entry.Arguments.reserve(parameters.GetVariableIds().size());
+		for (size_t i{}; i < parameters.GetVariableIds().size(); ++i)
+		{
+			entry.Arguments.emplace_back(Storage::TypeStorage::CopyConstruct(parameters.GetVariable(i).GetTypeId(), GetArgument(parameters, i)));
+		}
+
+		std::lock_guard lock{ m_Mutex };
+
+		// another thread could have cached the same call in the meantime
+		if (m_Capacity == 0 || Find(hash, parameters) != m_Entries.end())
+			return;
+
+		while (m_Entries.size() >= m_Capacity)
+		{
+			Evict();
+		}
+
+		m_Entries.emplace_front(std::move(entry));
+		m_Lookup.emplace(hash, m_Entries.begin());
+	}
+
+	inline CacheStatistics FunctionCache::GetStatistics()
+	{
+		std::lock_guard lock{ m_Mutex };
+		m_Statistics.Size = m_Entries.size();
+		m_Statistics.Capacity = m_Capacity;
+		return m_Statistics;
+	}
+
+	inline void FunctionCache::SetCapacity(size_t capacity)
+	{
+		std::lock_guard lock{ m_Mutex };
+		m_Capacity = capacity;
+		while (m_Entries.size() > m_Capacity)
+		{
+			Evict();
+		}
+	}
+
+	inline void FunctionCache::Clear()
+	{
+		std::lock_guard lock{ m_Mutex };
+		m_Entries.clear();
+		m_Lookup.clear();
+		m_Statistics = {};
+	}
+
+	inline uint64_t FunctionCache::HashArguments(const Storage::TypeTuple& parameters) const
+	{
+		uint64_t hash = 0xcbf29ce484222325ULL;
+		for (size_t i{}; i < parameters.GetVariableIds().size(); ++i)
+		{
+			const size_t argumentHash = parameters.GetVariable(i).GetTypeId().GetInfo().Hash(GetArgument(parameters, i));
+			hash = (hash ^ argumentHash) * 0x100000001b3ULL;
+		}
+		return hash;
+	}
+
+	inline bool FunctionCache::IsMatch(const Entry& entry, const Storage::TypeTuple& parameters) const
+	{
+		for (size_t i{}; i < entry.Arguments.size(); ++i)
+		{
+			const auto equals = entry.Arguments[i].GetType().GetInfo().Equals;
+			if (!equals(entry.Arguments[i].GetData(), GetArgument(parameters, i)))
+				return false;
+		}
+		return true;
+	}
+
+	inline FunctionCache::EntryList::iterator FunctionCache::Find(uint64_t hash, const Storage::TypeTuple& parameters)
+	{
+		auto [begin, end] = m_Lookup.equal_range(hash);
+		for (auto it = begin; it != end; ++it)
+		{
+			if (IsMatch(*it->second, parameters))
+				return it->second;
+		}
+		return m_Entries.end();
+	}
+
+	inline void FunctionCache::Evict()
+	{
+		const auto last = std::prev(m_Entries.end());
+
+		auto [begin, end] = m_Lookup.equal_range(last->Hash);
+		for (auto it = begin; it != end; ++it)
+		{
+			if (it->second == last)
+			{
+				m_Lookup.erase(it);
+				break;
+			}
+		}
+
+		m_Entries.erase(last);
+		++m_Statistics.Evictions;
+	}
+
+	/**
+	 * CACHES
+	 */
+
+	struct MemoizationData
+	{
+		std::mutex														Mutex	{ };
+		std::unordered_map<const FunctionInfo*, std::unique_ptr<FunctionCache>>	Caches	{ };
+	};
+
+	inline MemoizationData& GetMemoizationData()
+	{
+		static MemoizationData data{};
+		return data;
+	}
+
+	inline FunctionCache& GetFunctionCache(const FunctionInfo& info)
+	{
+		// the cache is never destroyed, so once it is published every call can use it without locking
+		std::atomic_ref<FunctionCache*> publishedCache{ info.MemoizationCache };
+		if (FunctionCache* cache = publishedCache.load(std::memory_order_acquire))
+			return *cache;
+
+		MemoizationData& data = GetMemoizationData();
+		std::lock_guard lock{ data.Mutex };
+
+		auto& cache = data.Caches[&info];
+		if (!cache)
+			cache = std::make_unique<FunctionCache>(info);
+
+		publishedCache.store(cache.get(), std::memory_order_release);
+		return *cache;
+	}
+
+	inline bool TryCall(const FunctionInfo& info, Storage::TypeTuple& parameters, void* pReturnValue)
+	{
+		FunctionCache& cache = GetFunctionCache(info);
+		if (!cache.IsMemoizable())
+			return false;
+
+		cache.Call(parameters, pReturnValue);
+		return true;
+	}
+
+	inline CacheStatistics GetStatistics(FunctionId function)
+	{
+		assert(function.GetInfo());
+		return GetFunctionCache(*function.GetInfo()).GetStatistics();
+	}
+
+	inline void SetCapacity(FunctionId function, size_t capacity)
+	{
+		assert(function.GetInfo());
+		GetFunctionCache(*function.GetInfo()).SetCapacity(capacity);
+	}
+
+	inline void Clear(FunctionId function)
+	{
+		assert(function.GetInfo());
+		GetFunctionCache(*function.GetInfo()).Clear();
+	}
+
+	inline void ClearAll()
+	{
+		MemoizationData& data = GetMemoizationData();
+		std::lock_guard lock{ data.Mutex };
+		for (auto& [info, cache] : data.Caches)
+		{
+			cache->Clear();
+		}
+	}
+}
+
+#endif
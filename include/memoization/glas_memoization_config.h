@@ -0,0 +1,129 @@
+#pragma once
+
+#ifdef GLAS_MEMOIZATION
+
+#ifndef GLAS_STORAGE
+#error "GLAS_MEMOIZATION requires the GLAS_STORAGE addon to be enabled"
+#endif
+
+#include <list>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+#include "../storage/glas_storage_config.h"
+
+/**
+ * Settings
+ */
+
+/**
+ * Default amount of results that are cached per function.
+ * @see Memoization::SetCapacity
+ */
+#ifndef GLAS_MEMOIZATION_CAPACITY
+#define GLAS_MEMOIZATION_CAPACITY 128
+#endif
+
+namespace glas::Memoization
+{
+	/**
+	 * Hit and miss statistics of the cache of a single function.
+	 * @see GetStatistics
+	 */
+	struct CacheStatistics
+	{
+		uint64_t	Hits		{ };
+		uint64_t	Misses		{ };
+		uint64_t	Evictions	{ };
+		size_t		Size		{ }; /**< Amount of results that are currently cached*/
+		size_t		Capacity	{ };
+	};
+
+	/**
+	 * Least recently used cache of the results of a single Pure function.
+	 * The arguments are hashed and compared using TypeInfo::Hash and TypeInfo::Equals of the parameter types.
+	 */
+	class FunctionCache final
+	{
+	public:
+		explicit FunctionCache(const FunctionInfo& info);
+
+		FunctionCache(const FunctionCache&) = delete;
+		FunctionCache(FunctionCache&&) noexcept = delete;
+		FunctionCache& operator=(const FunctionCache&) = delete;
+		FunctionCache& operator=(FunctionCache&&) noexcept = delete;
+
+	public:
+		/**
+		 * Returns false if the function cannot be memoized because of its parameters or return type.
+		 * A function can be memoized if it is not a method, has a copyable return value and all parameters are values or const references of hashable types.
+		 */
+		bool						IsMemoizable	()	const	{ return m_Memoizable; }
+
+		/**
+		 * Constructs the cached result in the return address, or calls the function and caches its result.
+		 * @param pReturnValue optional address of uninitialized memory that the return value will be constructed in.
+		 */
+		void						Call			(Storage::TypeTuple& parameters, void* pReturnValue);
+
+		CacheStatistics				GetStatistics	();
+		void						SetCapacity		(size_t capacity);
+		void						Clear			();
+
+	private:
+		struct Entry
+		{
+			uint64_t							Hash		{ };
+			std::vector<Storage::TypeStorage>	Arguments	{ };
+			Storage::TypeStorage				Result		{ };
+		};
+
+		using EntryList = std::list<Entry>;
+
+		uint64_t					HashArguments	(const Storage::TypeTuple& parameters)	const;
+		bool						IsMatch			(const Entry& entry, const Storage::TypeTuple& parameters)	const;
+		EntryList::iterator			Find			(uint64_t hash, const Storage::TypeTuple& parameters);
+		void						Evict			();
+
+	private:
+		const FunctionInfo&										m_Info;
+		bool													m_Memoizable	{ };
+		size_t													m_Capacity		{ GLAS_MEMOIZATION_CAPACITY };
+
+		std::mutex												m_Mutex			{ };
+		EntryList												m_Entries		{ }; /**< Most recently used entries are at the front*/
+		std::unordered_multimap<uint64_t, EntryList::iterator>	m_Lookup		{ };
+		CacheStatistics											m_Statistics	{ };
+	};
+
+	/**
+	 * Get the cache of the given function, the cache is created when it does not exist yet.
+	 * The cache is stored inside of FunctionInfo::MemoizationCache, so only the first request takes the global lock.
+	 */
+	FunctionCache& GetFunctionCache(const FunctionInfo& info);
+
+	/**
+	 * Calls the function through its cache.
+	 * @returns false if the function cannot be memoized, in that case the function is not called.
+	 * @see FunctionId::Call
+	 */
+	bool TryCall(const FunctionInfo& info, Storage::TypeTuple& parameters, void* pReturnValue);
+
+	/** Get the hit and miss statistics of the cache of the given function. */
+	CacheStatistics GetStatistics(FunctionId function);
+
+	/** Sets the maximum amount of results that are cached for the given function. */
+	void SetCapacity(FunctionId function, size_t capacity);
+
+	/** Removes all the cached results of the given function and resets its statistics. */
+	void Clear(FunctionId function);
+
+	/** Removes all the cached results of all functions. */
+	void ClearAll();
+}
+
+#endif
@@ -0,0 +1,241 @@
+#pragma once
+
+#ifdef GLAS_PROFILER
+
+#include <bit>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+#include "glas_profiler_config.h"
+
+namespace glas::Profiler
+{
+	struct ProfilerData
+	{
+		std::mutex									Mutex		{ };
+		std::vector<std::unique_ptr<ThreadProfile>>	Threads		{ };
+		std::atomic<uint64_t>						Generation	{ }; /**< Incremented by every reset*/
+	};
+
+	inline ProfilerData& GetProfilerData()
+	{
+		static ProfilerData data{};
+		return data;
+	}
+
+	/**
+	 * FUNCTION COUNTERS
+	 */
+
+	inline void FunctionCounters::Record(uint64_t nanoseconds)
+	{
+		// a reset from another thread is applied by this thread, so it can not be lost between a load and a store
+		const uint64_t generation = GetProfilerData().Generation.load(std::memory_order_relaxed);
+		if (generation != Generation.load(std::memory_order_relaxed))
+		{
+			Reset();
+			Generation.store(generation, std::memory_order_release);
+		}
+
+		// only the owning thread writes, so a load and store is enough
+		CallCount.store(CallCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		TotalNanoseconds.store(TotalNanoseconds.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+
+		if (nanoseconds > MaxNanoseconds.load(std::memory_order_relaxed))
+			MaxNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+
+		const size_t bucket = std::min(static_cast<size_t>(std::bit_width(nanoseconds)), HistogramBucketCount - 1);
+		Histogram[bucket].store(Histogram[bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	inline void FunctionCounters::Reset()
+	{
+		CallCount.store(0, std::memory_order_relaxed);
+		TotalNanoseconds.store(0, std::memory_order_relaxed);
+		MaxNanoseconds.store(0, std::memory_order_relaxed);
+		for (auto& bucket : Histogram)
+		{
+			bucket.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * THREAD PROFILE
+	 */
+
+	inline FunctionCounters& ThreadProfile::GetCounters(const FunctionInfo* function)
+	{
+		if (function == m_LastFunction)
+			return *m_LastCounters;
+
+		// lookups do not need the lock because this thread is the only one modifying the map
+		auto it = m_Counters.find(function);
+		if (it == m_Counters.end())
+		{
+			std::lock_guard lock{ m_Mutex };
+			it = m_Counters.emplace(function, std::make_unique<FunctionCounters>()).first;
+		}
+
+		m_LastFunction = function;
+		m_LastCounters = it->second.get();
+		return *m_LastCounters;
+	}
+
+	inline ThreadProfile& GetThreadProfile()
+	{
+		thread_local ThreadProfile* threadProfile = []
+		{
+			ProfilerData& data = GetProfilerData();
+			std::lock_guard lock{ data.Mutex };
+			return data.Threads.emplace_back(std::make_unique<ThreadProfile>()).get();
+		}();
+		return *threadProfile;
+	}
+
+	/**
+	 * CALL TIMER
+	 */
+
+	inline CallTimer::CallTimer(const FunctionInfo* function)
+		: m_Counters{ &GetThreadProfile().GetCounters(function) }
+		, m_Start{ std::chrono::steady_clock::now() }
+	{}
+
+	inline CallTimer::~CallTimer()
+	{
+		const auto duration = std::chrono::steady_clock::now() - m_Start;
+		m_Counters->Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()));
+	}
+
+	/**
+	 * MERGING
+	 */
+
+	inline std::vector<FunctionProfile> GetFunctionProfiles()
+	{
+		std::unordered_map<const FunctionInfo*, FunctionProfile> merged{};
+
+		{
+			ProfilerData& data = GetProfilerData();
+			std::lock_guard lock{ data.Mutex };
+			const uint64_t generation = data.Generation.load(std::memory_order_relaxed);
+			for (auto& thread : data.Threads)
+			{
+				std::lock_guard threadLock{ thread->m_Mutex };
+				for (auto& [function, counters] : thread->m_Counters)
+				{
+					// the counters of an older generation have not been cleared by their thread yet
+					if (counters->Generation.load(std::memory_order_acquire) != generation)
+						continue;
+
+					FunctionProfile& profile = merged[function];
+					profile.CallCount			+= counters->CallCount.load(std::memory_order_relaxed);
+					profile.TotalNanoseconds	+= counters->TotalNanoseconds.load(std::memory_order_relaxed);
+					profile.MaxNanoseconds		= std::max(profile.MaxNanoseconds, counters->MaxNanoseconds.load(std::memory_order_relaxed));
+					for (size_t i{}; i < HistogramBucketCount; ++i)
+					{
+						profile.Histogram[i] += counters->Histogram[i].load(std::memory_order_relaxed);
+					}
+				}
+			}
+		}
+
+		std::vector<FunctionProfile> profiles{};
+		profiles.reserve(merged.size());
+
+		for (auto& [id, info] : GetGlobalData().FunctionInfoMap)
+		{
+			if (auto it = merged.find(&info); it != merged.end() && it->second.CallCount)
+			{
+				it->second.Function = id;
+				profiles.emplace_back(it->second);
+			}
+		}
+
+		std::ranges::sort(profiles, [](const FunctionProfile& lhs, const FunctionProfile& rhs)
+			{
+				return lhs.TotalNanoseconds > rhs.TotalNanoseconds;
+			});
+
+		return profiles;
+	}
+
+	inline void ResetFunctionProfiles()
+	{
+		GetProfilerData().Generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	/**
+	 * OUTPUT
+	 */
+
+	inline void WriteProfileText(std::ostream& stream)
+	{
+		stream << std::string("Function").append(32, ' ') << " Calls\tTotal (ns)\tAverage (ns)\tMax (ns)\n";
+
+		for (const FunctionProfile& profile : GetFunctionProfiles())
+		{
+			std::string name = profile.Function.GetInfo()->Name;
+			name.resize(std::max<size_t>(name.size(), 40), ' ');
+
+			stream << name << ' '
+				<< profile.CallCount << '\t'
+				<< profile.TotalNanoseconds << '\t'
+				<< static_cast<uint64_t>(profile.GetAverageNanoseconds()) << '\t'
+				<< profile.MaxNanoseconds << '\n';
+		}
+	}
+
+	inline void WriteProfileJson(std::ostream& stream)
+	{
+		stream << '[';
+
+		bool first{ true };
+		for (const FunctionProfile& profile : GetFunctionProfiles())
+		{
+			const FunctionInfo* info = profile.Function.GetInfo();
+
+			stream << (first ? "" : ",")
+				<< "{\"Id\":" << profile.Function.GetId()
+				<< ",\"Name\":\"" << info->Name << '"'
+				<< ",\"Calls\":" << profile.CallCount
+				<< ",\"TotalNanoseconds\":" << profile.TotalNanoseconds
+				<< ",\"MaxNanoseconds\":" << profile.MaxNanoseconds
+				<< ",\"Histogram\":[";
+
+			for (size_t i{}; i < HistogramBucketCount; ++i)
+			{
+				stream << (i ? "," : "") << profile.Histogram[i];
+			}
+			stream << "]}";
+
+			first = false;
+		}
+
+		stream << ']';
+	}
+}
+
+namespace glas
+{
+	inline Profiler::FunctionProfile GetFunctionProfile(FunctionId function)
+	{
+		for (const Profiler::FunctionProfile& profile : Profiler::GetFunctionProfiles())
+		{
+			if (profile.Function.GetId() == function.GetId())
+				return profile;
+		}
+		return Profiler::FunctionProfile{ function };
+	}
+}
+
+#endif
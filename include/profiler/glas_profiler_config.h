@@ -0,0 +1,133 @@
+#pragma once
+
+#ifdef GLAS_PROFILER
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+
+namespace glas::Profiler
+{
+	/**
+	 * Amount of buckets in the latency histogram.
+	 * Bucket 0 contains calls of 0 nanoseconds, bucket N contains calls in the range [2^(N-1), 2^N[ nanoseconds.
+	 * The last bucket also contains every call that took longer.
+	 */
+	constexpr size_t HistogramBucketCount = 32;
+
+	/**
+	 * Merged statistics of all the calls to a single function.
+	 * @see GetFunctionProfile
+	 */
+	struct FunctionProfile
+	{
+		FunctionId										Function			{ };
+		uint64_t										CallCount			{ };
+		uint64_t										TotalNanoseconds	{ };
+		uint64_t										MaxNanoseconds		{ };
+		std::array<uint64_t, HistogramBucketCount>		Histogram			{ };
+
+		double		GetAverageNanoseconds	()	const { return CallCount ? static_cast<double>(TotalNanoseconds) / static_cast<double>(CallCount) : 0.0; }
+	};
+
+	/**
+	 * Counters of a single function on a single thread.
+	 * Only the owning thread writes to the counters, other threads only read them while merging.
+	 * Relaxed atomics are used so that reading is never a data race, without adding locked instructions to the owning thread.
+	 * Resetting only starts a new generation, the owning thread clears its counters when it records into an older generation.
+	 */
+	struct FunctionCounters
+	{
+		std::atomic<uint64_t>								CallCount			{ };
+		std::atomic<uint64_t>								TotalNanoseconds	{ };
+		std::atomic<uint64_t>								MaxNanoseconds		{ };
+		std::array<std::atomic<uint64_t>, HistogramBucketCount>	Histogram		{ };
+		std::atomic<uint64_t>								Generation			{ }; /**< Reset generation that the counters belong to*/
+
+		void		Record					(uint64_t nanoseconds);
+		void		Reset					();
+	};
+
+	/**
+	 * Counters of all the functions that have been called on a single thread.
+	 * The map is only modified by the owning thread, the mutex is taken when inserting a function for the first time and when merging.
+	 */
+	class ThreadProfile final
+	{
+	public:
+		FunctionCounters&	GetCounters		(const FunctionInfo* function);
+
+	private:
+		friend std::vector<FunctionProfile> GetFunctionProfiles();
+		friend void ResetFunctionProfiles();
+
+		std::mutex															m_Mutex			{ };
+		std::unordered_map<const FunctionInfo*, std::unique_ptr<FunctionCounters>>	m_Counters	{ };
+		const FunctionInfo*													m_LastFunction	{ };
+		FunctionCounters*													m_LastCounters	{ };
+	};
+
+	/**
+	 * Get the profile of the calling thread.
+	 * The profile is created the first time this is called and stays alive after the thread exits, so that its counters are still merged.
+	 */
+	ThreadProfile& GetThreadProfile();
+
+	/**
+	 * Measures the duration of a reflected call and records it in the profile of the calling thread.
+	 * Is used by FunctionInfo::Call and FunctionInfo::MemberCall.
+	 */
+	class CallTimer final
+	{
+	public:
+		explicit CallTimer(const FunctionInfo* function);
+		~CallTimer();
+
+		CallTimer(const CallTimer&) = delete;
+		CallTimer(CallTimer&&) noexcept = delete;
+		CallTimer& operator=(const CallTimer&) = delete;
+		CallTimer& operator=(CallTimer&&) noexcept = delete;
+
+	private:
+		FunctionCounters*						m_Counters	{ };
+		std::chrono::steady_clock::time_point	m_Start		{ };
+	};
+
+	/**
+	 * Merges the counters of every thread.
+	 * @returns the profiles of all the functions that have been called, sorted by their total duration.
+	 */
+	std::vector<FunctionProfile> GetFunctionProfiles();
+
+	/**
+	 * Sets all the counters back to 0 by starting a new generation, counters of older generations are no longer merged.
+	 * Calls that are running while resetting are recorded in the old generation.
+	 */
+	void ResetFunctionProfiles();
+
+	/** Writes a human readable table of all the function profiles. */
+	void WriteProfileText(std::ostream& stream);
+
+	/** Writes all the function profiles as a JSON array. */
+	void WriteProfileJson(std::ostream& stream);
+}
+
+namespace glas
+{
+	/**
+	 * Get the merged call statistics of the given function.
+	 * The profile is empty if the function has not been called through FunctionInfo::Call or FunctionInfo::MemberCall.
+	 * @see GLAS_PROFILER
+	 */
+	Profiler::FunctionProfile GetFunctionProfile(FunctionId function);
+}
+
+#endif
@@ -0,0 +1,443 @@
+#pragma once
+
+#ifdef GLAS_RPC
+
+#include <span>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <memory_resource>
+
+#ifdef GLAS_RPC_LOOPBACK
+#include <cerrno>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#endif
+
+#include "../glas_decl.h"
+#include "glas_rpc_config.h"
+
+namespace glas::Rpc
+{
+	/**
+	 * STREAM BUFFERS
+	 */
+
+	inline void SpanInputBuffer::SetData(std::span<const uint8_t> data)
+	{
+		// the buffer is never written to, the const_cast is only needed for the std::streambuf interface
+		char* begin = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+		setg(begin, begin, begin + data.size());
+		m_Size = data.size();
+	}
+
+	inline void SpanInputBuffer::SetPosition(size_t position)
+	{
+		assert(eback() + position <= egptr());
+		setg(eback(), eback() + position, egptr());
+	}
+
+	inline void SpanInputBuffer::SetEnd(size_t end)
+	{
+		assert(end <= m_Size && eback() + end >= gptr());
+		setg(eback(), gptr(), eback() + end);
+	}
+
+	inline std::streamsize VectorOutputBuffer::xsputn(const char* data, std::streamsize count)
+	{
+		assert(m_Vector);
+		const auto bytes = reinterpret_cast<const uint8_t*>(data);
+		m_Vector->insert(m_Vector->end(), bytes, bytes + count);
+		return count;
+	}
+
+	inline VectorOutputBuffer::int_type VectorOutputBuffer::overflow(int_type character)
+	{
+		assert(m_Vector);
+		if (!traits_type::eq_int_type(character, traits_type::eof()))
+		{
+			m_Vector->push_back(static_cast<uint8_t>(traits_type::to_char_type(character)));
+		}
+		return character;
+	}
+
+	/** HELPER FUNCTIONS */
+
+	template <typename T>
+	bool ReadValue(std::istream& stream, T& value)
+	{
+		stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+		return !!stream;
+	}
+
+	template <typename T>
+	void WriteValueAt(std::vector<uint8_t>& buffer, size_t offset, const T& value)
+	{
+		std::memcpy(buffer.data() + offset, &value, sizeof(T));
+	}
+
+	/**
+	 * DISPATCHER
+	 */
+
+	inline Dispatcher::Dispatcher()
+		: m_Input{ &m_InputBuffer }
+		, m_Output{ &m_OutputBuffer }
+	{}
+
+	inline uint32_t Dispatcher::Dispatch(std::span<const uint8_t> request, std::vector<uint8_t>& response)
+	{
+		m_InputBuffer.SetData(request);
+		m_Input.clear();
+		m_OutputBuffer.SetVector(&response);
+		m_Output.clear();
+
+		uint32_t callCount{};
+		if (!ReadValue(m_Input, callCount))
+			return 0;
+
+		const size_t responseStart = response.size();
+		Serialization::WriteStream(m_Output, uint32_t{});
+
+		uint32_t dispatchedCount{};
+		for (; dispatchedCount < callCount; ++dispatchedCount)
+		{
+			uint32_t callSize{};
+			uint64_t functionId{};
+			if (!ReadValue(m_Input, callSize))
+				break;
+
+			const size_t callEnd = m_InputBuffer.GetPosition() + callSize;
+			if (callEnd > request.size() || !ReadValue(m_Input, functionId))
+				break;
+
+			// the status and size of the result are filled in after the call
+			const size_t resultStart = response.size();
+			Serialization::WriteStream(m_Output, CallStatus{});
+			Serialization::WriteStream(m_Output, uint32_t{});
+
+			// the arguments can not read past the end of the call, which also bounds the sizes of their containers
+			m_InputBuffer.SetEnd(callEnd);
+			const CallStatus status = DispatchCall(FunctionId{ functionId }, callEnd);
+
+			const size_t resultHeaderSize = sizeof(CallStatus) + sizeof(uint32_t);
+			WriteValueAt(response, resultStart, status);
+			WriteValueAt(response, resultStart + sizeof(CallStatus), static_cast<uint32_t>(response.size() - resultStart - resultHeaderSize));
+
+			// continue at the next call, even if the arguments of this call were not fully read
+			m_Input.clear();
+			m_InputBuffer.SetEnd(request.size());
+			m_InputBuffer.SetPosition(callEnd);
+		}
+
+		WriteValueAt(response, responseStart, dispatchedCount);
+		return dispatchedCount;
+	}
+
+	inline Dispatcher::CallFrame* Dispatcher::GetFrame(FunctionId function)
+	{
+		if (m_LastFrame && m_LastFunction.GetId() == function.GetId())
+			return m_LastFrame;
+
+		auto it = m_Frames.find(function);
+		if (it == m_Frames.end())
+		{
+			// unknown functions are not cached, so that random ids cannot grow the frame cache
+			const FunctionInfo* info = function.GetInfo();
+			if (!info)
+				return nullptr;
+
+			CallFrame frame{};
+			frame.Info = info;
+
+			if (info->IsMethod() || !info->FunctionCaller || !info->IsPropertySet(FunctionProperties::ServerCallable))
+			{
+				frame.Status = CallStatus::NotServerCallable;
+			}
+			else
+			{
+				std::vector<VariableId> parameters = info->ParameterTypes;
+				frame.Arguments = Storage::TypeTuple(parameters);
+
+				frame.Deserializers.reserve(parameters.size());
+				for (const VariableId parameter : frame.Arguments.GetVariableIds())
+				{
+					frame.Deserializers.emplace_back(parameter.IsPointer() ? nullptr : parameter.GetTypeId().GetInfo().BinaryDeserializer);
+				}
+
+				// references and pointers cannot be sent back, so their return value is discarded
+				const VariableId returnType = info->ReturnType;
+				if (!returnType.IsRefOrPointer() && returnType.GetTypeId().GetId() != TypeId::Create<void>().GetId())
+				{
+					const TypeInfo& returnInfo = returnType.GetTypeId().GetInfo();
+					if (returnInfo.BinarySerializer)
+					{
+						frame.ReturnBuffer = Storage::StorageBuffer{ returnInfo.Size, returnInfo.Align, std::pmr::get_default_resource() };
+						frame.ReturnSerializer = returnInfo.BinarySerializer;
+						frame.ReturnDestructor = returnInfo.Destructor;
+					}
+					else
+					{
+						frame.Status = CallStatus::UnsupportedReturnType;
+					}
+				}
+			}
+
+			it = m_Frames.emplace(function, std::move(frame)).first;
+		}
+
+		m_LastFunction = function;
+		m_LastFrame = &it->second;
+		return m_LastFrame;
+	}
+
+	inline CallStatus Dispatcher::DispatchCall(FunctionId function, size_t callEnd)
+	{
+		CallFrame* pFrame = GetFrame(function);
+		if (!pFrame)
+			return CallStatus::UnknownFunction;
+
+		CallFrame& frame = *pFrame;
+		if (frame.Status != CallStatus::Success)
+			return frame.Status;
+
+		// custom deserializers can throw on malformed arguments
+		try
+		{
+			for (size_t i{}; i < frame.Deserializers.size(); ++i)
+			{
+				if (const auto deserializer = frame.Deserializers[i])
+				{
+					deserializer(m_Input, frame.Arguments.GetVoid(i));
+				}
+			}
+		}
+		catch (...)
+		{
+			return CallStatus::InvalidArguments;
+		}
+
+		if (!m_Input || m_InputBuffer.GetPosition() > callEnd)
+			return CallStatus::InvalidArguments;
+
+		try
+		{
+			// compatibility of the frame was guaranteed when it was created
+#ifdef GLAS_PROFILER
+			Profiler::CallTimer timer{ frame.Info };
+#endif
+			frame.Info->FunctionCaller(frame.Info->FunctionAddress, frame.Arguments, frame.ReturnBuffer.Get());
+		}
+		catch (...)
+		{
+			return CallStatus::Exception;
+		}
+
+		// the return value only lives until it has been written to the response
+		if (frame.ReturnSerializer)
+		{
+			frame.ReturnSerializer(m_Output, frame.ReturnBuffer.Get());
+
+			if (frame.ReturnDestructor)
+				frame.ReturnDestructor(frame.ReturnBuffer.Get());
+		}
+
+		return CallStatus::Success;
+	}
+
+	/**
+	 * REQUEST WRITER
+	 */
+
+	inline RequestWriter::RequestWriter(std::vector<uint8_t>& buffer)
+		: m_Buffer{ buffer }
+		, m_Output{ &m_OutputBuffer }
+	{
+		m_Buffer.clear();
+		m_OutputBuffer.SetVector(&m_Buffer);
+		Serialization::WriteStream(m_Output, uint32_t{});
+	}
+
+	template <typename ... Parameters>
+	void RequestWriter::AddCall(FunctionId function, const Parameters&... parameters)
+	{
+		const size_t callStart = m_Buffer.size();
+		Serialization::WriteStream(m_Output, uint32_t{});
+		Serialization::WriteStream(m_Output, function.GetId());
+
+		(Serialization::SerializeBinary(m_Output, parameters), ...);
+
+		WriteValueAt(m_Buffer, callStart, static_cast<uint32_t>(m_Buffer.size() - callStart - sizeof(uint32_t)));
+		WriteValueAt(m_Buffer, 0, ++m_CallCount);
+	}
+
+	/**
+	 * RESPONSE READER
+	 */
+
+	inline ResponseReader::ResponseReader(std::span<const uint8_t> response)
+		: m_Input{ &m_InputBuffer }
+	{
+		m_InputBuffer.SetData(response);
+		if (!ReadValue(m_Input, m_CallCount))
+			m_CallCount = 0;
+
+		m_NextResult = m_InputBuffer.GetPosition();
+	}
+
+	inline bool ResponseReader::Next()
+	{
+		if (m_ReadCount >= m_CallCount)
+			return false;
+
+		m_Input.clear();
+		m_InputBuffer.SetPosition(m_NextResult);
+
+		uint32_t resultSize{};
+		if (!ReadValue(m_Input, m_Status) || !ReadValue(m_Input, resultSize))
+			return false;
+
+		m_NextResult = m_InputBuffer.GetPosition() + resultSize;
+		++m_ReadCount;
+		return true;
+	}
+
+	template <typename T>
+	T ResponseReader::Read()
+	{
+		assert(m_Status == CallStatus::Success);
+
+		T value{};
+		Serialization::DeserializeBinary(m_Input, value);
+		return value;
+	}
+
+	/**
+	 * LOOPBACK TRANSPORT
+	 */
+
+#ifdef GLAS_RPC_LOOPBACK
+
+#ifdef MSG_NOSIGNAL
+	inline constexpr int SocketSendFlags = MSG_NOSIGNAL;
+#else
+	inline constexpr int SocketSendFlags = 0;
+#endif
+
+	inline bool SocketSendAll(int socket, const void* data, size_t size)
+	{
+		auto bytes = static_cast<const char*>(data);
+		while (size > 0)
+		{
+			const ssize_t sent = ::send(socket, bytes, size, SocketSendFlags);
+			if (sent < 0)
+			{
+				if (errno == EINTR) continue;
+				return false;
+			}
+			bytes += sent;
+			size -= static_cast<size_t>(sent);
+		}
+		return true;
+	}
+
+	inline bool SocketReceiveAll(int socket, void* data, size_t size)
+	{
+		auto bytes = static_cast<char*>(data);
+		while (size > 0)
+		{
+			const ssize_t received = ::recv(socket, bytes, size, 0);
+			if (received < 0 && errno == EINTR)
+				continue;
+			if (received <= 0)
+				return false;
+
+			bytes += received;
+			size -= static_cast<size_t>(received);
+		}
+		return true;
+	}
+
+	inline bool SocketSendMessage(int socket, std::span<const uint8_t> message)
+	{
+		const auto size = static_cast<uint32_t>(message.size());
+		return SocketSendAll(socket, &size, sizeof(size)) && SocketSendAll(socket, message.data(), message.size());
+	}
+
+	inline bool SocketReceiveMessage(int socket, std::vector<uint8_t>& message)
+	{
+		uint32_t size{};
+		if (!SocketReceiveAll(socket, &size, sizeof(size)))
+			return false;
+
+		// keeps the capacity of the vector, so receiving does not allocate once it is large enough
+		message.resize(size);
+		return SocketReceiveAll(socket, message.data(), size);
+	}
+
+	inline LoopbackTransport::LoopbackTransport()
+	{
+		int sockets[2]{ -1, -1 };
+		if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) == 0)
+		{
+			m_ClientSocket = sockets[0];
+			m_ServerSocket = sockets[1];
+			m_ServerThread = std::thread([this] { ServerLoop(); });
+		}
+	}
+
+	inline LoopbackTransport::~LoopbackTransport()
+	{
+		if (m_ClientSocket >= 0)
+		{
+			// the dispatcher thread stops once it cannot receive anymore
+			::shutdown(m_ClientSocket, SHUT_RDWR);
+		}
+
+		if (m_ServerThread.joinable())
+		{
+			m_ServerThread.join();
+		}
+
+		if (m_ClientSocket >= 0) ::close(m_ClientSocket);
+		if (m_ServerSocket >= 0) ::close(m_ServerSocket);
+	}
+
+	inline bool LoopbackTransport::Send(std::span<const uint8_t> request)
+	{
+		return IsConnected() && SocketSendMessage(m_ClientSocket, request);
+	}
+
+	inline bool LoopbackTransport::Receive(std::vector<uint8_t>& response)
+	{
+		return IsConnected() && SocketReceiveMessage(m_ClientSocket, response);
+	}
+
+	inline bool LoopbackTransport::Call(std::span<const uint8_t> request, std::vector<uint8_t>& response)
+	{
+		return Send(request) && Receive(response);
+	}
+
+	inline void LoopbackTransport::ServerLoop()
+	{
+		std::vector<uint8_t> request{};
+		std::vector<uint8_t> response{};
+
+		while (SocketReceiveMessage(m_ServerSocket, request))
+		{
+			response.clear();
+			m_Dispatcher.Dispatch(request, response);
+
+			if (!SocketSendMessage(m_ServerSocket, response))
+				break;
+		}
+	}
+#endif
+}
+
+#endif
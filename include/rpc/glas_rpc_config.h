@@ -0,0 +1,244 @@
+#pragma once
+
+#ifdef GLAS_RPC
+
+#if !defined(GLAS_STORAGE) || !defined(GLAS_SERIALIZATION_BINARY)
+#error "GLAS_RPC requires the GLAS_STORAGE and GLAS_SERIALIZATION_BINARY addons to be enabled"
+#endif
+
+#include <span>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+#include "../storage/glas_storage_config.h"
+
+/**
+ * Platforms that support the unix domain socket loopback transport.
+ * @see LoopbackTransport
+ */
+#if defined(__unix__) || defined(__APPLE__)
+#define GLAS_RPC_LOOPBACK
+#endif
+
+namespace glas::Rpc
+{
+	/**
+	 * Result of a single call inside of a response.
+	 */
+	enum class CallStatus : uint8_t
+	{
+		Success,
+		UnknownFunction,		/**< The FunctionId is not registered*/
+		NotServerCallable,		/**< The function is a method or does not have the ServerCallable property*/
+		InvalidArguments,		/**< The arguments could not be deserialized from the request*/
+		UnsupportedReturnType,	/**< The return type has no binary serializer*/
+		Exception,				/**< The function threw an exception*/
+	};
+
+	/**
+	 * Read-only stream buffer over an existing block of memory.
+	 * Used to deserialize arguments directly from a request without copying it.
+	 */
+	class SpanInputBuffer final : public std::streambuf
+	{
+	public:
+		void		SetData		(std::span<const uint8_t> data);
+		size_t		GetPosition	()					const	{ return static_cast<size_t>(gptr() - eback()); }
+		void		SetPosition	(size_t position);
+
+		/** Limits reading to the first end bytes of the data, so that a call can not read into the next one. */
+		void		SetEnd		(size_t end);
+
+	private:
+		size_t		m_Size		{ };
+	};
+
+	/**
+	 * Stream buffer that appends everything that is written to a std::vector.
+	 * The vector keeps its capacity between calls, so steady state writes do not allocate.
+	 */
+	class VectorOutputBuffer final : public std::streambuf
+	{
+	public:
+		void					SetVector	(std::vector<uint8_t>* vector)	{ m_Vector = vector; }
+		std::vector<uint8_t>*	GetVector	()						const	{ return m_Vector; }
+
+	protected:
+		std::streamsize			xsputn		(const char* data, std::streamsize count) override;
+		int_type				overflow	(int_type character) override;
+
+	private:
+		std::vector<uint8_t>* m_Vector{};
+	};
+
+	/**
+	 * Executes ServerCallable functions that are encoded inside of a byte buffer.
+	 *
+	 * Request layout:
+	 *		uint32_t call count, followed by the calls:
+	 *		uint32_t size of the call (FunctionId + arguments), uint64_t FunctionId, binary serialized arguments.
+	 *
+	 * Response layout:
+	 *		uint32_t call count, followed by the results:
+	 *		CallStatus, uint32_t size of the return value, binary serialized return value.
+	 *
+	 * Arguments are deserialized into an argument frame that is cached per function and reused by every following call.
+	 * Pointer parameters are not sent and will be nullptr. Only free functions with the ServerCallable property can be called.
+	 * A dispatcher is not thread safe, use one dispatcher per thread or connection.
+	 * @see RequestWriter
+	 * @see ResponseReader
+	 */
+	class Dispatcher final
+	{
+	public:
+		Dispatcher();
+		~Dispatcher() = default;
+
+		Dispatcher(const Dispatcher&) = delete;
+		Dispatcher(Dispatcher&&) noexcept = delete;
+		Dispatcher& operator=(const Dispatcher&) = delete;
+		Dispatcher& operator=(Dispatcher&&) noexcept = delete;
+
+	public:
+		/**
+		 * Executes every call inside of the request and appends the results to the response.
+		 * @returns the amount of calls that were executed.
+		 */
+		uint32_t		Dispatch		(std::span<const uint8_t> request, std::vector<uint8_t>& response);
+
+	private:
+		struct CallFrame
+		{
+			const FunctionInfo*							Info			{ };
+			Storage::TypeTuple							Arguments		{ };
+			Storage::StorageBuffer						ReturnBuffer	{ }; /**< Uninitialized memory with the alignment of the return type that the return value is constructed in*/
+			std::vector<void(*)(std::istream&, void*)>	Deserializers	{ }; /**< Deserializer per argument, nullptr for pointers*/
+			void (*ReturnSerializer)(std::ostream&, const void*) { };
+			void (*ReturnDestructor)(void*)				{ };
+			CallStatus									Status			{ }; /**< Status returned when the function cannot be called*/
+		};
+
+		CallFrame*		GetFrame		(FunctionId function);
+		CallStatus		DispatchCall	(FunctionId function, size_t callEnd);
+
+	private:
+		std::unordered_map<FunctionId, CallFrame>	m_Frames		{ };
+		FunctionId									m_LastFunction	{ };
+		CallFrame*									m_LastFrame		{ };
+
+		SpanInputBuffer								m_InputBuffer	{ };
+		std::istream								m_Input;
+		VectorOutputBuffer							m_OutputBuffer	{ };
+		std::ostream								m_Output;
+	};
+
+	/**
+	 * Encodes calls into a request buffer that can be executed by a Dispatcher.
+	 * The types of the arguments must match the parameter types of the function without references.
+	 */
+	class RequestWriter final
+	{
+	public:
+		/** Clears the buffer and writes the request header. */
+		explicit RequestWriter(std::vector<uint8_t>& buffer);
+
+		RequestWriter(const RequestWriter&) = delete;
+		RequestWriter(RequestWriter&&) noexcept = delete;
+		RequestWriter& operator=(const RequestWriter&) = delete;
+		RequestWriter& operator=(RequestWriter&&) noexcept = delete;
+
+	public:
+		template <typename... Parameters>
+		void			AddCall			(FunctionId function, const Parameters&... parameters);
+
+		uint32_t		GetCallCount	()	const	{ return m_CallCount; }
+
+	private:
+		std::vector<uint8_t>&	m_Buffer;
+		VectorOutputBuffer		m_OutputBuffer	{ };
+		std::ostream			m_Output;
+		uint32_t				m_CallCount		{ };
+	};
+
+	/**
+	 * Reads the results inside of a response buffer that was created by a Dispatcher.
+	 */
+	class ResponseReader final
+	{
+	public:
+		explicit ResponseReader(std::span<const uint8_t> response);
+
+		ResponseReader(const ResponseReader&) = delete;
+		ResponseReader(ResponseReader&&) noexcept = delete;
+		ResponseReader& operator=(const ResponseReader&) = delete;
+		ResponseReader& operator=(ResponseReader&&) noexcept = delete;
+
+	public:
+		/** Moves to the next result. @returns false if there are no results left. */
+		bool			Next			();
+
+		uint32_t		GetCallCount	()	const	{ return m_CallCount; }
+		CallStatus		GetStatus		()	const	{ return m_Status; }
+
+		/** Deserializes the return value of the current result. */
+		template <typename T>
+		T				Read			();
+
+	private:
+		SpanInputBuffer	m_InputBuffer	{ };
+		std::istream	m_Input;
+		uint32_t		m_CallCount		{ };
+		uint32_t		m_ReadCount		{ };
+		size_t			m_NextResult	{ };
+		CallStatus		m_Status		{ };
+	};
+
+#ifdef GLAS_RPC_LOOPBACK
+	/**
+	 * Transport that sends requests over a unix domain socket pair to a Dispatcher running on its own thread.
+	 * Every message is prefixed with its uint32_t size. Requests can be pipelined by sending multiple requests before receiving the responses.
+	 * Mainly intended for benchmarking the dispatcher including the cost of a socket round trip.
+	 */
+	class LoopbackTransport final
+	{
+	public:
+		LoopbackTransport();
+		~LoopbackTransport();
+
+		LoopbackTransport(const LoopbackTransport&) = delete;
+		LoopbackTransport(LoopbackTransport&&) noexcept = delete;
+		LoopbackTransport& operator=(const LoopbackTransport&) = delete;
+		LoopbackTransport& operator=(LoopbackTransport&&) noexcept = delete;
+
+	public:
+		bool			IsConnected		()	const	{ return m_ClientSocket >= 0; }
+
+		/** Sends a request to the dispatcher thread without waiting for the response. */
+		bool			Send			(std::span<const uint8_t> request);
+
+		/** Blocks until the next response has been received. */
+		bool			Receive			(std::vector<uint8_t>& response);
+
+		/** Sends a request and waits for its response. */
+		bool			Call			(std::span<const uint8_t> request, std::vector<uint8_t>& response);
+
+	private:
+		void			ServerLoop		();
+
+	private:
+		Dispatcher		m_Dispatcher	{ };
+		int				m_ClientSocket	{ -1 };
+		int				m_ServerSocket	{ -1 };
+		std::thread		m_ServerThread	{ };
+	};
+#endif
+}
+
+#endif
@@ -7,6 +7,7 @@
 
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 #include <functional>
 #include <type_traits>
 #include <cassert>
@@ -60,6 +61,39 @@ namespace glas::Serialization
 		return t;
 	}
 
+	/**
+	 * Sizes that are read from the stream can not be trusted, so containers only allocate memory for elements that can still be read.
+	 * std::streambuf::in_avail is exact for memory buffers and a lower bound for other buffers.
+	 * @returns the amount of elements of elementSize bytes that can be allocated up front, at most size.
+	 */
+	inline size_t GetReserveCount(std::istream& stream, size_t size, size_t elementSize)
+	{
+		constexpr std::streamsize minimumBytes{ 4096 };
+		const std::streamsize available = stream.rdbuf() ? std::max(stream.rdbuf()->in_avail(), minimumBytes) : minimumBytes;
+		return std::min(size, std::max<size_t>(static_cast<size_t>(available) / elementSize, 1));
+	}
+
+	/**
+	 * Reads size trivially copyable elements into a contiguous container.
+	 * The container grows with the data that is read, so a corrupt size fails the stream instead of allocating all of the memory.
+	 */
+	template <typename T, typename Container>
+	void ReadElements(std::istream& stream, Container& value, size_t size)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+
+		value.clear();
+		while (size && stream)
+		{
+			const size_t offset = value.size();
+			const size_t count = GetReserveCount(stream, size, sizeof(T));
+
+			value.resize(offset + count);
+			stream.read(reinterpret_cast<char*>(value.data() + offset), static_cast<std::streamsize>(count * sizeof(T)));
+			size -= count;
+		}
+	}
+
 	template <typename T>
 	void SerializeBinary(std::ostream& stream, const T& value)
 	{
@@ -133,7 +167,64 @@ namespace glas::Serialization
 		}
 	}
 
-#ifdef _STRING_
+	/** POLYMORPHIC */
+	template <typename T>
+	void SerializeBinaryPolymorphic(std::ostream& stream, const T* instance) requires std::is_polymorphic_v<T>
+	{
+		if (!instance)
+		{
+			WriteStream(stream, PolymorphicTypeTable::NullIndex);
+			return;
+		}
+
+		TypeId dynamicType{};
+		void* data = GetDynamicInstance(instance, dynamicType);
+
+		WithPolymorphicTypeTable([&](PolymorphicTypeTable& table)
+			{
+				bool isNew{};
+				WriteStream(stream, table.WriteType(dynamicType, isNew));
+				if (isNew)
+					WriteStream(stream, dynamicType);
+			});
+
+		ForEachPolymorphicPart(dynamicType.GetInfo(), data, [&stream](const TypeInfo& info, void* part)
+			{
+				info.BinarySerializer(stream, part);
+			});
+	}
+
+#ifdef GLAS_STORAGE
+	template <typename T>
+	T* DeserializeBinaryPolymorphic(std::istream& stream) requires std::is_polymorphic_v<T>
+	{
+		const uint32_t index = ReadStream<uint32_t>(stream);
+		if (index == PolymorphicTypeTable::NullIndex)
+			return nullptr;
+
+		const TypeInfo* info = WithPolymorphicTypeTable([&](PolymorphicTypeTable& table)
+			{
+				return table.IsNewIndex(index) ? table.AddType(ReadStream<TypeId>(stream)) : table.GetType(index);
+			});
+
+		// the layout of an unknown type is unknown as well, so the rest of the stream can not be read
+		if (!CanConstructPolymorphic<T>(info))
+		{
+			stream.setstate(std::ios::failbit);
+			return nullptr;
+		}
+
+		// owned until every part has been read, so that a throwing deserializer does not leak the instance
+		std::unique_ptr<T> instance{ ConstructPolymorphic<T>(*info) };
+		ForEachPolymorphicPart(*info, DownCast(instance.get(), TypeId::Create<T>().GetInfo(), *info), [&stream](const TypeInfo& partInfo, void* part)
+			{
+				partInfo.BinaryDeserializer(stream, part);
+			});
+		return instance.release();
+	}
+#endif
+
+#if defined(_STRING_) || defined(_GLIBCXX_STRING)
 	/** STRING */
 	template <typename Elem, typename Traits, typename Alloc>
 	void BinarySerializer<std::basic_string<Elem, Traits, Alloc>>::Serialize(std::ostream& stream, const std::basic_string<Elem, Traits, Alloc>& value)
@@ -145,16 +236,15 @@ namespace glas::Serialization
 	template <typename Elem, typename Traits, typename Alloc>
 	void BinarySerializer<std::basic_string<Elem, Traits, Alloc>>::Deserialize(std::istream& stream, std::basic_string<Elem, Traits, Alloc>& value)
 	{
-		size_t size = ReadStream<size_t>(stream);
-
-		value.clear();
-		value.resize(size);
+		const size_t size = ReadStream<size_t>(stream);
+		if (!stream)
+			return;
 
-		stream.read(value.data(), size * sizeof(Elem));
+		ReadElements<Elem>(stream, value, size);
 	}
 #endif
 
-#ifdef _VECTOR_
+#if defined(_VECTOR_) || defined(_GLIBCXX_VECTOR)
 	/** VECTOR */
 	template <typename T, typename Alloc>
 	void BinarySerializer<std::vector<T, Alloc>>::Serialize(std::ostream& stream, const std::vector<T, Alloc>& value)
@@ -180,21 +270,21 @@ namespace glas::Serialization
 	{
 		if constexpr (std::is_trivially_copyable_v<T>)
 		{
-			size_t size = ReadStream<size_t>(stream);
-
-			value.clear();
-			value.resize(size);
+			const size_t size = ReadStream<size_t>(stream);
+			if (!stream)
+				return;
 
-			stream.read(reinterpret_cast<char*>(value.data()), size * sizeof(T));
+			ReadElements<T>(stream, value, size);
 		}
 		else
 		{
 			size_t size = ReadStream<size_t>(stream);
 
 			value.clear();
-			value.reserve(size);
+			if (stream)
+				value.reserve(GetReserveCount(stream, size, 1));
 
-			for (size_t i{}; i < size; ++i)
+			for (size_t i{}; i < size && stream; ++i)
 			{
 				auto& element = value.emplace_back();
 				DeserializeBinary(stream, element);
@@ -223,7 +313,7 @@ namespace glas::Serialization
 
 #endif
 
-#ifdef _ARRAY_
+#if defined(_ARRAY_) || defined(_GLIBCXX_ARRAY)
 	/** ARRAY */
 	template <typename T, size_t Size>
 	void BinarySerializer<std::array<T, Size>>::Serialize(std::ostream& stream, const std::array<T, Size>& value)
@@ -255,7 +345,7 @@ namespace glas::Serialization
 
 #endif
 
-#ifdef _DEQUE_
+#if defined(_DEQUE_) || defined(_GLIBCXX_DEQUE)
 	/** DEQUE */
 	template <typename T, typename Alloc>
 	void BinarySerializer<std::deque<T, Alloc>>::Serialize(std::ostream& stream, const std::deque<T, Alloc>& value)
@@ -273,7 +363,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto& element = value.emplace_back();
 			DeserializeBinary(stream, element);
@@ -281,7 +371,7 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _FORWARD_LIST_
+#if defined(_FORWARD_LIST_) || defined(_GLIBCXX_FORWARD_LIST)
 	/** FORWARD LIST */
 	template <typename T, typename Alloc>
 	void BinarySerializer<std::forward_list<T, Alloc>>::Serialize(std::ostream& stream, const std::forward_list<T, Alloc>& value)
@@ -300,7 +390,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto& element = value.emplace_front();
 			DeserializeBinary(stream, element);
@@ -308,7 +398,7 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _LIST_
+#if defined(_LIST_) || defined(_GLIBCXX_LIST)
 	/** LIST */
 	template <typename T, typename Alloc>
 	void BinarySerializer<std::list<T, Alloc>>::Serialize(std::ostream& stream, const std::list<T, Alloc>& value)
@@ -326,7 +416,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto& element = value.emplace_back();
 			DeserializeBinary(stream, element);
@@ -334,7 +424,7 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _SET_
+#if defined(_SET_) || defined(_GLIBCXX_SET)
 	/** UNORDERED SET */
 	template <typename T, typename Hasher, typename Keyeq, typename Alloc>
 	void BinarySerializer<std::unordered_set<T, Hasher, Keyeq, Alloc>>::Serialize(std::ostream& stream, const std::unordered_set<T, Hasher, Keyeq, Alloc>& value)
@@ -352,7 +442,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto element = T{};
 			DeserializeBinary(stream, element);
@@ -377,7 +467,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto element = T{};
 			DeserializeBinary(stream, element);
@@ -386,7 +476,7 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _MAP_
+#if defined(_MAP_) || defined(_GLIBCXX_MAP)
 	/** MAP */
 	template <typename Key, typename Value, typename P, typename Alloc>
 	void BinarySerializer<std::map<Key, Value, P, Alloc>>::Serialize(std::ostream& stream, const std::map<Key, Value, P, Alloc>& value)
@@ -404,7 +494,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto element = std::pair<Key, Value>{};
 			DeserializeBinary(stream, element);
@@ -429,7 +519,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto element = std::pair<Key, Value>{};
 			DeserializeBinary(stream, element);
@@ -438,7 +528,7 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _UNORDERED_MAP_
+#if defined(_UNORDERED_MAP_) || defined(_GLIBCXX_UNORDERED_MAP)
 	/** UNORDERED MAP */
 	template <typename Key, typename Value, typename Hasher, typename Keyeq, typename Alloc>
 	void BinarySerializer<std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>>::Serialize(std::ostream& stream, const std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>& value)
@@ -456,7 +546,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto element = std::pair<Key, Value>{};
 			DeserializeBinary(stream, element);
@@ -481,7 +571,7 @@ namespace glas::Serialization
 
 		value.clear();
 
-		for (size_t i{}; i < size; ++i)
+		for (size_t i{}; i < size && stream; ++i)
 		{
 			auto element = std::pair<Key, Value>{};
 			DeserializeBinary(stream, element);
@@ -490,28 +580,46 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _MEMORY_
+#if defined(_MEMORY_) || defined(_GLIBCXX_MEMORY)
 	/** UNIQUE PTR */
 	template <typename T, typename Delete>
 	void BinarySerializer<std::unique_ptr<T, Delete>>::Serialize(std::ostream& stream, const std::unique_ptr<T, Delete>& value)
 	{
-		WriteStream(stream, static_cast<bool>(value));
-		if (value)
-			SerializeBinary(stream, *value);
+		if constexpr (std::is_polymorphic_v<T>)
+		{
+			SerializeBinaryPolymorphic(stream, value.get());
+		}
+		else
+		{
+			WriteStream(stream, static_cast<bool>(value));
+			if (value)
+				SerializeBinary(stream, *value);
+		}
 	}
 
 	template <typename T, typename Delete>
 	void BinarySerializer<std::unique_ptr<T, Delete>>::Deserialize(std::istream& stream, std::unique_ptr<T, Delete>& value)
 	{
+#ifdef GLAS_STORAGE
+		if constexpr (std::is_polymorphic_v<T>)
+		{
+			value.reset(DeserializeBinaryPolymorphic<T>(stream));
+			return;
+		}
+#endif
 		if (ReadStream<bool>(stream))
 		{
 			value = std::make_unique_for_overwrite<T>();
-			DeserializeBinary(stream, value);
+			DeserializeBinary(stream, *value);
+		}
+		else
+		{
+			value.reset();
 		}
 	}
 #endif
 
-#ifdef _OPTIONAL_
+#if defined(_OPTIONAL_) || defined(_GLIBCXX_OPTIONAL)
 	/** OPTIONAL */
 	template <typename T>
 	void BinarySerializer<std::optional<T>>::Serialize(std::ostream& stream, const std::optional<T>& value)
@@ -532,7 +640,7 @@ namespace glas::Serialization
 	}
 #endif
 
-#ifdef _UTILITY_
+#if defined(_UTILITY_) || defined(_GLIBCXX_UTILITY)
 	/** PAIR */
 	template <typename T1, typename T2>
 	void BinarySerializer<std::pair<T1, T2>>::Serialize(std::ostream& stream, const std::pair<T1, T2>& value)
@@ -634,12 +742,16 @@ namespace glas::Serialization
 
 	inline void BinarySerializer<Storage::TypeTuple>::Deserialize(std::istream& stream, Storage::TypeTuple& value)
 	{
-		uint32_t size = ReadStream<uint32_t>(stream);
-		
-		auto variables = std::make_unique<VariableId[]>(size);
-		stream.read(reinterpret_cast<char*>(variables.get()), static_cast<std::streamsize>(sizeof(VariableId) * size));
+		const uint32_t size = ReadStream<uint32_t>(stream);
+		if (!stream)
+			return;
+
+		std::vector<VariableId> variables{};
+		ReadElements<VariableId>(stream, variables, size);
+		if (!stream)
+			return;
 
-		value = Storage::TypeTuple(std::span(variables.get(), size));
+		value = Storage::TypeTuple(std::span(variables));
 
 		for (size_t i{}; i < size; ++i)
 		{
@@ -679,17 +791,17 @@ namespace glas::Serialization
 		value = Storage::TypeVector(id);
 
 		const size_t size = ReadStream<size_t>(stream);
-		value.Resize(size);
-
-		if (!id.IsValid())
+		if (!stream || !id.IsValid())
 			return;
 
 		const auto& info = id.GetInfo();
 		const auto binaryDeserializer = info.BinaryDeserializer;
 
-		for (auto element : value)
+		// elements are only added while they can be read, a corrupt size does not allocate all of them up front
+		value.Reserve(GetReserveCount(stream, size, 1));
+		for (size_t i{}; i < size && stream; ++i)
 		{
-			binaryDeserializer(stream, element);
+			binaryDeserializer(stream, value.PushBack());
 		}
 	}
 
@@ -23,6 +23,7 @@
 #include <utility>
 
 #include "../glas_decl.h"
+#include "glas_serialization_polymorphic.h"
 
 #ifdef GLAS_STORAGE
 #include "../storage/glas_storage_config.h"
@@ -71,7 +72,24 @@ namespace glas::Serialization
 	template <typename T>
 	void DeserializeBinaryDefault(std::istream& stream, T& value);
 
-#ifdef _STRING_
+	/**
+	 * Serializes the polymorphic instance as its dynamic type, preceded by a reference into the PolymorphicTypeTable.
+	 * Null pointers are supported.
+	 * @see PolymorphicScope
+	 */
+	template <typename T>
+	void SerializeBinaryPolymorphic(std::ostream& stream, const T* instance) requires std::is_polymorphic_v<T>;
+
+#ifdef GLAS_STORAGE
+	/**
+	 * Constructs and deserializes an instance of the dynamic type that was written by SerializeBinaryPolymorphic.
+	 * @returns the new instance that is owned by the caller, or nullptr.
+	 */
+	template <typename T>
+	T* DeserializeBinaryPolymorphic(std::istream& stream) requires std::is_polymorphic_v<T>;
+#endif
+
+#if defined(_STRING_) || defined(_GLIBCXX_STRING)
 	/** STRING */
 	template <typename Elem, typename Traits, typename Alloc>
 	struct BinarySerializer<std::basic_string<Elem, Traits, Alloc>>
@@ -81,7 +99,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _VECTOR_
+#if defined(_VECTOR_) || defined(_GLIBCXX_VECTOR)
 	/** VECTOR */
 	template <typename T, typename Alloc>
 	struct BinarySerializer<std::vector<T, Alloc>>
@@ -98,7 +116,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _ARRAY_
+#if defined(_ARRAY_) || defined(_GLIBCXX_ARRAY)
 	/** ARRAY */
 	template <typename T, size_t Size>
 	struct BinarySerializer<std::array<T, Size>>
@@ -108,7 +126,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _DEQUE_
+#if defined(_DEQUE_) || defined(_GLIBCXX_DEQUE)
 	/** DEQUE*/
 	template <typename T, typename Alloc>
 	struct BinarySerializer<std::deque<T, Alloc>>
@@ -118,7 +136,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _FORWARD_LIST_
+#if defined(_FORWARD_LIST_) || defined(_GLIBCXX_FORWARD_LIST)
 	/** FORWARD LIST */
 	template <typename T, typename Alloc>
 	struct BinarySerializer<std::forward_list<T, Alloc>>
@@ -128,7 +146,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _LIST_
+#if defined(_LIST_) || defined(_GLIBCXX_LIST)
 	/** LIST */
 	template <typename T, typename Alloc>
 	struct BinarySerializer<std::list<T, Alloc>>
@@ -138,7 +156,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _SET_
+#if defined(_SET_) || defined(_GLIBCXX_SET)
 	/** UNORDERED SET */
 	template <typename T, typename Hasher, typename Keyeq, typename Alloc>
 	struct BinarySerializer<std::unordered_set<T, Hasher, Keyeq, Alloc>>
@@ -156,7 +174,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _MAP_
+#if defined(_MAP_) || defined(_GLIBCXX_MAP)
 	/** MAP */
 	template <typename Key, typename Value, typename P, typename Alloc>
 	struct BinarySerializer<std::map<Key, Value, P, Alloc>>
@@ -174,7 +192,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _UNORDERED_MAP_
+#if defined(_UNORDERED_MAP_) || defined(_GLIBCXX_UNORDERED_MAP)
 	/** UNORDERED MAP */
 	template <typename Key, typename Value, typename Hasher, typename Keyeq, typename Alloc>
 	struct BinarySerializer<std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>>
@@ -192,7 +210,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _MEMORY_
+#if defined(_MEMORY_) || defined(_GLIBCXX_MEMORY)
 	/** UNIQUE PTR */
 	template <typename T, typename Delete>
 	struct BinarySerializer<std::unique_ptr<T, Delete>>
@@ -202,7 +220,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _OPTIONAL_
+#if defined(_OPTIONAL_) || defined(_GLIBCXX_OPTIONAL)
 	/** OPTIONAL */
 	template <typename T>
 	struct BinarySerializer<std::optional<T>>
@@ -212,7 +230,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _UTILITY_
+#if defined(_UTILITY_) || defined(_GLIBCXX_UTILITY)
 	/** PAIR */
 	template <typename T1, typename T2>
 	struct BinarySerializer<std::pair<T1, T2>>
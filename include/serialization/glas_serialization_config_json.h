@@ -22,6 +22,7 @@
 #include <utility>
 
 #include "../glas_decl.h"
+#include "glas_serialization_polymorphic.h"
 
 #ifdef GLAS_STORAGE
 #include "../storage/glas_storage_config.h"
@@ -79,6 +80,23 @@ namespace glas::Serialization
 	template <typename T>
 	void DeserializeJSonDefault(rapidjson::Value& jsonVal, T& value);
 
+	/**
+	 * Serializes the polymorphic instance as its dynamic type into an object, or null.
+	 * The object references the type through the PolymorphicTypeTable, the first reference also contains the TypeId.
+	 * @see PolymorphicScope
+	 */
+	template <typename T>
+	void SerializeJSonPolymorphic(rapidjson::Value& jsonVal, const T* instance, RapidJsonAllocator& allocator) requires std::is_polymorphic_v<T>;
+
+#ifdef GLAS_STORAGE
+	/**
+	 * Constructs and deserializes an instance of the dynamic type that was written by SerializeJSonPolymorphic.
+	 * @returns the new instance that is owned by the caller, or nullptr.
+	 */
+	template <typename T>
+	T* DeserializeJSonPolymorphic(rapidjson::Value& jsonVal) requires std::is_polymorphic_v<T>;
+#endif
+
 	/** FLOAT */
 	template <>
 	struct JSonSerializer<float>
@@ -172,7 +190,7 @@ namespace glas::Serialization
 		static void Deserialize(rapidjson::Value& jsonVal, FunctionId& value);
 	};
 
-#ifdef _STRING_
+#if defined(_STRING_) || defined(_GLIBCXX_STRING)
 	/** STRING */
 	template <typename Elem, typename Traits, typename Alloc>
 	struct JSonSerializer<std::basic_string<Elem, Traits, Alloc>>
@@ -182,7 +200,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _VECTOR_
+#if defined(_VECTOR_) || defined(_GLIBCXX_VECTOR)
 	/** VECTOR */
 	template <typename T, typename Alloc>
 	struct JSonSerializer<std::vector<T, Alloc>>
@@ -192,7 +210,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _ARRAY_
+#if defined(_ARRAY_) || defined(_GLIBCXX_ARRAY)
 	/** ARRAY */
 	template <typename T, size_t Size>
 	struct JSonSerializer<std::array<T, Size>>
@@ -202,7 +220,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _DEQUE_
+#if defined(_DEQUE_) || defined(_GLIBCXX_DEQUE)
 	/** DEQUE*/
 	template <typename T, typename Alloc>
 	struct JSonSerializer<std::deque<T, Alloc>>
@@ -212,7 +230,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _FORWARD_LIST_
+#if defined(_FORWARD_LIST_) || defined(_GLIBCXX_FORWARD_LIST)
 	/** FORWARD LIST */
 	template <typename T, typename Alloc>
 	struct JSonSerializer<std::forward_list<T, Alloc>>
@@ -222,7 +240,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _LIST_
+#if defined(_LIST_) || defined(_GLIBCXX_LIST)
 	/** LIST */
 	template <typename T, typename Alloc>
 	struct JSonSerializer<std::list<T, Alloc>>
@@ -232,7 +250,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _SET_
+#if defined(_SET_) || defined(_GLIBCXX_SET)
 	/** UNORDERED SET */
 	template <typename T, typename Hasher, typename Keyeq, typename Alloc>
 	struct JSonSerializer<std::unordered_set<T, Hasher, Keyeq, Alloc>>
@@ -250,7 +268,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _MAP_
+#if defined(_MAP_) || defined(_GLIBCXX_MAP)
 	/** MAP */
 	template <typename Key, typename Value, typename P, typename Alloc>
 	struct JSonSerializer<std::map<Key, Value, P, Alloc>>
@@ -268,7 +286,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _UNORDERED_MAP_
+#if defined(_UNORDERED_MAP_) || defined(_GLIBCXX_UNORDERED_MAP)
 	/** UNORDERED MAP */
 	template <typename Key, typename Value, typename Hasher, typename Keyeq, typename Alloc>
 	struct JSonSerializer<std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>>
@@ -286,7 +304,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _MEMORY_
+#if defined(_MEMORY_) || defined(_GLIBCXX_MEMORY)
 	/** UNIQUE PTR */
 	template <typename T, typename Delete>
 	struct JSonSerializer<std::unique_ptr<T, Delete>>
@@ -296,7 +314,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _OPTIONAL_
+#if defined(_OPTIONAL_) || defined(_GLIBCXX_OPTIONAL)
 	/** OPTIONAL */
 	template <typename T>
 	struct JSonSerializer<std::optional<T>>
@@ -306,7 +324,7 @@ namespace glas::Serialization
 	};
 #endif
 
-#ifdef _UTILITY_
+#if defined(_UTILITY_) || defined(_GLIBCXX_UTILITY)
 	/** PAIR */
 	template <typename T1, typename T2>
 	struct JSonSerializer<std::pair<T1, T2>>
@@ -7,6 +7,9 @@
 #include <type_traits>
 
 #include "../glas_decl.h"
+#include "glas_serialization_polymorphic.h"
+
+#include <memory>
 
 #ifdef GLAS_STORAGE
 #include "../storage/glas_storage_config.h"
@@ -44,6 +47,23 @@ namespace glas::Serialization
 
 	inline YAML::Node SerializeYamlDefault(const void* data, glas::TypeId type);
 	inline bool DeserializeYamlDefault(const YAML::Node& node, void* data, glas::TypeId type);
+
+	/**
+	 * Serializes the polymorphic instance as its dynamic type into a map, or a null node.
+	 * The map references the type through the PolymorphicTypeTable, the first reference also contains the TypeId.
+	 * @see PolymorphicScope
+	 */
+	template <typename T>
+	YAML::Node SerializeYamlPolymorphic(const T* instance) requires std::is_polymorphic_v<T>;
+
+#ifdef GLAS_STORAGE
+	/**
+	 * Constructs and deserializes an instance of the dynamic type that was written by SerializeYamlPolymorphic.
+	 * @returns the new instance that is owned by the caller, or nullptr.
+	 */
+	template <typename T>
+	T* DeserializeYamlPolymorphic(const YAML::Node& node) requires std::is_polymorphic_v<T>;
+#endif
 }
 
 namespace YAML
@@ -59,6 +79,17 @@ namespace YAML
         static bool decode(const Node& node, T& rhs);
     };
 
+	/**
+	 * UNIQUE PTR
+	 */
+	template<typename T, typename Delete>
+	struct convert<std::unique_ptr<T, Delete>>
+	{
+		static Node encode(const std::unique_ptr<T, Delete>& value);
+
+		static bool decode(const Node& node, std::unique_ptr<T, Delete>& rhs);
+	};
+
 }
 
 #endif
\ No newline at end of file
@@ -164,6 +164,85 @@ namespace glas::Serialization
 		DeserializeJSonDefault(jsonVal, static_cast<void*>(&value), TypeId::Create<T>());
 	}
 
+	/** POLYMORPHIC */
+	template <typename T>
+	void SerializeJSonPolymorphic(rapidjson::Value& jsonVal, const T* instance, RapidJsonAllocator& allocator) requires std::is_polymorphic_v<T>
+	{
+		if (!instance)
+		{
+			jsonVal.SetNull();
+			return;
+		}
+
+		TypeId dynamicType{};
+		void* data = GetDynamicInstance(instance, dynamicType);
+
+		jsonVal.SetObject();
+
+		WithPolymorphicTypeTable([&](PolymorphicTypeTable& table)
+			{
+				bool isNew{};
+				rapidjson::Value indexVal{ table.WriteType(dynamicType, isNew) };
+				jsonVal.AddMember("Type Index", indexVal, allocator);
+
+				if (isNew)
+				{
+					rapidjson::Value typeVal{};
+					JSonSerializer<TypeId>::Serialize(typeVal, dynamicType, allocator);
+					jsonVal.AddMember("Type ID", typeVal, allocator);
+				}
+			});
+
+		// every part adds its members to the same object
+		rapidjson::Value dataVal{ rapidjson::kObjectType };
+		ForEachPolymorphicPart(dynamicType.GetInfo(), data, [&dataVal, &allocator](const TypeInfo& info, void* part)
+			{
+				info.JSonSerializer(dataVal, part, allocator);
+			});
+		jsonVal.AddMember("Data", dataVal, allocator);
+	}
+
+#ifdef GLAS_STORAGE
+	template <typename T>
+	T* DeserializeJSonPolymorphic(rapidjson::Value& jsonVal) requires std::is_polymorphic_v<T>
+	{
+		if (jsonVal.IsNull())
+			return nullptr;
+
+		const auto indexVal = jsonVal.FindMember("Type Index");
+		const auto typeVal = jsonVal.FindMember("Type ID");
+		const auto dataVal = jsonVal.FindMember("Data");
+		if (indexVal == jsonVal.MemberEnd() || dataVal == jsonVal.MemberEnd() || !indexVal->value.IsUint())
+			return nullptr;
+
+		const TypeInfo* info = WithPolymorphicTypeTable([&](PolymorphicTypeTable& table) -> const TypeInfo*
+			{
+				const uint32_t index = indexVal->value.GetUint();
+				if (!table.IsNewIndex(index))
+					return table.GetType(index);
+
+				if (typeVal == jsonVal.MemberEnd() || !typeVal->value.IsUint64())
+					return nullptr;
+
+				TypeId type{};
+				JSonSerializer<TypeId>::Deserialize(typeVal->value, type);
+				return table.AddType(type);
+			});
+
+		// the document can reference any registered type, not only the types that derive from T
+		if (!CanConstructPolymorphic<T>(info))
+			return nullptr;
+
+		// owned until every part has been read, so that a throwing deserializer does not leak the instance
+		std::unique_ptr<T> instance{ ConstructPolymorphic<T>(*info) };
+		ForEachPolymorphicPart(*info, DownCast(instance.get(), TypeId::Create<T>().GetInfo(), *info), [&dataVal](const TypeInfo& partInfo, void* part)
+			{
+				partInfo.JSonDeserializer(dataVal->value, part);
+			});
+		return instance.release();
+	}
+#endif
+
 	/** FLOAT */
 	inline void JSonSerializer<float>::Serialize(rapidjson::Value& jsonVal, const float& value, RapidJsonAllocator&)
 	{
@@ -388,7 +467,7 @@ namespace glas::Serialization
 			++counter;
 		}
 	}
-#ifdef _STRING_
+#if defined(_STRING_) || defined(_GLIBCXX_STRING)
 	/** STRING */
 	template <typename Elem, typename Traits, typename Alloc>
 	void JSonSerializer<std::basic_string<Elem, Traits, Alloc>>::Serialize(rapidjson::Value& jsonVal,
@@ -404,7 +483,7 @@ namespace glas::Serialization
 		value = jsonVal.GetString();
 	}
 #endif
-#ifdef _VECTOR_
+#if defined(_VECTOR_) || defined(_GLIBCXX_VECTOR)
 	/** VECTOR */
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::vector<T, Alloc>>::Serialize(rapidjson::Value& jsonVal, const std::vector<T, Alloc>& value,
@@ -416,10 +495,10 @@ namespace glas::Serialization
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::vector<T, Alloc>>::Deserialize(rapidjson::Value& jsonVal, std::vector<T, Alloc>& value)
 	{
-		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_back(element); });
+		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_back(std::move(element)); });
 	}
 #endif
-#ifdef _ARRAY_
+#if defined(_ARRAY_) || defined(_GLIBCXX_ARRAY)
 	/** ARRAY */
 	template <typename T, size_t Size>
 	void JSonSerializer<std::array<T, Size>>::Serialize(rapidjson::Value& jsonVal, const std::array<T, Size>& value,
@@ -439,7 +518,7 @@ namespace glas::Serialization
 		}
 	}
 #endif
-#ifdef _DEQUE_
+#if defined(_DEQUE_) || defined(_GLIBCXX_DEQUE)
 	/** DEQUE*/
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::deque<T, Alloc>>::Serialize(rapidjson::Value& jsonVal, const std::deque<T, Alloc>& value,
@@ -451,10 +530,10 @@ namespace glas::Serialization
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::deque<T, Alloc>>::Deserialize(rapidjson::Value& jsonVal, std::deque<T, Alloc>& value)
 	{
-		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_back(element); });
+		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_back(std::move(element)); });
 	}
 #endif
-#ifdef _FORWARD_LIST_
+#if defined(_FORWARD_LIST_) || defined(_GLIBCXX_FORWARD_LIST)
 	/** FORWARD LIST */
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::forward_list<T, Alloc>>::Serialize(rapidjson::Value& jsonVal,
@@ -467,10 +546,10 @@ namespace glas::Serialization
 	void JSonSerializer<std::forward_list<T, Alloc>>::Deserialize(rapidjson::Value& jsonVal,
 		std::forward_list<T, Alloc>& value)
 	{
-		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_front(element); });
+		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_front(std::move(element)); });
 	}
 #endif
-#ifdef _LIST_
+#if defined(_LIST_) || defined(_GLIBCXX_LIST)
 	/** LIST */
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::list<T, Alloc>>::Serialize(rapidjson::Value& jsonVal, const std::list<T, Alloc>& value,
@@ -482,10 +561,10 @@ namespace glas::Serialization
 	template <typename T, typename Alloc>
 	void JSonSerializer<std::list<T, Alloc>>::Deserialize(rapidjson::Value& jsonVal, std::list<T, Alloc>& value)
 	{
-		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_back(element); });
+		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.push_back(std::move(element)); });
 	}
 #endif
-#ifdef _SET_
+#if defined(_SET_) || defined(_GLIBCXX_SET)
 	/** UNORDERED SET */
 	template <typename T, typename Hasher, typename Keyeq, typename Alloc>
 	void JSonSerializer<std::unordered_set<T, Hasher, Keyeq, Alloc>>::Serialize(rapidjson::Value& jsonVal,
@@ -498,7 +577,7 @@ namespace glas::Serialization
 	void JSonSerializer<std::unordered_set<T, Hasher, Keyeq, Alloc>>::Deserialize(rapidjson::Value& jsonVal,
 		std::unordered_set<T, Hasher, Keyeq, Alloc>& value)
 	{
-		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.insert(element); });
+		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.insert(std::move(element)); });
 	}
 
 	template <typename T, typename Hasher, typename Keyeq, typename Alloc>
@@ -512,10 +591,10 @@ namespace glas::Serialization
 	void JSonSerializer<std::unordered_multiset<T, Hasher, Keyeq, Alloc>>::Deserialize(rapidjson::Value& jsonVal,
 		std::unordered_multiset<T, Hasher, Keyeq, Alloc>& value)
 	{
-		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.insert(element); });
+		DeserializeJSonContainer<T>(jsonVal, [&value](T& element) { value.insert(std::move(element)); });
 	}
 #endif
-#ifdef _MAP_
+#if defined(_MAP_) || defined(_GLIBCXX_MAP)
 	/** MAP */
 	template <typename Key, typename Value, typename P, typename Alloc>
 	void JSonSerializer<std::map<Key, Value, P, Alloc>>::Serialize(rapidjson::Value& jsonVal,
@@ -528,7 +607,7 @@ namespace glas::Serialization
 	void JSonSerializer<std::map<Key, Value, P, Alloc>>::Deserialize(rapidjson::Value& jsonVal,
 		std::map<Key, Value, P, Alloc>& value)
 	{
-		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(element); });
+		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(std::move(element)); });
 	}
 
 	template <typename Key, typename Value, typename P, typename Alloc>
@@ -542,10 +621,10 @@ namespace glas::Serialization
 	void JSonSerializer<std::multimap<Key, Value, P, Alloc>>::Deserialize(rapidjson::Value& jsonVal,
 		std::multimap<Key, Value, P, Alloc>& value)
 	{
-		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(element); });
+		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(std::move(element)); });
 	}
 #endif
-#ifdef _UNORDERED_MAP_
+#if defined(_UNORDERED_MAP_) || defined(_GLIBCXX_UNORDERED_MAP)
 	/** UNORDERED MAP */
 	template <typename Key, typename Value, typename Hasher, typename Keyeq, typename Alloc>
 	void JSonSerializer<std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>>::Serialize(rapidjson::Value& jsonVal,
@@ -558,7 +637,7 @@ namespace glas::Serialization
 	void JSonSerializer<std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>>::Deserialize(rapidjson::Value& jsonVal,
 		std::unordered_map<Key, Value, Hasher, Keyeq, Alloc>& value)
 	{
-		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(element); });
+		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(std::move(element)); });
 	}
 
 	template <typename Key, typename Value, typename Hasher, typename Keyeq, typename Alloc>
@@ -572,22 +651,27 @@ namespace glas::Serialization
 	void JSonSerializer<std::unordered_multimap<Key, Value, Hasher, Keyeq, Alloc>>::Deserialize(
 		rapidjson::Value& jsonVal, std::unordered_multimap<Key, Value, Hasher, Keyeq, Alloc>& value)
 	{
-		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(element); });
+		DeserializeJSonContainer<std::pair<Key, Value>>(jsonVal, [&value](std::pair<Key, Value>& element) { value.insert(std::move(element)); });
 	}
 #endif
-#ifdef _MEMORY_
+#if defined(_MEMORY_) || defined(_GLIBCXX_MEMORY)
 	/** UNIQUE PTR */
 	template <typename T, typename Delete>
 	void JSonSerializer<std::unique_ptr<T, Delete>>::Serialize(rapidjson::Value& jsonVal,
 		const std::unique_ptr<T, Delete>& value, RapidJsonAllocator& allocator)
 	{
-		if (value)
+		if constexpr (std::is_polymorphic_v<T>)
+		{
+			SerializeJSonPolymorphic(jsonVal, value.get(), allocator);
+		}
+		else if (value)
 		{
 			rapidjson::Value ownedVal{ rapidjson::kObjectType };
 
-			SerializeJSon(jsonVal, *value, allocator);
+			SerializeJSon(ownedVal, *value, allocator);
 
-			ownedVal.AddMember("Value", ownedVal, allocator);
+			jsonVal.SetObject();
+			jsonVal.AddMember("Value", ownedVal, allocator);
 		}
 		else
 		{
@@ -599,14 +683,25 @@ namespace glas::Serialization
 	void JSonSerializer<std::unique_ptr<T, Delete>>::Deserialize(rapidjson::Value& jsonVal,
 		std::unique_ptr<T, Delete>& value)
 	{
+#ifdef GLAS_STORAGE
+		if constexpr (std::is_polymorphic_v<T>)
+		{
+			value.reset(DeserializeJSonPolymorphic<T>(jsonVal));
+			return;
+		}
+#endif
 		if (!jsonVal.IsNull())
 		{
 			value = std::make_unique<T>();
 			DeserializeJSon(jsonVal["Value"], *value);
 		}
+		else
+		{
+			value.reset();
+		}
 	}
 #endif
-#ifdef _OPTIONAL_
+#if defined(_OPTIONAL_) || defined(_GLIBCXX_OPTIONAL)
 	/** OPTIONAL */
 	template <typename T>
 	void JSonSerializer<std::optional<T>>::Serialize(rapidjson::Value& jsonVal, const std::optional<T>& value,
@@ -636,7 +731,7 @@ namespace glas::Serialization
 		}
 	}
 #endif
-#ifdef _UTILITY_
+#if defined(_UTILITY_) || defined(_GLIBCXX_UTILITY)
 	/** PAIR */
 	template <typename T1, typename T2>
 	void JSonSerializer<std::pair<T1, T2>>::Serialize(rapidjson::Value& jsonVal, const std::pair<T1, T2>& value,
@@ -0,0 +1,213 @@
+#pragma once
+
+#if defined(GLAS_SERIALIZATION_BINARY) || defined(GLAS_SERIALIZATION_JSON) || defined(GLAS_SERIALIZATION_YAML)
+
+#include <new>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+
+#include "../glas_decl.h"
+
+namespace glas::Serialization
+{
+	/**
+	 * Table of the dynamic types of the polymorphic objects inside of a single serialized stream or document.
+	 * Every type gets a dense index the first time it is written, only that first reference also contains the full TypeId.
+	 * The reader builds the same table while reading, so it resolves every type only once.
+	 * @see PolymorphicScope
+	 */
+	class PolymorphicTypeTable final
+	{
+	public:
+		/** Index that is written for null pointers. */
+		static constexpr uint32_t NullIndex = 0;
+
+		/**
+		 * Get the index that references the type.
+		 * @param isNew is set to true when this is the first reference to the type, the TypeId must then be written as well.
+		 */
+		uint32_t			WriteType		(TypeId type, bool& isNew);
+
+		/** Returns true if the index references a type that has not been read before, its TypeId must then be read as well. */
+		bool				IsNewIndex		(uint32_t index)	const	{ return index == m_Types.size() + 1; }
+
+		/** Adds the type of a new index to the table. */
+		const TypeInfo*		AddType			(TypeId type);
+
+		/** @returns the type of the index, or nullptr for unknown indices and NullIndex. */
+		const TypeInfo*		GetType			(uint32_t index)	const	{ return index != NullIndex && index <= m_Types.size() ? m_Types[index - 1] : nullptr; }
+
+	private:
+		std::unordered_map<uint64_t, uint32_t>	m_Indices	{ }; /**< Indices of the written types*/
+		std::vector<const TypeInfo*>			m_Types		{ }; /**< Types of the read indices*/
+	};
+
+	/**
+	 * Shares a single PolymorphicTypeTable between all polymorphic objects that are serialized on this thread while the scope is alive.
+	 * Without a scope every polymorphic object contains its full TypeId.
+	 * Objects that were written inside of a scope must also be read inside of a scope.
+	 */
+	class PolymorphicScope final
+	{
+	public:
+		PolymorphicScope();
+		~PolymorphicScope();
+
+		PolymorphicScope(const PolymorphicScope&) = delete;
+		PolymorphicScope(PolymorphicScope&&) noexcept = delete;
+		PolymorphicScope& operator=(const PolymorphicScope&) = delete;
+		PolymorphicScope& operator=(PolymorphicScope&&) noexcept = delete;
+
+		PolymorphicTypeTable&		GetTable	()	{ return m_Table; }
+
+		/** @returns the innermost scope of this thread, or nullptr. */
+		static PolymorphicScope*	GetCurrent	();
+
+	private:
+		static PolymorphicScope*&	GetCurrentRef	();
+
+		PolymorphicTypeTable	m_Table		{ };
+		PolymorphicScope*		m_Previous	{ };
+	};
+
+	/** Calls the function with the type table of the current scope, or with a temporary table when no scope is active. */
+	template <typename Function>
+	decltype(auto) WithPolymorphicTypeTable(Function&& function)
+	{
+		if (PolymorphicScope* scope = PolymorphicScope::GetCurrent())
+			return function(scope->GetTable());
+
+		PolymorphicScope scope{};
+		return function(scope.GetTable());
+	}
+
+	/**
+	 * Resolves the dynamic type of the polymorphic instance.
+	 * Falls back to the static type when the dynamic type has not been registered.
+	 * @returns the address of the instance of the dynamic type.
+	 */
+	template <typename T>
+	void* GetDynamicInstance(const T* instance, TypeId& dynamicType) requires std::is_polymorphic_v<T>
+	{
+		dynamicType = GetTypeIDFromPolymorphic(instance);
+
+		if (!dynamicType.IsValid())
+		{
+			dynamicType = TypeId::Create<T>();
+			return const_cast<T*>(instance);
+		}
+
+		return DownCast(const_cast<T*>(instance), TypeId::Create<T>(), dynamicType);
+	}
+
+	/**
+	 * Calls the function for every registered base class of the type, recursively and in declaration order, followed by the type itself.
+	 * The default serializers only handle the members of their own type, so polymorphic objects are serialized part by part.
+	 * @param function is called with the TypeInfo and the address of every part.
+	 */
+	template <typename Function>
+	void ForEachPolymorphicPart(const TypeInfo& info, void* data, Function&& function)
+	{
+		for (const BaseClassInfo& base : info.BaseClasses)
+		{
+			ForEachPolymorphicPart(base.BaseId.GetInfo(), VoidOffset(data, base.ClassOffset), function);
+		}
+
+		function(info, data);
+	}
+
+#ifdef GLAS_STORAGE
+	/**
+	 * Checks if a type that was read from untrusted input can be constructed by ConstructPolymorphic<T>.
+	 * @returns false for null, unrelated, non default constructible and over aligned types.
+	 */
+	template <typename T>
+	bool CanConstructPolymorphic(const TypeInfo* dynamicInfo) requires std::is_polymorphic_v<T>
+	{
+		return dynamicInfo
+			&& dynamicInfo->Constructor
+			&& dynamicInfo->Align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__
+			&& IsA(*dynamicInfo, TypeId::Create<T>().GetInfo());
+	}
+
+	/**
+	 * Default constructs an instance of the dynamic type on the heap using TypeInfo::Constructor.
+	 * @returns pointer to the T base of the instance, that can be deleted through T.
+	 */
+	template <typename T>
+	T* ConstructPolymorphic(const TypeInfo& dynamicInfo) requires std::is_polymorphic_v<T>
+	{
+		const TypeInfo& staticInfo = TypeId::Create<T>().GetInfo();
+
+		assert(dynamicInfo.Constructor);
+		assert(dynamicInfo.Align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+		assert(IsA(dynamicInfo, staticInfo));
+
+		// allocated with the regular operator new, so that deleting through a virtual destructor frees it correctly
+		void* data = ::operator new(dynamicInfo.Size);
+		try
+		{
+			dynamicInfo.Constructor(data);
+		}
+		catch (...)
+		{
+			::operator delete(data);
+			throw;
+		}
+
+		return static_cast<T*>(UpCast(data, dynamicInfo, staticInfo));
+	}
+#endif
+
+	/**
+	 * POLYMORPHIC TYPE TABLE
+	 */
+
+	inline uint32_t PolymorphicTypeTable::WriteType(TypeId type, bool& isNew)
+	{
+		const auto [it, inserted] = m_Indices.emplace(type.GetId(), static_cast<uint32_t>(m_Indices.size() + 1));
+		isNew = inserted;
+		return it->second;
+	}
+
+	inline const TypeInfo* PolymorphicTypeTable::AddType(TypeId type)
+	{
+		const auto& typeInfoMap = GetAllTypeInfo();
+		const auto it = typeInfoMap.find(type);
+		const TypeInfo* info = it != typeInfoMap.end() ? &it->second : nullptr;
+
+		m_Types.emplace_back(info);
+		return info;
+	}
+
+	/**
+	 * POLYMORPHIC SCOPE
+	 */
+
+	inline PolymorphicScope::PolymorphicScope()
+		: m_Previous{ GetCurrentRef() }
+	{
+		GetCurrentRef() = this;
+	}
+
+	inline PolymorphicScope::~PolymorphicScope()
+	{
+		GetCurrentRef() = m_Previous;
+	}
+
+	inline PolymorphicScope* PolymorphicScope::GetCurrent()
+	{
+		return GetCurrentRef();
+	}
+
+	inline PolymorphicScope*& PolymorphicScope::GetCurrentRef()
+	{
+		thread_local PolymorphicScope* current{};
+		return current;
+	}
+}
+
+#endif
@@ -97,6 +97,78 @@ namespace glas::Serialization
 		return true;
 	}
 
+	template <typename T>
+	YAML::Node SerializeYamlPolymorphic(const T* instance) requires std::is_polymorphic_v<T>
+	{
+		if (!instance)
+			return YAML::Node{ YAML::NodeType::Null };
+
+		TypeId dynamicType{};
+		void* data = GetDynamicInstance(instance, dynamicType);
+
+		YAML::Node node{ YAML::NodeType::Map };
+
+		WithPolymorphicTypeTable([&](PolymorphicTypeTable& table)
+			{
+				bool isNew{};
+				node["Type Index"] = table.WriteType(dynamicType, isNew);
+				if (isNew)
+					node["Type ID"] = dynamicType.GetId();
+			});
+
+		// every part adds its members to the same map
+		YAML::Node dataNode{ YAML::NodeType::Map };
+		ForEachPolymorphicPart(dynamicType.GetInfo(), data, [&dataNode](const TypeInfo& info, void* part)
+			{
+				const YAML::Node partNode = info.YamlSerializer(part);
+				for (const auto& member : partNode)
+				{
+					dataNode[member.first] = member.second;
+				}
+			});
+		node["Data"] = dataNode;
+
+		return node;
+	}
+
+#ifdef GLAS_STORAGE
+	template <typename T>
+	T* DeserializeYamlPolymorphic(const YAML::Node& node) requires std::is_polymorphic_v<T>
+	{
+		if (!node.IsMap())
+			return nullptr;
+
+		const YAML::Node indexNode = node["Type Index"];
+		const YAML::Node dataNode = node["Data"];
+		if (!indexNode || !dataNode)
+			return nullptr;
+
+		const TypeInfo* info = WithPolymorphicTypeTable([&](PolymorphicTypeTable& table) -> const TypeInfo*
+			{
+				const uint32_t index = indexNode.as<uint32_t>();
+				if (!table.IsNewIndex(index))
+					return table.GetType(index);
+
+				const YAML::Node typeNode = node["Type ID"];
+				if (!typeNode)
+					return nullptr;
+
+				return table.AddType(TypeId{ typeNode.as<uint64_t>() });
+			});
+
+		// the document can reference any registered type, not only the types that derive from T
+		if (!CanConstructPolymorphic<T>(info))
+			return nullptr;
+
+		// owned until every part has been read, so that a throwing deserializer does not leak the instance
+		std::unique_ptr<T> instance{ ConstructPolymorphic<T>(*info) };
+		ForEachPolymorphicPart(*info, DownCast(instance.get(), TypeId::Create<T>().GetInfo(), *info), [&dataNode](const TypeInfo& partInfo, void* part)
+			{
+				partInfo.YamlDeserializer(dataNode, part);
+			});
+		return instance.release();
+	}
+#endif
 }
 
 namespace YAML
@@ -112,6 +184,35 @@ namespace YAML
 	{
 		return glas::Serialization::DeserializeYamlDefault(node, &value, glas::TypeId::Create<T>());
 	}
+
+	template <typename T, typename Delete>
+	Node convert<std::unique_ptr<T, Delete>>::encode(const std::unique_ptr<T, Delete>& value)
+	{
+		if constexpr (std::is_polymorphic_v<T>)
+			return glas::Serialization::SerializeYamlPolymorphic(value.get());
+		else
+			return value ? Node{ *value } : Node{ NodeType::Null };
+	}
+
+	template <typename T, typename Delete>
+	bool convert<std::unique_ptr<T, Delete>>::decode(const Node& node, std::unique_ptr<T, Delete>& value)
+	{
+#ifdef GLAS_STORAGE
+		if constexpr (std::is_polymorphic_v<T>)
+		{
+			value.reset(glas::Serialization::DeserializeYamlPolymorphic<T>(node));
+			return true;
+		}
+#endif
+		if (node.IsNull())
+		{
+			value.reset();
+			return true;
+		}
+
+		value = std::make_unique<T>();
+		return convert<T>::decode(node, *value);
+	}
 }
 
 #endif
\ No newline at end of file
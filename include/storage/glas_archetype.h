@@ -0,0 +1,471 @@
+#pragma once
+
+#ifdef GLAS_STORAGE
+
+#include <new>
+#include <span>
+#include <array>
+#include <tuple>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "../glas_decl.h"
+#include "glas_storage_config.h"
+#include "glas_archetype_config.h"
+
+namespace glas::Storage
+{
+	/**
+	 * ARCHETYPE
+	 */
+
+	inline Archetype::Archetype(std::span<const TypeId> types, std::pmr::memory_resource* resource)
+		: m_Types{ types.begin(), types.end() }
+		, m_Resource{ resource }
+	{
+		size_t rowSize{ sizeof(Entity) };
+		m_ChunkAlign = std::max<size_t>(GLAS_STORAGE_CHUNK_ALIGN, alignof(Entity));
+
+		m_Infos.reserve(m_Types.size());
+		for (const TypeId type : m_Types)
+		{
+			const TypeInfo& info = type.GetInfo();
+			assert(info.MoveConstructor && "Components must be move constructible");
+
+			m_Infos.emplace_back(&info);
+			rowSize += info.Size;
+			m_ChunkAlign = std::max<size_t>(m_ChunkAlign, info.Align);
+		}
+
+		// every column can be padded up to the alignment of the chunk
+		const size_t padding = m_Types.size() * m_ChunkAlign;
+		m_ChunkCapacity = GLAS_STORAGE_CHUNK_SIZE > padding + rowSize ? (GLAS_STORAGE_CHUNK_SIZE - padding) / rowSize : 1;
+
+		// the entities are stored in front of the columns
+		size_t offset{ m_ChunkCapacity * sizeof(Entity) };
+		m_ColumnOffsets.reserve(m_Types.size());
+		for (const TypeInfo* info : m_Infos)
+		{
+			const size_t align = std::max<size_t>(GLAS_STORAGE_CHUNK_ALIGN, info->Align);
+			offset = (offset + align - 1) / align * align;
+			m_ColumnOffsets.emplace_back(offset);
+			offset += m_ChunkCapacity * info->Size;
+		}
+		m_ChunkSize = offset;
+	}
+
+	inline Archetype::~Archetype()
+	{
+		for (size_t column{}; column < m_Infos.size(); ++column)
+		{
+			const auto destructor = m_Infos[column]->DestructN;
+			if (!destructor)
+				continue;
+
+			for (size_t chunk{}; chunk < m_Chunks.size(); ++chunk)
+			{
+				destructor(GetColumnData(chunk, column), GetChunkSize(chunk));
+			}
+		}
+	}
+
+	inline size_t Archetype::GetColumn(TypeId type) const
+	{
+		const auto it = std::ranges::lower_bound(m_Types, type.GetId(), {}, &TypeId::GetId);
+		return it != m_Types.end() && it->GetId() == type.GetId() ? static_cast<size_t>(it - m_Types.begin()) : InvalidColumn;
+	}
+
+	inline bool Archetype::HasTypes(std::span<const TypeId> sortedTypes) const
+	{
+		return std::ranges::includes(m_Types, sortedTypes, {}, &TypeId::GetId, &TypeId::GetId);
+	}
+
+	inline size_t Archetype::GetChunkSize(size_t chunk) const
+	{
+		// chunks are kept when rows are removed, so trailing chunks can be empty
+		const size_t begin = chunk * m_ChunkCapacity;
+		return begin < m_Size ? std::min(m_ChunkCapacity, m_Size - begin) : 0;
+	}
+
+	inline void* Archetype::GetAddress(size_t column, size_t row) const
+	{
+		assert(column < m_Types.size() && row < m_Size);
+		return m_Chunks[row / m_ChunkCapacity].Get() + m_ColumnOffsets[column] + row % m_ChunkCapacity * m_Infos[column]->Size;
+	}
+
+	inline size_t Archetype::AddRow(Entity entity)
+	{
+		if (m_Size == m_Chunks.size() * m_ChunkCapacity)
+			m_Chunks.emplace_back(m_ChunkSize, m_ChunkAlign, m_Resource);
+
+		GetEntities(m_Size / m_ChunkCapacity)[m_Size % m_ChunkCapacity] = entity;
+		return m_Size++;
+	}
+
+	inline Entity Archetype::RemoveRow(size_t row)
+	{
+		assert(row < m_Size);
+
+		const size_t last = m_Size - 1;
+		Entity moved{};
+
+		if (row != last)
+		{
+			for (size_t column{}; column < m_Infos.size(); ++column)
+			{
+				Relocate(*m_Infos[column], GetAddress(column, row), GetAddress(column, last));
+			}
+
+			moved = GetEntities(last / m_ChunkCapacity)[last % m_ChunkCapacity];
+			GetEntities(row / m_ChunkCapacity)[row % m_ChunkCapacity] = moved;
+		}
+
+		--m_Size;
+		return moved;
+	}
+
+	inline void Archetype::DestroyRow(size_t row)
+	{
+		for (size_t column{}; column < m_Infos.size(); ++column)
+		{
+			if (m_Infos[column]->Destructor)
+				m_Infos[column]->Destructor(GetAddress(column, row));
+		}
+	}
+
+	inline void Archetype::Relocate(const TypeInfo& info, void* destination, void* source)
+	{
+		if (info.TriviallyRelocatable)
+		{
+			std::memcpy(destination, source, info.Size);
+			return;
+		}
+
+		info.MoveConstructor(destination, source);
+		if (info.Destructor)
+			info.Destructor(source);
+	}
+
+	/**
+	 * ARCHETYPE STORAGE
+	 */
+
+	inline ArchetypeStorage::ArchetypeStorage(std::pmr::memory_resource* resource)
+		: m_Resource{ resource }
+	{
+		// entities without components
+		m_Archetypes.emplace_back(std::span<const TypeId>{}, m_Resource);
+	}
+
+	inline Entity ArchetypeStorage::Create(std::span<const TypeId> types)
+	{
+		std::vector<TypeId> sortedTypes{ types.begin(), types.end() };
+		SortTypes(sortedTypes);
+
+		const uint32_t archetypeIndex = FindArchetype(sortedTypes);
+		Archetype& archetype = m_Archetypes[archetypeIndex];
+
+		const Entity entity = AllocateEntity();
+		const size_t row = archetype.AddRow(entity);
+
+		size_t column{};
+		try
+		{
+			for (; column < archetype.m_Infos.size(); ++column)
+			{
+				assert(archetype.m_Infos[column]->Constructor);
+				archetype.m_Infos[column]->Constructor(archetype.GetAddress(column, row));
+			}
+		}
+		catch (...)
+		{
+			for (size_t i{}; i < column; ++i)
+			{
+				if (archetype.m_Infos[i]->Destructor)
+					archetype.m_Infos[i]->Destructor(archetype.GetAddress(i, row));
+			}
+			archetype.RemoveRow(row);
+			m_FreeEntities.emplace_back(entity.Index);
+			throw;
+		}
+
+		m_Entities[entity.Index].ArchetypeIndex = archetypeIndex;
+		m_Entities[entity.Index].Row = row;
+		++m_EntityCount;
+		return entity;
+	}
+
+	template <typename... Components>
+	Entity ArchetypeStorage::Create(Components&&... components) requires (sizeof...(Components) > 0 && !(std::is_convertible_v<Components, std::span<const TypeId>> || ...))
+	{
+		std::vector<TypeId> sortedTypes{ TypeId::Create<std::remove_cvref_t<Components>>()... };
+		SortTypes(sortedTypes);
+
+		const uint32_t archetypeIndex = FindArchetype(sortedTypes);
+		Archetype& archetype = m_Archetypes[archetypeIndex];
+
+		const std::array<size_t, sizeof...(Components)> columns{ archetype.GetColumn(TypeId::Create<std::remove_cvref_t<Components>>())... };
+
+		const Entity entity = AllocateEntity();
+		const size_t row = archetype.AddRow(entity);
+
+		size_t constructed{};
+		try
+		{
+			((new (archetype.GetAddress(columns[constructed], row)) std::remove_cvref_t<Components>(std::forward<Components>(components)), ++constructed), ...);
+		}
+		catch (...)
+		{
+			for (size_t i{}; i < constructed; ++i)
+			{
+				if (archetype.m_Infos[columns[i]]->Destructor)
+					archetype.m_Infos[columns[i]]->Destructor(archetype.GetAddress(columns[i], row));
+			}
+			archetype.RemoveRow(row);
+			m_FreeEntities.emplace_back(entity.Index);
+			throw;
+		}
+
+		m_Entities[entity.Index].ArchetypeIndex = archetypeIndex;
+		m_Entities[entity.Index].Row = row;
+		++m_EntityCount;
+		return entity;
+	}
+
+	inline void ArchetypeStorage::Destroy(Entity entity)
+	{
+		EntityRecord& record = GetRecord(entity);
+		Archetype& archetype = m_Archetypes[record.ArchetypeIndex];
+
+		archetype.DestroyRow(record.Row);
+		const Entity moved = archetype.RemoveRow(record.Row);
+		if (moved.IsValid())
+			m_Entities[moved.Index].Row = record.Row;
+
+		// handles of the destroyed entity are no longer alive
+		++record.Generation;
+		m_FreeEntities.emplace_back(entity.Index);
+		--m_EntityCount;
+	}
+
+	inline bool ArchetypeStorage::IsAlive(Entity entity) const
+	{
+		return entity.Index < m_Entities.size() && m_Entities[entity.Index].Generation == entity.Generation;
+	}
+
+	inline void* ArchetypeStorage::AddComponent(Entity entity, TypeId type)
+	{
+		const TypeInfo& info = type.GetInfo();
+		assert(info.Constructor);
+
+		return ConstructComponent(entity, type, [&info](void* data) { info.Constructor(data); });
+	}
+
+	template <typename T, typename... Arguments>
+	T& ArchetypeStorage::AddComponent(Entity entity, Arguments&&... arguments)
+	{
+		return *static_cast<T*>(ConstructComponent(entity, TypeId::Create<T>(), [&arguments...](void* data) { new (data) T(std::forward<Arguments>(arguments)...); }));
+	}
+
+	template <typename Function>
+	void* ArchetypeStorage::ConstructComponent(Entity entity, TypeId type, Function&& constructor)
+	{
+		assert(!HasComponent(entity, type) && "The entity already has a component of the type");
+
+		const uint32_t target = GetAddTarget(GetRecord(entity).ArchetypeIndex, type);
+		Archetype& targetArchetype = m_Archetypes[target];
+
+		// the new component is constructed first, so a throwing constructor leaves the entity unchanged
+		const size_t row = targetArchetype.AddRow(entity);
+		void* component = targetArchetype.GetAddress(targetArchetype.GetColumn(type), row);
+		try
+		{
+			constructor(component);
+		}
+		catch (...)
+		{
+			targetArchetype.RemoveRow(row);
+			throw;
+		}
+
+		MoveEntity(entity, target, row);
+		return component;
+	}
+
+	inline void ArchetypeStorage::RemoveComponent(Entity entity, TypeId type)
+	{
+		assert(HasComponent(entity, type) && "The entity does not have a component of the type");
+
+		const uint32_t target = GetRemoveTarget(GetRecord(entity).ArchetypeIndex, type);
+		const size_t row = m_Archetypes[target].AddRow(entity);
+
+		MoveEntity(entity, target, row);
+	}
+
+	inline bool ArchetypeStorage::HasComponent(Entity entity, TypeId type) const
+	{
+		assert(IsAlive(entity));
+		return m_Archetypes[m_Entities[entity.Index].ArchetypeIndex].GetColumn(type) != Archetype::InvalidColumn;
+	}
+
+	inline void* ArchetypeStorage::GetComponent(Entity entity, TypeId type)
+	{
+		const EntityRecord& record = GetRecord(entity);
+		const Archetype& archetype = m_Archetypes[record.ArchetypeIndex];
+
+		const size_t column = archetype.GetColumn(type);
+		return column != Archetype::InvalidColumn ? archetype.GetAddress(column, record.Row) : nullptr;
+	}
+
+	template <typename Function>
+	void ArchetypeStorage::Query(std::span<const TypeId> types, Function&& function)
+	{
+		std::vector<TypeId> sortedTypes{ types.begin(), types.end() };
+		SortTypes(sortedTypes);
+
+		for (Archetype& archetype : m_Archetypes)
+		{
+			if (archetype.Size() && archetype.HasTypes(sortedTypes))
+				function(archetype);
+		}
+	}
+
+	template <typename... Components, typename Function>
+	void ArchetypeStorage::ForEach(Function&& function)
+	{
+		const std::array<TypeId, sizeof...(Components)> types{ TypeId::Create<Components>()... };
+
+		Query(types, [&function](Archetype& archetype)
+			{
+				// the columns are resolved once per archetype, the rows of a chunk are then read linearly
+				const std::array<size_t, sizeof...(Components)> columns{ archetype.GetColumn(TypeId::Create<Components>())... };
+
+				[&]<size_t... Indices>(std::index_sequence<Indices...>)
+				{
+					for (size_t chunk{}; chunk < archetype.GetChunkCount(); ++chunk)
+					{
+						const size_t size = archetype.GetChunkSize(chunk);
+						const Entity* entities = archetype.GetEntities(chunk);
+						const std::tuple<Components*...> componentColumns{ static_cast<Components*>(archetype.GetColumnData(chunk, columns[Indices]))... };
+
+						for (size_t row{}; row < size; ++row)
+						{
+							function(entities[row], std::get<Indices>(componentColumns)[row]...);
+						}
+					}
+				} (std::index_sequence_for<Components...>{});
+			});
+	}
+
+	inline ArchetypeStorage::EntityRecord& ArchetypeStorage::GetRecord(Entity entity)
+	{
+		assert(IsAlive(entity) && "The entity has been destroyed");
+		return m_Entities[entity.Index];
+	}
+
+	inline Entity ArchetypeStorage::AllocateEntity()
+	{
+		if (!m_FreeEntities.empty())
+		{
+			const uint32_t index = m_FreeEntities.back();
+			m_FreeEntities.pop_back();
+			return { index, m_Entities[index].Generation };
+		}
+
+		assert(m_Entities.size() < Entity::InvalidIndex);
+		m_Entities.emplace_back();
+		return { static_cast<uint32_t>(m_Entities.size() - 1), 0 };
+	}
+
+	inline uint32_t ArchetypeStorage::FindArchetype(std::vector<TypeId>& sortedTypes)
+	{
+		for (size_t i{}; i < m_Archetypes.size(); ++i)
+		{
+			if (std::ranges::equal(m_Archetypes[i].m_Types, sortedTypes, {}, &TypeId::GetId, &TypeId::GetId))
+				return static_cast<uint32_t>(i);
+		}
+
+		m_Archetypes.emplace_back(sortedTypes, m_Resource);
+		return static_cast<uint32_t>(m_Archetypes.size() - 1);
+	}
+
+	inline uint32_t ArchetypeStorage::GetAddTarget(uint32_t archetype, TypeId type)
+	{
+		const auto it = m_Archetypes[archetype].m_AddEdges.find(type.GetId());
+		if (it != m_Archetypes[archetype].m_AddEdges.end())
+			return it->second;
+
+		std::vector<TypeId> types{ m_Archetypes[archetype].m_Types };
+		types.emplace_back(type);
+		SortTypes(types);
+
+		// finding the archetype can add archetypes, which moves the existing ones
+		const uint32_t target = FindArchetype(types);
+		m_Archetypes[archetype].m_AddEdges.emplace(type.GetId(), target);
+		m_Archetypes[target].m_RemoveEdges.emplace(type.GetId(), archetype);
+		return target;
+	}
+
+	inline uint32_t ArchetypeStorage::GetRemoveTarget(uint32_t archetype, TypeId type)
+	{
+		const auto it = m_Archetypes[archetype].m_RemoveEdges.find(type.GetId());
+		if (it != m_Archetypes[archetype].m_RemoveEdges.end())
+			return it->second;
+
+		std::vector<TypeId> types{ m_Archetypes[archetype].m_Types };
+		std::erase_if(types, [type](TypeId other) { return other.GetId() == type.GetId(); });
+
+		// finding the archetype can add archetypes, which moves the existing ones
+		const uint32_t target = FindArchetype(types);
+		m_Archetypes[archetype].m_RemoveEdges.emplace(type.GetId(), target);
+		m_Archetypes[target].m_AddEdges.emplace(type.GetId(), archetype);
+		return target;
+	}
+
+	inline void ArchetypeStorage::MoveEntity(Entity entity, uint32_t target, size_t targetRow)
+	{
+		EntityRecord& record = m_Entities[entity.Index];
+		Archetype& source = m_Archetypes[record.ArchetypeIndex];
+		Archetype& destination = m_Archetypes[target];
+
+		// both type lists are sorted, so the matching columns are found in a single pass
+		size_t column{};
+		for (size_t i{}; i < source.m_Types.size(); ++i)
+		{
+			const uint64_t id = source.m_Types[i].GetId();
+			while (column < destination.m_Types.size() && destination.m_Types[column].GetId() < id)
+			{
+				++column;
+			}
+
+			const TypeInfo& info = *source.m_Infos[i];
+			void* component = source.GetAddress(i, record.Row);
+
+			if (column < destination.m_Types.size() && destination.m_Types[column].GetId() == id)
+				Archetype::Relocate(info, destination.GetAddress(column, targetRow), component);
+			else if (info.Destructor)
+				info.Destructor(component);
+		}
+
+		const Entity moved = source.RemoveRow(record.Row);
+		if (moved.IsValid())
+			m_Entities[moved.Index].Row = record.Row;
+
+		record.ArchetypeIndex = target;
+		record.Row = targetRow;
+	}
+
+	inline void ArchetypeStorage::SortTypes(std::vector<TypeId>& types)
+	{
+		std::ranges::sort(types, {}, &TypeId::GetId);
+		assert(std::ranges::adjacent_find(types, {}, &TypeId::GetId) == types.end() && "Component types must be unique");
+	}
+}
+
+#endif
@@ -0,0 +1,212 @@
+#pragma once
+
+#ifdef GLAS_STORAGE
+
+#include <span>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <memory_resource>
+
+#include "../glas_decl.h"
+#include "glas_storage_config.h"
+
+namespace glas::Storage
+{
+	/**
+	 * Handle of an entity inside of an ArchetypeStorage.
+	 * The generation is increased when the entity is destroyed, so handles of destroyed entities are never reused.
+	 */
+	struct Entity
+	{
+		static constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		uint32_t	Index		{ InvalidIndex };
+		uint32_t	Generation	{ };
+
+		constexpr bool IsValid		()						const	{ return Index != InvalidIndex; }
+		constexpr bool operator==	(const Entity& other)	const	= default;
+	};
+
+	/**
+	 * Entities that have exactly the same set of component types.
+	 * The components are stored in chunks of GLAS_STORAGE_CHUNK_SIZE bytes, every chunk holds one column per component type and a column of entity handles.
+	 * The rows are kept dense, removing a row moves the last row into its place.
+	 * @see ArchetypeStorage
+	 */
+	class Archetype final
+	{
+	public:
+		Archetype(std::span<const TypeId> types, std::pmr::memory_resource* resource);
+		~Archetype();
+
+		Archetype(const Archetype&) = delete;
+		Archetype(Archetype&&) noexcept = default;
+		Archetype& operator=(const Archetype&) = delete;
+		Archetype& operator=(Archetype&&) noexcept = default;
+
+	public:
+		/** @returns the component types, sorted by their id. */
+		std::span<const TypeId>		GetTypes		()	const	{ return m_Types; }
+
+		/** @returns the column of the component type, or InvalidColumn. */
+		size_t						GetColumn		(TypeId type)	const;
+
+		/** @returns true if the archetype has all component types, the types must be sorted by their id. */
+		bool						HasTypes		(std::span<const TypeId> sortedTypes)	const;
+
+		size_t						Size			()	const	{ return m_Size; }
+		size_t						GetChunkCapacity()	const	{ return m_ChunkCapacity; }
+		size_t						GetChunkCount	()	const	{ return m_Chunks.size(); }
+
+		/** @returns the amount of rows inside of the chunk. */
+		size_t						GetChunkSize	(size_t chunk)	const;
+
+		Entity*						GetEntities		(size_t chunk)					{ return reinterpret_cast<Entity*>(m_Chunks[chunk].Get()); }
+		const Entity*				GetEntities		(size_t chunk)			const	{ return reinterpret_cast<const Entity*>(m_Chunks[chunk].Get()); }
+		void*						GetColumnData	(size_t chunk, size_t column)	const	{ return m_Chunks[chunk].Get() + m_ColumnOffsets[column]; }
+
+		/** @returns the address of the component inside of the row. */
+		void*						GetAddress		(size_t column, size_t row)		const;
+
+		static constexpr size_t		InvalidColumn	= std::numeric_limits<size_t>::max();
+
+	private:
+		friend class ArchetypeStorage;
+
+		/** Adds a row for the entity, its components are not constructed. */
+		size_t						AddRow			(Entity entity);
+
+		/**
+		 * Removes the row by relocating the last row into its place, the components of the row must have been destroyed or relocated.
+		 * @returns the entity that was moved into the row, or an invalid entity.
+		 */
+		Entity						RemoveRow		(size_t row);
+
+		void						DestroyRow		(size_t row);
+
+		/** Moves the component to another address, trivially relocatable components are copied as bytes. */
+		static void					Relocate		(const TypeInfo& info, void* destination, void* source);
+
+	private:
+		std::vector<TypeId>							m_Types			{ };
+		std::vector<const TypeInfo*>				m_Infos			{ };
+		std::vector<size_t>							m_ColumnOffsets	{ }; /**< Offset of every column inside of a chunk*/
+		std::vector<StorageBuffer>					m_Chunks		{ };
+		std::unordered_map<uint64_t, uint32_t>		m_AddEdges		{ }; /**< Archetype that is reached by adding a component type*/
+		std::unordered_map<uint64_t, uint32_t>		m_RemoveEdges	{ }; /**< Archetype that is reached by removing a component type*/
+		size_t										m_ChunkCapacity	{ };
+		size_t										m_ChunkSize		{ }; /**< Size in bytes of a chunk*/
+		size_t										m_ChunkAlign	{ };
+		size_t										m_Size			{ };
+		std::pmr::memory_resource*					m_Resource		{ };
+	};
+
+	/**
+	 * Data oriented storage of entities whose components are described by TypeIds.
+	 * Entities with the same set of components share an Archetype, so iterating over the entities that have a set of components
+	 * reads the columns of the matching archetypes chunk by chunk. Components are constructed, relocated and destroyed using their TypeInfo.
+	 * Adding or removing a component moves the entity to another archetype, the transitions between archetypes are cached.
+	 * Component types must be registered and move constructible. A storage is not thread safe.
+	 */
+	class ArchetypeStorage final
+	{
+	public:
+		explicit ArchetypeStorage(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		~ArchetypeStorage() = default;
+
+		ArchetypeStorage(const ArchetypeStorage&) = delete;
+		ArchetypeStorage(ArchetypeStorage&&) noexcept = default;
+		ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+		ArchetypeStorage& operator=(ArchetypeStorage&&) noexcept = default;
+
+	public: // Entities
+
+		/** Creates an entity with default constructed components of the types. */
+		Entity						Create			(std::span<const TypeId> types = {});
+
+		/** Creates an entity with the given components. */
+		template <typename... Components>
+		Entity						Create			(Components&&... components) requires (sizeof...(Components) > 0 && !(std::is_convertible_v<Components, std::span<const TypeId>> || ...));
+
+		/** Destroys the entity and its components. */
+		void						Destroy			(Entity entity);
+
+		bool						IsAlive			(Entity entity)	const;
+		size_t						GetEntityCount	()	const	{ return m_EntityCount; }
+
+	public: // Components
+
+		/** Default constructs a component of the type, the entity must not have the component yet. */
+		void*						AddComponent	(Entity entity, TypeId type);
+
+		template <typename T, typename... Arguments>
+		T&							AddComponent	(Entity entity, Arguments&&... arguments);
+
+		/** Destroys the component of the type, the entity must have the component. */
+		void						RemoveComponent	(Entity entity, TypeId type);
+
+		template <typename T>
+		void						RemoveComponent	(Entity entity)	{ RemoveComponent(entity, TypeId::Create<T>()); }
+
+		bool						HasComponent	(Entity entity, TypeId type)	const;
+
+		/** @returns the component of the type, or nullptr if the entity does not have it. */
+		void*						GetComponent	(Entity entity, TypeId type);
+
+		template <typename T>
+		T*							GetComponent	(Entity entity)	{ return static_cast<T*>(GetComponent(entity, TypeId::Create<T>())); }
+
+	public: // Queries
+
+		/**
+		 * Calls the function for every archetype that has all of the component types.
+		 * @param function is called with the Archetype&, its chunks can be iterated linearly.
+		 */
+		template <typename Function>
+		void						Query			(std::span<const TypeId> types, Function&& function);
+
+		/** Calls the function with the entity and its components, for every entity that has all of the components. */
+		template <typename... Components, typename Function>
+		void						ForEach			(Function&& function);
+
+		size_t						GetArchetypeCount	()	const	{ return m_Archetypes.size(); }
+
+	private:
+		struct EntityRecord
+		{
+			uint32_t	ArchetypeIndex	{ };
+			uint32_t	Generation		{ };
+			size_t		Row				{ };
+		};
+
+		EntityRecord&				GetRecord		(Entity entity);
+		Entity						AllocateEntity	();
+		uint32_t					FindArchetype	(std::vector<TypeId>& sortedTypes);
+		uint32_t					GetAddTarget	(uint32_t archetype, TypeId type);
+		uint32_t					GetRemoveTarget	(uint32_t archetype, TypeId type);
+
+		/**
+		 * Moves the entity into the row of the target archetype, components that the target does not have are destroyed.
+		 * The components that only the target has must already be constructed.
+		 */
+		void						MoveEntity		(Entity entity, uint32_t target, size_t targetRow);
+
+		template <typename Function>
+		void*						ConstructComponent(Entity entity, TypeId type, Function&& constructor);
+
+		static void					SortTypes		(std::vector<TypeId>& types);
+
+	private:
+		std::vector<Archetype>		m_Archetypes	{ };
+		std::vector<EntityRecord>	m_Entities		{ };
+		std::vector<uint32_t>		m_FreeEntities	{ };
+		size_t						m_EntityCount	{ };
+		std::pmr::memory_resource*	m_Resource		{ };
+	};
+}
+
+#endif
@@ -2,13 +2,24 @@
 
 #ifdef GLAS_STORAGE
 
+#include <bit>
 #include <span>
+#include <atomic>
 #include <tuple>
 #include <memory>
 #include <string>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
+#include <functional>
 #include <stdexcept>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <type_traits>
+#include <memory_resource>
 #include <initializer_list>
 
 #include "../glas_decl.h"
@@ -37,388 +48,1069 @@ namespace glas::Storage
 				new (location) T(std::move(*static_cast<T*>(other)));
 			};
 
+		if constexpr (EnableMoveConstructor<T>)
+			info.NothrowMoveConstructor = std::is_nothrow_move_constructible_v<T>;
+
+		info.TriviallyCopyable = std::is_trivially_copyable_v<T>;
+		info.TriviallyRelocatable = IsTriviallyRelocatable<T>;
+		info.TriviallyComparable = IsTriviallyComparable<T>;
+
 		if constexpr (EnableDestructor<T>)
 			info.Destructor = [](void* data)
 			{
 				static_cast<T*>(data)->~T();
 			};
 
+		if constexpr (EnableDefaultConstructor<T>)
+			info.ConstructN = [](void* location, size_t count)
+			{
+				// value initializing a scalar sets all of its bits to zero, except for pointers to members
+				if constexpr (std::is_scalar_v<T> && !std::is_member_pointer_v<T>)
+				{
+					if (count)
+						std::memset(location, 0, count * sizeof(T));
+				}
+				else
+				{
+					std::uninitialized_value_construct_n(static_cast<T*>(location), count);
+				}
+			};
+
+		if constexpr (EnableCopyConstructor<T>)
+			info.CopyConstructN = [](void* location, const void* other, size_t count)
+			{
+				if constexpr (std::is_trivially_copyable_v<T>)
+				{
+					if (count)
+						std::memcpy(location, other, count * sizeof(T));
+				}
+				else
+				{
+					std::uninitialized_copy_n(static_cast<const T*>(other), count, static_cast<T*>(location));
+				}
+			};
+
+		if constexpr (EnableMoveConstructor<T>)
+			info.MoveConstructN = [](void* location, void* other, size_t count)
+			{
+				if constexpr (std::is_trivially_copyable_v<T>)
+				{
+					if (count)
+						std::memcpy(location, other, count * sizeof(T));
+				}
+				else
+				{
+					std::uninitialized_move_n(static_cast<T*>(other), count, static_cast<T*>(location));
+				}
+			};
+
+		if constexpr (EnableDestructor<T>)
+			info.DestructN = [](void* data, size_t count)
+			{
+				if constexpr (!std::is_trivially_destructible_v<T>)
+					std::destroy_n(static_cast<T*>(data), count);
+			};
+
 		if constexpr (EnableSwapping<T>)
 			info.Swap = [](void* lhs, void* rhs)
 			{
 				using std::swap;
 				swap(*static_cast<T*>(lhs), *static_cast<T*>(rhs));
 			};
-	}
 
-	/** HELPER FUNCTIONS */
+		if constexpr (EnableHashing<T>)
+			info.Hash = [](const void* data) -> size_t
+			{
+				if constexpr (Hashable<T>)
+					return std::hash<T>{}(*static_cast<const T*>(data));
+				else
+					return HashBytes(data, sizeof(T));
+			};
 
-	inline const void* VoidOffset(const void* data, size_t offset)
-	{
-		return static_cast<const uint8_t*>(data) + offset;
+		if constexpr (EnableEquality<T>)
+			info.Equals = [](const void* lhs, const void* rhs) -> bool
+			{
+				if constexpr (std::equality_comparable<T>)
+					return *static_cast<const T*>(lhs) == *static_cast<const T*>(rhs);
+				else
+					return std::memcmp(lhs, rhs, sizeof(T)) == 0;
+			};
 	}
 
-	inline void* VoidOffset(void* data, size_t offset)
+	template <typename T>
+	void FillMemberComparison(TypeInfo& info)
 	{
-		return static_cast<uint8_t*>(data) + offset;
+		if constexpr (EnableMemberComparison<T>)
+		{
+			// types with their own Hash or Equals keep them
+			if (!info.MemberComparison && (info.Hash || info.Equals))
+				return;
+
+			info.Hash = &HashMembers<T>;
+			info.Equals = &EqualsMembers<T>;
+			info.MemberComparison = true;
+		}
 	}
 
-	/**
-	 * TYPE STORAGE
-	 */
+	/** HASHING */
 
-	inline TypeStorage::TypeStorage(glas::TypeId id)
-		: m_TypeId{ id }
+	constexpr uint64_t MixHash(uint64_t hash)
 	{
-		auto& info = id.GetInfo();
-		m_Data = std::make_unique<uint8_t[]>(info.Size);
-
-		assert(info.Constructor && "Type has no default constructor");
-
-		info.Constructor(m_Data.get());
+		// finalizer of MurmurHash3
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ull;
+		hash ^= hash >> 33;
+		return hash;
 	}
 
-	inline TypeStorage::~TypeStorage()
+	inline size_t HashBytes(const void* data, size_t size)
 	{
-		if (m_TypeId.IsValid() && m_Data)
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash{ 0x9E3779B97F4A7C15ull ^ size };
+
+		// the bytes are read a word at a time and only mixed thoroughly at the end
+		for (; size >= sizeof(uint64_t); bytes += sizeof(uint64_t), size -= sizeof(uint64_t))
 		{
-			auto& info = m_TypeId.GetInfo();
-			if (info.Destructor)
-			{
-				info.Destructor(m_Data.get());
-			}
+			uint64_t word;
+			std::memcpy(&word, bytes, sizeof(uint64_t));
+			hash = std::rotl((hash ^ word) * 0x9E3779B97F4A7C15ull, 31);
+		}
+
+		if (size)
+		{
+			uint64_t word{};
+			std::memcpy(&word, bytes, size);
+			hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
 		}
+
+		return static_cast<size_t>(MixHash(hash));
 	}
 
-	inline TypeStorage::TypeStorage(const TypeStorage& other)
-		: m_TypeId{ other.m_TypeId }
+	inline size_t HashMembers(const TypeInfo& info, const void* data)
 	{
-		if (other.m_Data && m_TypeId.IsValid())
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		uint64_t hash{ info.Size };
+
+		for (const BaseClassInfo& base : info.BaseClasses)
 		{
-			const auto& info = m_TypeId.GetInfo();
-			const auto copyConstructor = info.CopyConstructor;
+			const TypeInfo& baseInfo = base.BaseId.GetInfo();
+			assert(baseInfo.Hash);
+			hash = MixHash(hash ^ baseInfo.Hash(bytes + base.ClassOffset));
+		}
 
-			assert(copyConstructor);
+		for (const MemberInfo& member : info.Members)
+		{
+			if (member.Variable.IsPointer())
+			{
+				hash = MixHash(hash ^ HashBytes(bytes + member.Offset, member.Size));
+				continue;
+			}
+
+			const TypeInfo& memberInfo = member.Variable.GetTypeId().GetInfo();
+			assert(memberInfo.Hash);
 
-			m_Data = std::make_unique<uint8_t[]>(info.Size);
-			copyConstructor(m_Data.get(), other.m_Data.get());
+			const uint32_t count = std::max<uint32_t>(member.Variable.GetArraySize(), 1);
+			for (uint32_t i{}; i < count; ++i)
+			{
+				hash = MixHash(hash ^ memberInfo.Hash(bytes + member.Offset + i * memberInfo.Size));
+			}
 		}
-	}
 
-	inline TypeStorage::TypeStorage(TypeStorage&& other) noexcept
-		: m_Data{ std::move(other.m_Data) }
-		, m_TypeId{ other.m_TypeId }
-	{
-		other.m_TypeId = {};
+		return static_cast<size_t>(hash);
 	}
 
-	inline TypeStorage& TypeStorage::operator=(const TypeStorage& other)
+	inline bool EqualsMembers(const TypeInfo& info, const void* lhs, const void* rhs)
 	{
-		m_TypeId = other.m_TypeId;
+		const auto* lhsBytes = static_cast<const uint8_t*>(lhs);
+		const auto* rhsBytes = static_cast<const uint8_t*>(rhs);
 
-		if (this != &other && other.m_TypeId.IsValid())
+		for (const BaseClassInfo& base : info.BaseClasses)
 		{
-			const auto& info = m_TypeId.GetInfo();
-			const auto copyConstructor = info.CopyConstructor;
-
-			assert(copyConstructor);
+			if (!base.BaseId.GetInfo().Equals(lhsBytes + base.ClassOffset, rhsBytes + base.ClassOffset))
+				return false;
+		}
 
-			if (m_Data.get())
+		for (const MemberInfo& member : info.Members)
+		{
+			if (member.Variable.IsPointer())
 			{
-				const auto destructor = info.Destructor;
-				assert(destructor);
-				destructor(m_Data.get());
+				if (std::memcmp(lhsBytes + member.Offset, rhsBytes + member.Offset, member.Size) != 0)
+					return false;
+				continue;
 			}
 
-			m_Data = std::make_unique<uint8_t[]>(info.Size);
-			copyConstructor(m_Data.get(), other.m_Data.get());
+			const TypeInfo& memberInfo = member.Variable.GetTypeId().GetInfo();
+			const uint32_t count = std::max<uint32_t>(member.Variable.GetArraySize(), 1);
+			for (uint32_t i{}; i < count; ++i)
+			{
+				const size_t offset = member.Offset + i * memberInfo.Size;
+				if (!memberInfo.Equals(lhsBytes + offset, rhsBytes + offset))
+					return false;
+			}
 		}
+
+		return true;
 	}
 
-	inline TypeStorage& TypeStorage::operator=(TypeStorage&& other) noexcept
+	template <typename T>
+	size_t HashMembers(const void* data)
 	{
-		if (this != &other)
-		{
-			m_Data = std::move(other.m_Data);
-			m_TypeId = other.m_TypeId;
-
-			other.m_TypeId = {};
-		}
-		return *this;
+		static const TypeInfo& info = TypeId::Create<T>().GetInfo();
+		return HashMembers(info, data);
 	}
 
 	template <typename T>
-	TypeStorage TypeStorage::Construct() requires std::is_default_constructible_v<T>
+	bool EqualsMembers(const void* lhs, const void* rhs)
 	{
-		auto storage = Initialize<T>();
+		static const TypeInfo& info = TypeId::Create<T>().GetInfo();
+		return EqualsMembers(info, lhs, rhs);
+	}
+
+	inline bool CanCompareMembers(const TypeInfo& info)
+	{
+		const auto& typeInfoMap = GetAllTypeInfo();
+		const auto isComparable = [&typeInfoMap](TypeId type)
+			{
+				const auto it = typeInfoMap.find(type);
+				return it != typeInfoMap.end() && IsComparable(it->second);
+			};
 
-		new (storage.m_Data.get()) T();
+		for (const BaseClassInfo& base : info.BaseClasses)
+		{
+			if (!isComparable(base.BaseId))
+				return false;
+		}
 
-		return storage;
+		for (const MemberInfo& member : info.Members)
+		{
+			if (member.Variable.IsReference() || member.Variable.IsRValReference())
+				return false;
+
+			if (!member.Variable.IsPointer() && !isComparable(member.Variable.GetTypeId()))
+				return false;
+		}
+
+		return !info.BaseClasses.empty() || !info.Members.empty();
 	}
 
-	template <typename T, typename ... Parameters>
-	TypeStorage TypeStorage::Construct(Parameters&&... parameters)
+	inline bool IsComparable(const TypeInfo& info)
 	{
-		auto storage = Initialize<T>();
+		return info.Hash && info.Equals && (!info.MemberComparison || CanCompareMembers(info));
+	}
 
-		new (storage.m_Data.get()) T(std::forward<Parameters>(parameters)...);
+	/** HELPER FUNCTIONS */
 
-		return storage;
+	inline const void* VoidOffset(const void* data, size_t offset)
+	{
+		return static_cast<const uint8_t*>(data) + offset;
 	}
 
-	template <typename T>
-	TypeStorage TypeStorage::CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>
+	inline void* VoidOffset(void* data, size_t offset)
 	{
-		auto storage = Initialize<T>();
+		return static_cast<uint8_t*>(data) + offset;
+	}
 
-		new (storage.m_Data.get()) T(value);
+	/**
+	 * STORAGE BUFFER
+	 */
 
-		return storage;
+	inline StorageBuffer::StorageBuffer(std::pmr::memory_resource* resource)
+		: m_Resource{ resource }
+	{
+		assert(resource);
 	}
 
-	template <typename T>
-	TypeStorage TypeStorage::MoveConstruct(T&& value) requires std::is_move_constructible_v<T>
+	inline StorageBuffer::StorageBuffer(size_t size, size_t align, std::pmr::memory_resource* resource)
+		: m_Size{ size }
+		, m_Align{ align }
+		, m_Resource{ resource }
 	{
-		auto storage = Initialize<T>();
+		assert(resource);
+		assert(std::has_single_bit(align));
 
-		new (storage.m_Data.get()) T(value);
-
-		return storage;
+		if (size)
+			m_Data = static_cast<uint8_t*>(resource->allocate(size, align));
 	}
 
-	inline TypeStorage TypeStorage::CopyConstruct(glas::TypeId id, const void* original)
+	inline StorageBuffer::~StorageBuffer()
 	{
-		auto& info = id.GetInfo();
-		assert(info.CopyConstructor);
+		Reset();
+	}
 
-		TypeStorage storage;
+	inline StorageBuffer::StorageBuffer(StorageBuffer&& other) noexcept
+		: m_Data{ std::exchange(other.m_Data, nullptr) }
+		, m_Size{ std::exchange(other.m_Size, 0) }
+		, m_Align{ other.m_Align }
+		, m_Resource{ other.m_Resource }
+	{
+	}
 
-		storage.m_TypeId = id;
-		storage.m_Data = std::make_unique<uint8_t[]>(info.Size);
+	inline StorageBuffer& StorageBuffer::operator=(StorageBuffer&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			m_Data		= std::exchange(other.m_Data, nullptr);
+			m_Size		= std::exchange(other.m_Size, 0);
+			m_Align		= other.m_Align;
+			m_Resource	= other.m_Resource;
+		}
+		return *this;
+	}
 
-		info.CopyConstructor(storage.GetData(), original);
-		return storage;
+	inline uint8_t* StorageBuffer::Release()
+	{
+		m_Size = 0;
+		return std::exchange(m_Data, nullptr);
 	}
 
-	inline TypeStorage TypeStorage::MoveConstruct(glas::TypeId id, void* original)
+	inline void StorageBuffer::Reset()
 	{
-		auto& info = id.GetInfo();
-		assert(info.MoveConstructor);
+		if (m_Data)
+			m_Resource->deallocate(m_Data, m_Size, m_Align);
 
-		TypeStorage storage;
+		m_Data = nullptr;
+		m_Size = 0;
+	}
 
-		storage.m_TypeId = id;
-		storage.m_Data = std::make_unique<uint8_t[]>(info.Size);
+	/**
+	 * MONOTONIC ARENA
+	 */
 
-		info.MoveConstructor(storage.GetData(), original);
-		return storage;
+	inline MonotonicArena::MonotonicArena(size_t blockSize, std::pmr::memory_resource* upstream)
+		: m_BlockSize{ blockSize }
+		, m_Upstream{ upstream }
+	{
+		assert(blockSize);
+		assert(upstream);
 	}
 
-	template <typename T>
-	T* TypeStorage::As() const
+	inline MonotonicArena::~MonotonicArena()
 	{
-		return (TypeId::Create<T>() == m_TypeId) ? static_cast<T*>(GetData()) : nullptr;
+		Release();
 	}
 
-	template <typename T>
-	std::unique_ptr<T> TypeStorage::TransferOwnershipCheck()
+	inline void MonotonicArena::Rewind(Marker marker)
 	{
-		if (glas::TypeId::Create<T>() != m_TypeId)
-			throw std::runtime_error("Given type does not match stored type");
+		assert(marker.Block < m_CurrentBlock || (marker.Block == m_CurrentBlock && marker.Offset <= m_Offset));
 
-		m_TypeId = {};
-		return std::unique_ptr<T>{reinterpret_cast<T*>(m_Data.release())};
+		m_CurrentBlock = marker.Block;
+		m_Offset = marker.Offset;
 	}
 
-	template <typename T>
-	std::unique_ptr<T> TypeStorage::TransferOwnershipUnsafe()
+	inline void MonotonicArena::Release()
 	{
-		m_TypeId = {};
-		return std::unique_ptr<T>{reinterpret_cast<T*>(m_Data.release())};
+		for (const Block& block : m_Blocks)
+		{
+			m_Upstream->deallocate(block.Data, block.Size, BlockAlignment);
+		}
+
+		m_Blocks.clear();
+		m_CurrentBlock = 0;
+		m_Offset = 0;
 	}
 
-	template <typename T>
-	TypeStorage TypeStorage::Initialize()
+	inline void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)
 	{
-		GlasAutoRegisterTypeOnce<T> RegisterType{};
+		assert(std::has_single_bit(alignment));
 
-		TypeStorage storage;
-		storage.m_TypeId = TypeId::Create<T>();
-		storage.m_Data = std::make_unique<uint8_t[]>(sizeof(T));
+		// the blocks that were kept after a rewind are used before new blocks are allocated
+		for (; m_CurrentBlock < m_Blocks.size(); ++m_CurrentBlock, m_Offset = 0)
+		{
+			const Block& block = m_Blocks[m_CurrentBlock];
+			const size_t padding = (alignment - (reinterpret_cast<uintptr_t>(block.Data) + m_Offset) % alignment) % alignment;
 
-		return storage;
+			if (m_Offset + padding + bytes <= block.Size)
+			{
+				uint8_t* data = block.Data + m_Offset + padding;
+				m_Offset += padding + bytes;
+				return data;
+			}
+		}
+
+		// the block is large enough to align the allocation inside of it
+		const size_t blockSize = std::max(m_BlockSize, bytes + alignment);
+		const Block& block = m_Blocks.emplace_back(Block{ static_cast<uint8_t*>(m_Upstream->allocate(blockSize, BlockAlignment)), blockSize });
+		const size_t padding = (alignment - reinterpret_cast<uintptr_t>(block.Data) % alignment) % alignment;
+
+		m_CurrentBlock = m_Blocks.size() - 1;
+		m_Offset = padding + bytes;
+		return block.Data + padding;
 	}
 
 	/**
-	 * SHARED TYPE STORAGE
+	 * TYPE STORAGE
 	 */
 
-	inline std::shared_ptr<std::unique_ptr<uint8_t[]>> CreateSharedTypeStorageData(size_t size)
-	{
-		std::unique_ptr<uint8_t[]> data = std::make_unique<uint8_t[]>(size);
-		return std::make_shared<std::unique_ptr<uint8_t[]>>(std::move(data));
-	}
+	static_assert(sizeof(void*) != 8 || GLAS_STORAGE_INLINE_SIZE != 32 || sizeof(TypeStorage) == 64);
 
-	inline SharedTypeStorage::SharedTypeStorage(glas::TypeId id)
-		: m_TypeId{ id }
+	inline TypeStorage::TypeStorage(glas::TypeId id, std::pmr::memory_resource* resource)
+		: m_Resource{ resource }
 	{
 		auto& info = id.GetInfo();
-		m_Data = CreateSharedTypeStorageData(info.Size);
+
 		assert(info.Constructor && "Type has no default constructor");
-		info.Constructor(GetData());
+
+		ConstructData(id, info, info.Constructor);
 	}
 
-	inline SharedTypeStorage::~SharedTypeStorage()
+	inline TypeStorage::~TypeStorage()
 	{
-		if (m_TypeId.IsValid() && m_Data.use_count() == 1)
-		{
-			auto& info = m_TypeId.GetInfo();
-			if (info.Destructor)
-			{
-				info.Destructor(GetData());
-			}
-		}
+		Destroy();
 	}
 
-	template <typename T>
-	SharedTypeStorage SharedTypeStorage::Construct() requires std::is_default_constructible_v<T>
+	inline TypeStorage::TypeStorage(const TypeStorage& other)
 	{
-		auto storage = Initialize<T>();
+		if (other.m_Data)
+		{
+			const auto copyConstructor = other.m_Info->CopyConstructor;
 
-		new (storage.GetData()) T();
+			assert(copyConstructor);
 
-		return storage;
+			ConstructData(other.m_TypeId, *other.m_Info, [copyConstructor, &other](void* data) { copyConstructor(data, other.m_Data); });
+		}
 	}
 
-	template <typename T, typename ... Parameters>
-	SharedTypeStorage SharedTypeStorage::Construct(Parameters&&... parameters)
+	inline TypeStorage::TypeStorage(TypeStorage&& other) noexcept
+		: m_Resource{ other.m_Resource }
 	{
-		auto storage = Initialize<T>();
-
-		new (storage.GetData()) T(parameters...);
-
-		return storage;
+		MoveData(other);
 	}
 
-	template <typename T>
-	SharedTypeStorage SharedTypeStorage::CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>
+	inline TypeStorage& TypeStorage::operator=(const TypeStorage& other)
 	{
-		auto storage = Initialize<T>();
+		if (this != &other)
+		{
+			// the copy is made before the current instance is destroyed, and uses the memory resource of this storage
+			if (other.m_Data)
+				*this = CopyConstruct(other.m_TypeId, other.m_Data, m_Resource);
+			else
+				Destroy();
+		}
+		return *this;
+	}
 
-		new (storage.GetData()) T(value);
+	inline TypeStorage& TypeStorage::operator=(TypeStorage&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Destroy();
 
-		return storage;
+			m_Resource = other.m_Resource;
+			MoveData(other);
+		}
+		return *this;
 	}
 
 	template <typename T>
-	SharedTypeStorage SharedTypeStorage::MoveConstruct(T&& value) requires std::is_move_constructible_v<T>
+	TypeStorage TypeStorage::Construct() requires std::is_default_constructible_v<T>
 	{
-		auto storage = Initialize<T>();
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource());
+	}
 
-		new (storage.GetData()) T(value);
+	template <typename T, typename ... Parameters>
+	TypeStorage TypeStorage::Construct(Parameters&&... parameters) requires (!StartsWithAllocatorArg<Parameters...>)
+	{
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource(), std::forward<Parameters>(parameters)...);
+	}
 
-		return storage;
+	template <typename T, typename ... Parameters>
+	TypeStorage TypeStorage::Construct(std::allocator_arg_t, std::pmr::memory_resource* resource, Parameters&&... parameters)
+	{
+		return ConstructInPlace(TypeId::Create<T>(), [&](void* data)
+			{
+				new (data) T(std::forward<Parameters>(parameters)...);
+			}, resource);
 	}
 
-	inline SharedTypeStorage SharedTypeStorage::CopyConstruct(glas::TypeId id, const void* original)
+	template <typename T>
+	TypeStorage TypeStorage::CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>
 	{
-		auto& info = id.GetInfo();
-		assert(info.CopyConstructor);
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource(), value);
+	}
 
-		SharedTypeStorage storage;
+	template <typename T>
+	TypeStorage TypeStorage::MoveConstruct(T&& value) requires std::is_move_constructible_v<T>
+	{
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource(), std::move(value));
+	}
 
-		storage.m_TypeId = id;
-		storage.m_Data = CreateSharedTypeStorageData(info.Size);
+	inline TypeStorage TypeStorage::CopyConstruct(glas::TypeId id, const void* original, std::pmr::memory_resource* resource)
+	{
+		const auto copyConstructor = id.GetInfo().CopyConstructor;
+		assert(copyConstructor);
 
-		info.CopyConstructor(storage.GetData(), original);
-		return storage;
+		return ConstructInPlace(id, [copyConstructor, original](void* data) { copyConstructor(data, original); }, resource);
 	}
 
-	inline SharedTypeStorage SharedTypeStorage::MoveConstruct(glas::TypeId id, void* original)
+	inline TypeStorage TypeStorage::MoveConstruct(glas::TypeId id, void* original, std::pmr::memory_resource* resource)
 	{
-		auto& info = id.GetInfo();
-		assert(info.MoveConstructor);
-
-		SharedTypeStorage storage;
+		const auto moveConstructor = id.GetInfo().MoveConstructor;
+		assert(moveConstructor);
 
-		storage.m_TypeId = id;
-		storage.m_Data = CreateSharedTypeStorageData(info.Size);
+		return ConstructInPlace(id, [moveConstructor, original](void* data) { moveConstructor(data, original); }, resource);
+	}
 
-		info.MoveConstructor(storage.GetData(), original);
+	template <typename Constructor>
+	TypeStorage TypeStorage::ConstructInPlace(glas::TypeId id, Constructor&& constructor, std::pmr::memory_resource* resource)
+	{
+		TypeStorage storage;
+		storage.m_Resource = resource;
+		storage.ConstructData(id, id.GetInfo(), std::forward<Constructor>(constructor));
 		return storage;
 	}
 
-	inline WeakTypeStorage::WeakTypeStorage(const SharedTypeStorage& sharedStorage)
-		: m_Data{ sharedStorage.m_Data }
-		, m_TypeId{ sharedStorage.m_TypeId }
+	inline bool TypeStorage::FitsInline(const TypeInfo& info)
 	{
-
+		// moving a storage relocates the inline instance, which must not throw
+		return info.Size <= GLAS_STORAGE_INLINE_SIZE && info.Align <= GLAS_STORAGE_INLINE_ALIGN && info.NothrowMoveConstructor;
 	}
 
 	template <typename T>
-	T* SharedTypeStorage::As()
+	T* TypeStorage::As() const
 	{
 		return (TypeId::Create<T>() == m_TypeId) ? static_cast<T*>(GetData()) : nullptr;
 	}
 
 	template <typename T>
-	SharedTypeStorage SharedTypeStorage::Initialize()
+	std::unique_ptr<T> TypeStorage::TransferOwnershipCheck()
 	{
-		GlasAutoRegisterTypeOnce<T> RegisterType{};
-
-		SharedTypeStorage storage;
-		storage.m_TypeId = TypeId::Create<T>();
-		storage.m_Data = CreateSharedTypeStorageData(sizeof(T));
+		if (glas::TypeId::Create<T>() != m_TypeId)
+			throw std::runtime_error("Given type does not match stored type");
 
-		return storage;
+		return TransferOwnershipUnsafe<T>();
 	}
 
-	/**
-	 * WEAK TYPE STORAGE
-	 */
+	template <typename T>
+	std::unique_ptr<T> TypeStorage::TransferOwnershipUnsafe()
+	{
+		if (!m_Data)
+			return {};
 
-	inline SharedTypeStorage WeakTypeStorage::GetSharedStorage() const
+		// inline instances and memory resources can not be freed through std::default_delete, so the instance is moved into memory of its own
+		auto value = std::make_unique<T>(std::move(*static_cast<T*>(GetData())));
+		Destroy();
+		return value;
+	}
+
+	template <typename Constructor>
+	void TypeStorage::ConstructData(glas::TypeId id, const TypeInfo& info, Constructor&& constructor)
 	{
-		SharedTypeStorage returnVal = { m_TypeId };
-		if (!Expired())
+		assert(!m_Data);
+
+		void* data = FitsInline(info) ? static_cast<void*>(m_Buffer) : m_Resource->allocate(info.Size, info.Align);
+		m_Data = data;
+
+		try
 		{
-			returnVal.m_Data = m_Data.lock();
+			constructor(data);
+		}
+		catch (...)
+		{
+			Deallocate(info);
+			throw;
 		}
 
-		return returnVal;
+		m_Info = &info;
+		m_TypeId = id;
 	}
 
-	/**
-	 * TYPE TUPLE
+	inline void TypeStorage::MoveData(TypeStorage& other) noexcept
+	{
+		assert(!m_Data);
+
+		if (other.IsInline())
+		{
+			if (other.m_Info->TriviallyRelocatable)
+			{
+				std::memcpy(m_Buffer, other.m_Buffer, other.m_Info->Size);
+			}
+			else
+			{
+				other.m_Info->MoveConstructor(m_Buffer, other.m_Buffer);
+				if (other.m_Info->Destructor)
+					other.m_Info->Destructor(other.m_Buffer);
+			}
+
+			m_Data = m_Buffer;
+		}
+		else
+		{
+			m_Data = other.m_Data;
+		}
+
+		m_Info = std::exchange(other.m_Info, nullptr);
+		m_TypeId = std::exchange(other.m_TypeId, {});
+		other.m_Data = nullptr;
+	}
+
+	inline void TypeStorage::Deallocate(const TypeInfo& info)
+	{
+		if (m_Data && !IsInline())
+			m_Resource->deallocate(m_Data, info.Size, info.Align);
+
+		m_Data = nullptr;
+	}
+
+	inline void TypeStorage::Destroy()
+	{
+		if (m_Data)
+		{
+			if (m_Info->Destructor)
+			{
+				m_Info->Destructor(m_Data);
+			}
+
+			Deallocate(*m_Info);
+		}
+
+		m_Info = nullptr;
+		m_TypeId = {};
+	}
+
+	/**
+	 * SHARED TYPE STORAGE
+	 */
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe>::BasicSharedTypeStorage(glas::TypeId id, std::pmr::memory_resource* resource)
+	{
+		const auto constructor = id.GetInfo().Constructor;
+		assert(constructor && "Type has no default constructor");
+
+		*this = ConstructInPlace(id, constructor, resource);
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe>::~BasicSharedTypeStorage()
+	{
+		Release();
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe>::BasicSharedTypeStorage(const BasicSharedTypeStorage& other)
+		: m_Data{ other.m_Data }
+	{
+		if (m_Data)
+			AddReference(GetHeader()->StrongCount);
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe>::BasicSharedTypeStorage(BasicSharedTypeStorage&& other) noexcept
+		: m_Data{ std::exchange(other.m_Data, nullptr) }
+	{
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe>& BasicSharedTypeStorage<ThreadSafe>::operator=(const BasicSharedTypeStorage& other)
+	{
+		BasicSharedTypeStorage copy{ other };
+		std::swap(m_Data, copy.m_Data);
+		return *this;
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe>& BasicSharedTypeStorage<ThreadSafe>::operator=(BasicSharedTypeStorage&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			m_Data = std::exchange(other.m_Data, nullptr);
+		}
+		return *this;
+	}
+
+	template <bool ThreadSafe>
+	template <typename T>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::Construct() requires std::is_default_constructible_v<T>
+	{
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource());
+	}
+
+	template <bool ThreadSafe>
+	template <typename T, typename ... Parameters>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::Construct(Parameters&&... parameters) requires (!StartsWithAllocatorArg<Parameters...>)
+	{
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource(), std::forward<Parameters>(parameters)...);
+	}
+
+	template <bool ThreadSafe>
+	template <typename T, typename ... Parameters>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::Construct(std::allocator_arg_t, std::pmr::memory_resource* resource, Parameters&&... parameters)
+	{
+		return ConstructInPlace(TypeId::Create<T>(), [&](void* data)
+			{
+				new (data) T(std::forward<Parameters>(parameters)...);
+			}, resource);
+	}
+
+	template <bool ThreadSafe>
+	template <typename T>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>
+	{
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource(), value);
+	}
+
+	template <bool ThreadSafe>
+	template <typename T>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::MoveConstruct(T&& value) requires std::is_move_constructible_v<T>
+	{
+		return Construct<T>(std::allocator_arg, std::pmr::get_default_resource(), std::move(value));
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::CopyConstruct(glas::TypeId id, const void* original, std::pmr::memory_resource* resource)
+	{
+		const auto copyConstructor = id.GetInfo().CopyConstructor;
+		assert(copyConstructor);
+
+		return ConstructInPlace(id, [copyConstructor, original](void* data) { copyConstructor(data, original); }, resource);
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::MoveConstruct(glas::TypeId id, void* original, std::pmr::memory_resource* resource)
+	{
+		const auto moveConstructor = id.GetInfo().MoveConstructor;
+		assert(moveConstructor);
+
+		return ConstructInPlace(id, [moveConstructor, original](void* data) { moveConstructor(data, original); }, resource);
+	}
+
+	template <bool ThreadSafe>
+	template <typename Constructor>
+	BasicSharedTypeStorage<ThreadSafe> BasicSharedTypeStorage<ThreadSafe>::ConstructInPlace(glas::TypeId id, Constructor&& constructor, std::pmr::memory_resource* resource)
+	{
+		const auto& info = id.GetInfo();
+
+		// the header is placed directly in front of the instance
+		const size_t offset = GetDataOffset(info.Align);
+		const size_t size = offset + info.Size;
+		const size_t align = std::max<size_t>(alignof(Header), info.Align);
+
+		uint8_t* memory = static_cast<uint8_t*>(resource->allocate(size, align));
+		void* data = memory + offset;
+
+		try
+		{
+			constructor(data);
+		}
+		catch (...)
+		{
+			resource->deallocate(memory, size, align);
+			throw;
+		}
+
+		Header* header = new (GetHeader(data)) Header{};
+		header->Info = &info;
+		header->Resource = resource;
+		header->Type = id;
+
+		BasicSharedTypeStorage storage;
+		storage.m_Data = data;
+		return storage;
+	}
+
+	template <bool ThreadSafe>
+	uint32_t BasicSharedTypeStorage<ThreadSafe>::GetUseCount() const
+	{
+		if (!m_Data)
+			return 0;
+
+		if constexpr (ThreadSafe)
+			return GetHeader()->StrongCount.load(std::memory_order_relaxed);
+		else
+			return GetHeader()->StrongCount;
+	}
+
+	template <bool ThreadSafe>
+	template <typename T>
+	T* BasicSharedTypeStorage<ThreadSafe>::As()
+	{
+		return (TypeId::Create<T>() == GetType()) ? static_cast<T*>(GetData()) : nullptr;
+	}
+
+	template <bool ThreadSafe>
+	void BasicSharedTypeStorage<ThreadSafe>::Release()
+	{
+		if (!m_Data)
+			return;
+
+		Header* header = GetHeader();
+		if (RemoveReference(header->StrongCount))
+		{
+			if (header->Info->Destructor)
+				header->Info->Destructor(m_Data);
+
+			ReleaseWeak(m_Data);
+		}
+
+		m_Data = nullptr;
+	}
+
+	template <bool ThreadSafe>
+	void BasicSharedTypeStorage<ThreadSafe>::AddReference(typename Header::Counter& counter)
+	{
+		if constexpr (ThreadSafe)
+			counter.fetch_add(1, std::memory_order_relaxed);
+		else
+			++counter;
+	}
+
+	template <bool ThreadSafe>
+	bool BasicSharedTypeStorage<ThreadSafe>::RemoveReference(typename Header::Counter& counter)
+	{
+		// the last owner must see every write of the other owners before it destroys the instance
+		if constexpr (ThreadSafe)
+			return counter.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		else
+			return --counter == 0;
+	}
+
+	template <bool ThreadSafe>
+	void BasicSharedTypeStorage<ThreadSafe>::ReleaseWeak(void* data)
+	{
+		Header* header = GetHeader(data);
+		if (RemoveReference(header->WeakCount))
+		{
+			const TypeInfo& info = *header->Info;
+			const size_t offset = GetDataOffset(info.Align);
+
+			header->Resource->deallocate(static_cast<uint8_t*>(data) - offset, offset + info.Size, std::max<size_t>(alignof(Header), info.Align));
+		}
+	}
+
+	/**
+	 * WEAK TYPE STORAGE
+	 */
+
+	template <bool ThreadSafe>
+	BasicWeakTypeStorage<ThreadSafe>::BasicWeakTypeStorage(const BasicSharedTypeStorage<ThreadSafe>& sharedStorage)
+		: m_Data{ sharedStorage.m_Data }
+	{
+		if (m_Data)
+			Shared::AddReference(Shared::GetHeader(m_Data)->WeakCount);
+	}
+
+	template <bool ThreadSafe>
+	BasicWeakTypeStorage<ThreadSafe>::~BasicWeakTypeStorage()
+	{
+		if (m_Data)
+			Shared::ReleaseWeak(m_Data);
+	}
+
+	template <bool ThreadSafe>
+	BasicWeakTypeStorage<ThreadSafe>::BasicWeakTypeStorage(const BasicWeakTypeStorage& other)
+		: m_Data{ other.m_Data }
+	{
+		if (m_Data)
+			Shared::AddReference(Shared::GetHeader(m_Data)->WeakCount);
+	}
+
+	template <bool ThreadSafe>
+	BasicWeakTypeStorage<ThreadSafe>::BasicWeakTypeStorage(BasicWeakTypeStorage&& other) noexcept
+		: m_Data{ std::exchange(other.m_Data, nullptr) }
+	{
+	}
+
+	template <bool ThreadSafe>
+	BasicWeakTypeStorage<ThreadSafe>& BasicWeakTypeStorage<ThreadSafe>::operator=(const BasicWeakTypeStorage& other)
+	{
+		BasicWeakTypeStorage copy{ other };
+		std::swap(m_Data, copy.m_Data);
+		return *this;
+	}
+
+	template <bool ThreadSafe>
+	BasicWeakTypeStorage<ThreadSafe>& BasicWeakTypeStorage<ThreadSafe>::operator=(BasicWeakTypeStorage&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (m_Data)
+				Shared::ReleaseWeak(m_Data);
+
+			m_Data = std::exchange(other.m_Data, nullptr);
+		}
+		return *this;
+	}
+
+	template <bool ThreadSafe>
+	BasicSharedTypeStorage<ThreadSafe> BasicWeakTypeStorage<ThreadSafe>::GetSharedStorage() const
+	{
+		if (!m_Data)
+			return {};
+
+		auto& strongCount = Shared::GetHeader(m_Data)->StrongCount;
+
+		// a reference is only added while the instance is still alive
+		if constexpr (ThreadSafe)
+		{
+			uint32_t count = strongCount.load(std::memory_order_relaxed);
+			do
+			{
+				if (count == 0)
+					return {};
+			} while (!strongCount.compare_exchange_weak(count, count + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+		}
+		else
+		{
+			if (strongCount == 0)
+				return {};
+			++strongCount;
+		}
+
+		Shared storage{};
+		storage.m_Data = m_Data;
+		return storage;
+	}
+
+	template <bool ThreadSafe>
+	bool BasicWeakTypeStorage<ThreadSafe>::Expired() const
+	{
+		if (!m_Data)
+			return true;
+
+		if constexpr (ThreadSafe)
+			return Shared::GetHeader(m_Data)->StrongCount.load(std::memory_order_acquire) == 0;
+		else
+			return Shared::GetHeader(m_Data)->StrongCount == 0;
+	}
+
+	/**
+	 * TYPE TUPLE
 	 */
 
 	/**
 	 * Structure of TypeTuple:
 	 *
 	 * Variable data jump table:
-	 *		First section is a jump table that maps to the variable data
+	 *		First section is a jump table with the offset of every variable from the start of the tuple
 	 * 
 	 * VariableIds information:
 	 *		Second section stores all the VariableIds
 	 *
 	 * m_Data Section
-	 *		Third section stores the variable data
+	 *		Third section stores the variable data, aligned to the largest alignment of the variables
+	 *
+	 * The first two sections are identical for every tuple with the same signature, they are computed once by the TypeTupleLayout.
 	 */
 
-	constexpr uint32_t GetOffset(uint32_t structAlign, uint32_t typeAlign, uint32_t currentOffset)
+	inline const TypeTupleLayout& TypeTupleLayout::Get(std::span<const VariableId> variables)
+	{
+		struct LayoutCache
+		{
+			std::shared_mutex														Mutex	{ };
+			std::unordered_multimap<uint64_t, std::unique_ptr<TypeTupleLayout>>		Layouts	{ };
+		};
+		static LayoutCache cache{};
+
+		const uint64_t signatureHash = GetSignatureHash(variables);
+
+		{
+			std::shared_lock lock{ cache.Mutex };
+			const auto [first, last] = cache.Layouts.equal_range(signatureHash);
+			for (auto it = first; it != last; ++it)
+			{
+				if (it->second->HasSignature(variables))
+					return *it->second;
+			}
+		}
+
+		std::unique_lock lock{ cache.Mutex };
+
+		// another thread could have added the layout while the lock was released
+		const auto [first, last] = cache.Layouts.equal_range(signatureHash);
+		for (auto it = first; it != last; ++it)
+		{
+			if (it->second->HasSignature(variables))
+				return *it->second;
+		}
+
+		auto layout = std::make_unique<TypeTupleLayout>();
+		layout->Compute(variables);
+		return *cache.Layouts.emplace(signatureHash, std::move(layout))->second;
+	}
+
+	inline VariableId TypeTupleLayout::GetStoredVariable(VariableId variable)
+	{
+		// because refs and rVal Refs cannot be stored, we store the whole variable instead
+		variable.RemoveReferenceFlag();
+		variable.RemoveRValReferenceFlag();
+		return variable;
+	}
+
+	inline uint64_t TypeTupleLayout::GetSignatureHash(std::span<const VariableId> variables)
+	{
+		uint64_t signatureHash{ 14695981039346656037ull };
+		for (const VariableId variable : variables)
+		{
+			signatureHash ^= GetStoredVariable(variable).GetHash();
+			signatureHash *= 1099511628211ull;
+		}
+		return signatureHash;
+	}
+
+	inline bool TypeTupleLayout::HasSignature(std::span<const VariableId> variables) const
 	{
-		return ((currentOffset % structAlign) + typeAlign > structAlign) ?
-			(currentOffset / structAlign + 1) * structAlign :
-			currentOffset;
+		if (variables.size() != Variables.size())
+			return false;
+
+		const auto* storedVariables = reinterpret_cast<const VariableId*>(Header.data() + variables.size() * sizeof(size_t));
+		for (size_t i{}; i < variables.size(); ++i)
+		{
+			if (!(storedVariables[i] == GetStoredVariable(variables[i])))
+				return false;
+		}
+		return true;
 	}
 
-	static_assert(GetOffset(8, 2, 8) == 8);
-	static_assert(GetOffset(8, 2, 10) == 10);
-	static_assert(GetOffset(8, 4, 10) == 10);
-	static_assert(GetOffset(8, 8, 8) == 8);
-	static_assert(GetOffset(8, 8, 9) == 16);
-	static_assert(GetOffset(8, 8, 17) == 24);
+	inline void TypeTupleLayout::Compute(std::span<const VariableId> variables)
+	{
+		const size_t jumpTableSize{ sizeof(size_t) * variables.size() };
+		const size_t headerSize{ jumpTableSize + sizeof(VariableId) * variables.size() };
+
+		Header.resize(headerSize);
+		Variables.resize(variables.size());
+		Align = alignof(size_t);
+		TriviallyCopyable = true;
+		TriviallyDestructible = true;
+
+		for (const VariableId variable : variables)
+		{
+			Align = std::max<size_t>(Align, GetStoredVariable(variable).GetAlign());
+		}
+
+		DataOffset = (headerSize + Align - 1) & ~(Align - 1);
+
+		size_t offset{ DataOffset };
+		for (size_t i{}; i < variables.size(); ++i)
+		{
+			const VariableId variable = GetStoredVariable(variables[i]);
+			const size_t align = variable.GetAlign();
+			offset = (offset + align - 1) & ~(align - 1);
+
+			Variable& entry = Variables[i];
+			entry.Offset = static_cast<uint32_t>(offset);
+			entry.Count = std::max<uint32_t>(variable.GetArraySize(), 1);
+
+			// pointers are stored as plain values and do not have to be constructed or destroyed
+			if (!variable.IsPointer())
+			{
+				entry.Info = &variable.GetTypeId().GetInfo();
+				TriviallyCopyable = TriviallyCopyable && entry.Info->TriviallyCopyable;
+				TriviallyDestructible = TriviallyDestructible && (entry.Info->TriviallyCopyable || !entry.Info->DestructN);
+			}
+
+			std::memcpy(Header.data() + i * sizeof(size_t), &offset, sizeof(size_t));
+			std::memcpy(Header.data() + jumpTableSize + i * sizeof(VariableId), &variable, sizeof(VariableId));
+
+			// every element of an array of pointers gets its own slot
+			offset += entry.Info ? variable.GetSize() : entry.Count * sizeof(void*);
+		}
+
+		Size = offset;
+	}
 
 	template <size_t Index, typename... Types>
 	void InitializeDataTupleCopy(TypeTuple& typeTuple, const std::tuple<Types...>& tuple)
@@ -433,734 +1125,2263 @@ namespace glas::Storage
 		}
 	}
 
-	template <size_t Index, typename... Types>
-	void InitializeDataTupleMove(TypeTuple& typeTuple, std::tuple<Types...>&& tuple)
+	template <size_t Index, typename... Types>
+	void InitializeDataTupleMove(TypeTuple& typeTuple, std::tuple<Types...>&& tuple)
+	{
+		using Type = std::remove_reference_t<std::tuple_element_t<Index, std::tuple<Types...>>>;
+
+		new (typeTuple.GetVoid(Index)) Type(std::move(std::get<Index>(tuple)));
+		
+		if constexpr (Index + 1 < sizeof...(Types))
+		{
+			InitializeDataTupleMove<Index + 1, Types...>(typeTuple, std::move(tuple));
+		}
+	}
+
+	template <size_t Index, typename T, typename ... Types>
+	void InitializeDataMove(TypeTuple& typeTuple, T&& val, Types&&... vals)
+	{
+		using Type = std::remove_reference_t<T>;
+
+		new (typeTuple.GetVoid(Index)) Type(std::forward<T>(val));
+
+		if constexpr (sizeof...(Types) > 0)
+		{
+			InitializeDataMove<Index + 1, Types...>(typeTuple, std::forward<Types>(vals)...);
+		}
+	}
+
+	inline TypeTuple::~TypeTuple()
+	{
+		DestroyVariables(m_Size);
+	}
+
+	inline TypeTuple::TypeTuple(const TypeTuple& other)
+		: TypeTuple{ other.Clone() }
+	{}
+
+	inline TypeTuple::TypeTuple(TypeTuple&& other) noexcept
+		: m_Data{ std::move(other.m_Data) }
+		, m_Layout{ other.m_Layout }
+		, m_Size{ other.m_Size }
+	{
+		other.m_Layout = nullptr;
+		other.m_Size = 0;
+	}
+
+	inline TypeTuple& TypeTuple::operator=(const TypeTuple& other)
+	{
+		if (this != &other)
+		{
+			*this = other.Clone(GetResource());
+		}
+		return *this;
+	}
+
+	inline TypeTuple& TypeTuple::operator=(TypeTuple&& other) noexcept
+	{
+		if (this != &other)
+		{
+			// the previous variables will be destroyed by the other tuple
+			std::swap(m_Data, other.m_Data);
+			std::swap(m_Layout, other.m_Layout);
+			std::swap(m_Size, other.m_Size);
+		}
+		return *this;
+	}
+
+	inline TypeTuple::TypeTuple(std::span<VariableId> variables, std::pmr::memory_resource* resource)
+		: m_Data{ resource }
+	{
+		Initialize(variables, true);
+	}
+
+	inline TypeTuple::TypeTuple(const TypeTupleLayout& layout, std::pmr::memory_resource* resource)
+		: m_Data{ resource }
+	{
+		Initialize(layout, true);
+	}
+
+	template <typename ... T>
+	TypeTuple::TypeTuple(const std::tuple<T...>& tuple)
+	{
+		Initialize(GetCachedLayout<T...>(), false);
+		InitializeDataTupleCopy<0, T...>(*this, tuple);
+	}
+
+	template <typename ... T>
+	TypeTuple::TypeTuple(std::tuple<T...>&& tuple)
+	{
+		Initialize(GetCachedLayout<T...>(), false);
+		InitializeDataTupleMove<0, T...>(*this, std::move(tuple));
+	}
+
+	template <typename ... T>
+	TypeTuple TypeTuple::Create()
+	{
+		if constexpr (sizeof...(T) != 0)
+		{
+			return TypeTuple{ GetCachedLayout<T...>() };
+		}
+		else
+		{
+			return {};
+		}
+	}
+
+	template <typename ... T>
+	TypeTuple TypeTuple::Create(T&&... val)
+	{
+		TypeTuple tuple;
+		tuple.Initialize(GetCachedLayout<T...>(), false);
+
+		InitializeDataMove<0, T...>(tuple, std::forward<T>(val)...);
+
+		return tuple;
+	}
+
+	template <typename ... T>
+	TypeTuple TypeTuple::CreateNoReferences()
+	{
+		// the reference flags are ignored by the layout
+		return Create<T...>();
+	}
+
+	template <typename ... T>
+	TypeTuple TypeTuple::CreateNoReferences(T&&... val)
+	{
+		return TypeTuple(std::tuple<std::remove_reference_t<T>...>(std::forward<T>(val)...));
+	}
+
+	template <typename ... T>
+	const TypeTupleLayout& TypeTuple::GetCachedLayout()
+	{
+		// the layout is looked up once per signature
+		static const TypeTupleLayout& layout = TypeTupleLayout::Get(GetVariableArray<T...>());
+		return layout;
+	}
+
+	inline TypeTuple TypeTuple::Clone(std::pmr::memory_resource* resource) const
+	{
+		TypeTuple tuple{};
+		tuple.m_Data = StorageBuffer{ resource };
+
+		if (!m_Layout)
+			return tuple;
+
+		const TypeTupleLayout& layout = *m_Layout;
+		tuple.m_Data = StorageBuffer{ layout.Size, layout.Align, resource };
+
+		// the header is copied from this tuple, so replaced VariableIds are kept
+		if (layout.TriviallyCopyable)
+		{
+			std::memcpy(tuple.m_Data.Get(), m_Data.Get(), layout.Size);
+		}
+		else
+		{
+			std::memcpy(tuple.m_Data.Get(), m_Data.Get(), layout.DataOffset);
+			std::memset(tuple.m_Data.Get() + layout.DataOffset, 0, layout.Size - layout.DataOffset);
+
+			for (size_t i{}; i < layout.Variables.size(); ++i)
+			{
+				const TypeTupleLayout::Variable& variable = layout.Variables[i];
+				void* destination = tuple.m_Data.Get() + variable.Offset;
+				const void* source = m_Data.Get() + variable.Offset;
+
+				if (!variable.Info)
+				{
+					std::memcpy(destination, source, variable.Count * sizeof(void*));
+					continue;
+				}
+
+				assert(variable.Info->CopyConstructN);
+				try
+				{
+					variable.Info->CopyConstructN(destination, source, variable.Count);
+				}
+				catch (...)
+				{
+					tuple.m_Layout = &layout;
+					tuple.DestroyVariables(i);
+					throw;
+				}
+			}
+		}
+
+		tuple.m_Layout = &layout;
+		tuple.m_Size = m_Size;
+		return tuple;
+	}
+
+	inline void TypeTuple::Reset()
+	{
+		if (!m_Layout)
+			return;
+
+		DestroyVariables(m_Size);
+		std::memset(GetVariableDataPtr(), 0, m_Layout->Size - m_Layout->DataOffset);
+		ConstructVariables();
+	}
+
+	inline VariableId TypeTuple::GetVariable(size_t index) const
+	{
+		return GetVariableIds()[index];
+	}
+
+	inline void TypeTuple::SetVariableUnsafe(size_t index, VariableId id)
+	{
+		GetVariableIds()[index] = id;
+	}
+
+	inline void TypeTuple::Initialize(std::span<VariableId> variables, bool InitializeToDefault)
+	{
+		for (auto& var : variables)
+		{
+			// because refs and rVal Refs cannot be stored, we store the whole variable instead
+			var.RemoveReferenceFlag();
+			var.RemoveRValReferenceFlag();
+		}
+
+		if (variables.empty())
+		{
+			m_Data.Reset();
+			m_Layout = nullptr;
+			m_Size = 0;
+			return;
+		}
+
+		Initialize(TypeTupleLayout::Get(variables), InitializeToDefault);
+	}
+
+	inline void TypeTuple::Initialize(const TypeTupleLayout& layout, bool InitializeToDefault)
+	{
+		// Allocate the memory and copy the precomputed jump table and variable ids
+		m_Data = StorageBuffer{ layout.Size, layout.Align, m_Data.GetResource() };
+		std::memcpy(m_Data.Get(), layout.Header.data(), layout.Header.size());
+		std::memset(m_Data.Get() + layout.Header.size(), 0, layout.Size - layout.Header.size());
+
+		m_Layout = &layout;
+		m_Size = static_cast<uint32_t>(layout.Variables.size());
+
+		// Initialize the types
+		if (InitializeToDefault)
+		{
+			ConstructVariables();
+		}
+	}
+
+	inline void TypeTuple::ConstructVariables()
+	{
+		for (size_t i{}; i < m_Layout->Variables.size(); ++i)
+		{
+			const TypeTupleLayout::Variable& variable = m_Layout->Variables[i];
+
+			// types that are not default constructible are left zero initialized
+			if (!variable.Info || !variable.Info->ConstructN)
+				continue;
+
+			try
+			{
+				variable.Info->ConstructN(m_Data.Get() + variable.Offset, variable.Count);
+			}
+			catch (...)
+			{
+				DestroyVariables(i);
+				m_Data.Reset();
+				m_Layout = nullptr;
+				m_Size = 0;
+				throw;
+			}
+		}
+	}
+
+	inline void TypeTuple::DestroyVariables(size_t count)
+	{
+		if (!m_Layout || m_Layout->TriviallyDestructible)
+			return;
+
+		for (size_t i{}; i < count; ++i)
+		{
+			const TypeTupleLayout::Variable& variable = m_Layout->Variables[i];
+			if (variable.Info && variable.Info->DestructN)
+			{
+				variable.Info->DestructN(m_Data.Get() + variable.Offset, variable.Count);
+			}
+		}
+	}
+
+	inline void* TypeTuple::GetVoid(size_t index) const
+	{
+		size_t offset;
+		std::memcpy(&offset, m_Data.Get() + index * sizeof(size_t), sizeof(size_t));
+		return m_Data.Get() + offset;
+	}
+
+	template <typename T>
+	T& TypeTuple::Get(size_t index)
+	{
+		assert(VariableId::Create<T>().GetTypeId() == GetVariableIds()[index].GetTypeId());
+		return *static_cast<std::remove_reference_t<T>*>(GetVoid(index));
+	}
+
+	template <typename T>
+	const T& TypeTuple::Get(size_t index) const
+	{
+		assert(VariableId::Create<T>().GetTypeId() == GetVariableIds()[index].GetTypeId());
+		return *static_cast<std::remove_reference_t<T>*>(GetVoid(index));
+	}
+
+	/**
+	 * TYPE VECTOR
+	 * TYPE VECTOR
+	 * TYPE VECTOR
+	 */
+
+	inline TypeVector::~TypeVector()
+	{
+		if (m_Data)
+		{
+			const auto destructor = m_ContainedType.GetInfo().DestructN;
+
+			assert(destructor);
+
+			destructor(Data(), Size());
+		}
+	}
+
+	inline TypeVector::TypeVector(const TypeVector& other)
+		: m_ContainedType	{ other.m_ContainedType }
+		, m_ElementSize		{ other.m_ElementSize }
+	{
+		if (other.m_ContainedType.IsValid())
+		{
+			const auto& info = m_ContainedType.GetInfo();
+			const auto copyConstructor = info.CopyConstructN;
+
+			assert(copyConstructor);
+
+			m_ElementSize = info.Size;
+
+			ReserveUninitialized(other.Size());
+
+			copyConstructor(Data(), other.Data(), other.Size());
+
+			m_Size = other.Size();
+		}
+	}
+
+	inline TypeVector::TypeVector(TypeVector&& other) noexcept
+		: m_ContainedType	{ other.m_ContainedType }
+		, m_Data			{ std::move(other.m_Data )}
+		, m_Size			{ other.m_Size }
+		, m_Capacity		{ other.m_Capacity }
+		, m_ElementSize		{ other.m_ElementSize }
+	{
+		other.m_Capacity = 0;
+		other.m_Size = 0;
+	}
+
+	inline TypeVector::TypeVector(TypeId type, size_t count, std::pmr::memory_resource* resource)
+		: m_ContainedType{ type }
+		, m_Data{ resource }
+	{
+		assert(type.IsValid());
+		assert(AssertType(type));
+
+		const auto& info = type.GetInfo();
+		const auto constructor = info.ConstructN;
+
+		assert(constructor);
+
+		m_ElementSize = info.Size;
+
+		ReserveUninitialized(count);
+
+		constructor(Data(), count);
+
+		m_Size = count;
+	}
+
+	inline TypeVector::TypeVector(size_t count, const TypeStorage& value)
+		: TypeVector(value.GetType(), count, value.GetData())
+	{}
+
+	inline TypeVector::TypeVector(TypeId type, size_t count, const void* value)
+		: m_ContainedType{ type }
+	{
+		assert(type.IsValid());
+		assert(value);
+		assert(AssertType(type));
+
+		const auto& info = type.GetInfo();
+		const auto copyConstructor = info.CopyConstructor;
+
+		assert(copyConstructor);
+
+		m_ElementSize = info.Size;
+
+		ReserveUninitialized(count);
+
+		m_Size = count;
+
+		for (auto& element : *this)
+		{
+			copyConstructor(element, value);
+		}
+	}
+
+	inline TypeVector::TypeVector(TypeId type, std::pmr::memory_resource* resource)
+		: m_ContainedType{ type }
+		, m_Data{ resource }
+		, m_ElementSize{ type.GetInfo().Size }
+	{
+		assert(type.IsValid());
+		assert(AssertType(type));
+	}
+
+	template <typename T>
+	TypeVector TypeVector::Create(std::pmr::memory_resource* resource)
+	{
+		return TypeVector{ TypeId::Create<T>(), resource };
+	}
+
+	template <typename T>
+	TypeVector TypeVector::Create(size_t count, std::pmr::memory_resource* resource)
+	{
+		return TypeVector{ TypeId::Create<T>(), count, resource };
+	}
+
+	template <typename T>
+	TypeVector::TypeVector(size_t count, const T& value)
+		: TypeVector(TypeId::Create<T>(), count, &value)
+	{}
+
+	template <typename T>
+	TypeVector::TypeVector(const std::vector<T>& vector) requires (!std::is_pointer_v<T>)
+		: m_ContainedType{ TypeId::Create<T>() }
+		, m_ElementSize{ sizeof(T) }
+	{
+		ReserveUninitialized(vector.size());
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto copyConstructor = info.CopyConstructor;
+
+		assert(copyConstructor);
+
+		for (size_t i{}; i < vector.Size(); ++i)
+		{
+			copyConstructor((*this)[i], &vector[i]);
+		}
+	}
+
+	template <typename T>
+	TypeVector::TypeVector(std::vector<T>&& vector) requires (!std::is_pointer_v<T>)
+		: m_ContainedType{ TypeId::Create<T>() }
+		, m_ElementSize{ sizeof(T) }
+	{
+		ReserveUninitialized(vector.size());
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto moveConstructor = info.MoveConstructor;
+
+		assert(moveConstructor);
+
+		for (size_t i{}; i < vector.Size(); ++i)
+		{
+			moveConstructor((*this)[i], &vector[i]);
+		}
+	}
+
+	template <typename T>
+	T& TypeVector::Get(size_t index)
+	{
+		assert(GetType() == TypeId::Create<T>());
+		return *static_cast<T*>((*this)[index]);
+	}
+
+	template <typename T>
+	const T& TypeVector::Get(size_t index) const
+	{
+		assert(GetType() == TypeId::Create<T>());
+		return *static_cast<const T*>((*this)[index]);
+	}
+
+	template <typename T>
+	T& TypeVector::PushBack()
+	{
+		assert(GetType() == TypeId::Create<T>());
+		auto address = PushBackUninitialized();
+
+		new (address) T();
+
+		return *static_cast<T*>(address);
+	}
+
+	template <typename T>
+	T& TypeVector::PushBack(const T& element)
+	{
+		assert(GetType() == TypeId::Create<T>());
+		auto address = PushBackUninitialized();
+
+		new (address) T(element);
+
+		return *static_cast<T*>(address);
+	}
+
+	template <typename T>
+	T& TypeVector::PushBack(T&& element)
+	{
+		assert(GetType() == TypeId::Create<T>());
+		auto address = PushBackUninitialized();
+
+		new (address) T(element);
+
+		return *static_cast<T*>(address);
+	}
+
+	//template <typename T>
+	//TypeVector::TypeVector(std::initializer_list<T> initializer)
+	//	: m_ContainedType{ TypeId::Create<T>() }
+	//	, m_ElementSize{ sizeof(T) }
+	//{
+	//	assert(AssertType(TypeId::Create<T>()));
+	//
+	//	ReserveUninitialized(initializer.size());
+	//
+	//	size_t index{};
+	//	for (auto& element : initializer)
+	//	{
+	//		*static_cast<T*>((*this)[index]) = element;
+	//		++index;
+	//	}
+	//}
+
+	inline TypeVector& TypeVector::operator=(const TypeVector& other)
+	{
+		if (&other != this)
+		{
+			if (m_Data)
+				Clear();
+
+			// the buffer is sized and aligned for the previous type
+			if (m_ContainedType.GetId() != other.m_ContainedType.GetId())
+			{
+				m_Data.Reset();
+				m_Capacity = 0;
+			}
+
+			m_ContainedType = other.m_ContainedType;
+			m_ElementSize = other.m_ElementSize;
+
+			if (m_ContainedType.IsValid())
+			{
+				const auto copyConstructor = m_ContainedType.GetInfo().CopyConstructN;
+
+				assert(copyConstructor);
+
+				Reserve(other.Size());
+				copyConstructor(Data(), other.Data(), other.Size());
+				m_Size = other.Size();
+			}
+		}
+		return *this;
+	}
+
+	inline TypeVector& TypeVector::operator=(TypeVector&& other) noexcept
+	{
+		if (&other != this)
+		{
+			if (m_Data)
+				Clear();
+
+			m_ContainedType		= other.m_ContainedType;
+			m_Data				= std::move(other.m_Data);
+			m_Capacity			= other.m_Capacity;
+			m_Size				= other.m_Size;
+			m_ElementSize		= other.m_ElementSize;
+
+			other.m_Capacity	= 0;
+			other.m_Size		= 0;
+		}
+		return *this;
+	}
+
+	inline const void* TypeVector::At(size_t index) const
+	{
+		if (index >= Size())
+			throw std::out_of_range("index out of range");
+
+		return ElementAddress(index);
+	}
+
+	inline void* TypeVector::At(size_t index)
+	{
+		if (index >= Size())
+			throw std::out_of_range("index out of range");
+
+		return ElementAddress(index);
+	}
+
+	inline const void* TypeVector::operator[](size_t index) const
+	{
+		assert(index < Size());
+		return ElementAddress(index);
+	}
+
+	inline void* TypeVector::operator[](size_t index)
+	{
+		assert(index < Size());
+		return ElementAddress(index);
+	}
+
+	inline void TypeVector::ShrinkToFit()
+	{
+		if (Capacity() > Size())
+		{
+			auto newBuffer = CreateNewBuffer(Size());
+			MoveToNewBuffer(newBuffer);
+			SetBuffer(std::move(newBuffer), Size());
+		}
+	}
+
+	inline void TypeVector::Reserve(size_t size)
+	{
+		if (size > Capacity())
+		{
+			auto newBuffer = CreateNewBuffer(size);
+			MoveToNewBuffer(newBuffer);
+			SetBuffer(std::move(newBuffer), size);
+		}
+	}
+
+	inline void* TypeVector::PushBack()
+	{
+		if (Size() >= Capacity())
+		{
+			ReserveZeroed(CalculateNewSize());
+		}
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto constructor = info.Constructor;
+
+		assert(constructor);
+
+		++m_Size;
+		void* back = Back();
+
+		constructor(back);
+		return back;
+	}
+
+	inline void* TypeVector::PushBackCopy(const void* data)
+	{
+		if (Size() >= Capacity())
+		{
+			ReserveZeroed(CalculateNewSize());
+		}
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto copyConstructor = info.CopyConstructor;
+
+		assert(copyConstructor);
+
+		++m_Size;
+		void* back = Back();
+
+		copyConstructor(back, data);
+		return back;
+	}
+
+	inline void* TypeVector::PushBackMove(void* data)
+	{
+		if (Size() >= Capacity())
+		{
+			ReserveZeroed(CalculateNewSize());
+		}
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto moveConstructor = info.MoveConstructor;
+
+		assert(moveConstructor);
+
+		++m_Size;
+		void* back = Back();
+
+		moveConstructor(back, data);
+		return back;
+	}
+
+	inline void* TypeVector::PushBackUninitialized()
+	{
+		if (Size() >= Capacity())
+		{
+			ReserveZeroed(CalculateNewSize());
+		}
+
+		++m_Size;
+
+		return Back();
+	}
+
+	inline void TypeVector::PopBack()
+	{
+		assert(Size() > 0);
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto destructor = info.Destructor;
+
+		assert(destructor);
+
+		destructor(Back());
+		--m_Size;
+	}
+
+	inline void TypeVector::PopBack(size_t amount)
+	{
+		assert(amount <= Size());
+
+		const auto& info = m_ContainedType.GetInfo();
+		const auto destructor = info.DestructN;
+
+		assert(destructor);
+
+		destructor(ElementAddress(Size() - amount), amount);
+		m_Size -= amount;
+	}
+
+	inline void TypeVector::Clear()
+	{
+		const auto& info = m_ContainedType.GetInfo();
+		const auto destructor = info.DestructN;
+
+		assert(destructor);
+
+		destructor(Data(), Size());
+		m_Size = 0;
+	}
+
+	inline void TypeVector::Resize(size_t size)
+	{
+		const auto& info = m_ContainedType.GetInfo();
+		const auto constructor = info.ConstructN;
+
+		assert(constructor);
+
+		const size_t originalSize = Size();
+
+		// shrinking destroys the removed elements in place and keeps the capacity
+		if (size < originalSize)
+		{
+			PopBack(originalSize - size);
+			return;
+		}
+
+		Reserve(size);
+		constructor(ElementAddress(originalSize), size - originalSize);
+
+		m_Size = size;
+	}
+
+	inline void TypeVector::ReserveZeroed(size_t size)
+	{
+		const size_t originalSize = Size();
+		ReserveUninitialized(size);
+
+		std::memset(ElementAddress(originalSize), 0, (size - originalSize) * ElementSize());
+	}
+
+	inline void TypeVector::ReserveUninitialized(size_t size)
+	{
+		if (size == Size())
+			return;
+
+		if (size < Size())
+		{
+			PopBack(Size() - size);
+		}
+
+		auto newBuffer = CreateNewBuffer(size);
+		MoveToNewBuffer(newBuffer);
+		SetBuffer(std::move(newBuffer), size);
+	}
+
+	inline void TypeVector::SwapRemove(size_t index)
+	{
+		const auto& info = m_ContainedType.GetInfo();
+
+		// the removed element is destroyed and the last element is moved into its place by copying its bytes
+		if (info.TriviallyRelocatable)
+		{
+			assert(index < Size());
+
+			if (info.Destructor)
+				info.Destructor(ElementAddress(index));
+
+			if (index != Size() - 1)
+				std::memcpy(ElementAddress(index), Back(), m_ElementSize);
+
+			--m_Size;
+			return;
+		}
+
+		const auto swap = info.Swap;
+
+		assert(swap);
+
+		if (index != Size() - 1)
+		{
+			swap((*this)[index], Back());
+		}
+
+		PopBack();
+	}
+
+	inline bool TypeVector::AssertType(TypeId id)
+	{
+		auto& info = id.GetInfo();
+		return info.MoveConstructor && info.Constructor;
+	}
+
+	inline void TypeVector::MoveToNewBuffer(StorageBuffer& buffer)
+	{
+		const auto& info = m_ContainedType.GetInfo();
+		const auto moveConstructor = info.MoveConstructN;
+		const auto destructor = info.DestructN;
+
+		if (info.TriviallyRelocatable)
+		{
+			if (Size())
+				std::memcpy(buffer.Get(), Data(), Size() * m_ElementSize);
+			return;
+		}
+
+		assert(moveConstructor);
+
+		moveConstructor(buffer.Get(), Data(), Size());
+		if (destructor)
+			destructor(Data(), Size());
+	}
+
+	inline StorageBuffer TypeVector::CreateNewBuffer(size_t size) const
+	{
+		return { size * m_ElementSize, m_ContainedType.GetInfo().Align, m_Data.GetResource() };
+	}
+
+	inline void TypeVector::SetBuffer(StorageBuffer&& buffer, size_t elementAmount)
+	{
+		m_Data = std::move(buffer);
+		m_Capacity = elementAmount;
+	}
+
+	inline void* TypeVector::ElementAddress(size_t index) const
+	{
+		return m_Data.Get() + index * m_ElementSize;
+	}
+
+	constexpr size_t TypeVector::CalculateNewSize() const
+	{
+		return (Size() + 1) * 3 / 2;
+	}
+
+	/**
+	 * POLYMORPHIC VECTOR
+	 */
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	template <typename T, typename ... Arguments>
+	T& PolymorphicVector<Base>::Emplace(Arguments&&... arguments) requires std::derived_from<T, Base>
+	{
+		Bucket& bucket = GetBucket(TypeId::Create<T>());
+
+		// constructed outside of the bucket, so that a throwing constructor leaves the bucket untouched
+		T object(std::forward<Arguments>(arguments)...);
+		T* result = static_cast<T*>(bucket.Objects.PushBackMove(&object));
+
+		++m_Size;
+		return *result;
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	Base* PolymorphicVector<Base>::Emplace(TypeId type)
+	{
+		Bucket& bucket = GetBucket(type);
+		void* object = bucket.Objects.PushBack();
+
+		++m_Size;
+		return static_cast<Base*>(VoidOffset(object, bucket.BaseOffset));
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	Base* PolymorphicVector<Base>::PushBackCopy(const Base& object)
+	{
+		// falling back to Base would slice the object
+		const TypeId dynamicType = GetTypeIDFromPolymorphic(&object);
+		if (!dynamicType.IsValid())
+			throw std::runtime_error("The dynamic type of the object is not registered");
+
+		Bucket& bucket = GetBucket(dynamicType);
+		const void* source = reinterpret_cast<const uint8_t*>(&object) - bucket.BaseOffset;
+		void* copy = bucket.Objects.PushBackCopy(source);
+
+		++m_Size;
+		return static_cast<Base*>(VoidOffset(copy, bucket.BaseOffset));
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	Base* PolymorphicVector<Base>::PushBackMove(Base& object)
+	{
+		// falling back to Base would slice the object
+		const TypeId dynamicType = GetTypeIDFromPolymorphic(&object);
+		if (!dynamicType.IsValid())
+			throw std::runtime_error("The dynamic type of the object is not registered");
+
+		Bucket& bucket = GetBucket(dynamicType);
+		void* source = reinterpret_cast<uint8_t*>(&object) - bucket.BaseOffset;
+		void* moved = bucket.Objects.PushBackMove(source);
+
+		++m_Size;
+		return static_cast<Base*>(VoidOffset(moved, bucket.BaseOffset));
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	void PolymorphicVector<Base>::Erase(Base* object)
+	{
+		TypeId dynamicType = GetTypeIDFromPolymorphic(object);
+		if (!dynamicType.IsValid())
+			dynamicType = TypeId::Create<Base>();
+
+		Bucket* bucket = FindBucket(dynamicType.GetInfo());
+		assert(bucket);
+
+		uint8_t* data = reinterpret_cast<uint8_t*>(object) - bucket->BaseOffset;
+		const size_t index = static_cast<size_t>(data - bucket->Objects.Data()) / bucket->Objects.ElementSize();
+		assert(index < bucket->Objects.Size());
+
+		const size_t last = bucket->Objects.Size() - 1;
+		if (index != last)
+		{
+			bucket->Info->Destructor(data);
+			bucket->Info->MoveConstructor(data, bucket->Objects.At(last));
+		}
+
+		bucket->Objects.PopBack();
+		--m_Size;
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	void PolymorphicVector<Base>::Clear()
+	{
+		for (Bucket& bucket : m_Buckets)
+		{
+			bucket.Objects.Clear();
+		}
+		m_Size = 0;
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	void PolymorphicVector<Base>::Reserve(TypeId type, size_t size)
+	{
+		GetBucket(type).Objects.Reserve(size);
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	template <typename Function>
+	void PolymorphicVector<Base>::ForEach(Function&& function)
+	{
+		for (Bucket& bucket : m_Buckets)
+		{
+			uint8_t* data = bucket.Objects.Data() + bucket.BaseOffset;
+			const size_t elementSize = bucket.Objects.ElementSize();
+			const size_t size = bucket.Objects.Size();
+
+			for (size_t i{}; i < size; ++i, data += elementSize)
+			{
+				function(*reinterpret_cast<Base*>(data));
+			}
+		}
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	template <typename T, typename Function>
+	void PolymorphicVector<Base>::ForEachOfType(Function&& function) requires std::derived_from<T, Base>
+	{
+		Bucket* bucket = FindBucket(TypeId::Create<T>().GetInfo());
+		if (!bucket)
+			return;
+
+		T* objects = reinterpret_cast<T*>(bucket->Objects.Data());
+		const size_t size = bucket->Objects.Size();
+
+		for (size_t i{}; i < size; ++i)
+		{
+			function(objects[i]);
+		}
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	template <typename ... Arguments>
+	void PolymorphicVector<Base>::CallMethod(FunctionId method, Arguments&&... arguments)
+	{
+		const FunctionInfo* methodInfo = method.GetInfo();
+		assert(methodInfo && methodInfo->IsMethod());
+		assert(methodInfo->ParameterTypes.size() == sizeof...(Arguments));
+
+		void* argumentArray[sizeof...(Arguments) + 1]{ const_cast<void*>(static_cast<const void*>(std::addressof(arguments)))... };
+
+		for (Bucket& bucket : m_Buckets)
+		{
+			const MethodTableEntry entry = ResolveMethod(*bucket.Info, *methodInfo);
+			if (!entry.Info)
+				continue;
+
+			const auto caller = entry.Info->ArgumentCaller;
+			assert(caller);
+
+			uint8_t* data = bucket.Objects.Data() + entry.SubjectOffset;
+			const size_t elementSize = bucket.Objects.ElementSize();
+			const size_t size = bucket.Objects.Size();
+
+			for (size_t i{}; i < size; ++i, data += elementSize)
+			{
+				caller(entry.FunctionAddress, data, argumentArray, nullptr);
+			}
+		}
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	size_t PolymorphicVector<Base>::Count(TypeId type) const
+	{
+		const Bucket* bucket = FindBucket(type.GetInfo());
+		return bucket ? bucket->Objects.Size() : 0;
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	typename PolymorphicVector<Base>::Bucket& PolymorphicVector<Base>::GetBucket(TypeId type)
+	{
+		const TypeInfo& info = type.GetInfo();
+		if (Bucket* bucket = FindBucket(info))
+			return *bucket;
+
+		const TypeInfo& baseInfo = TypeId::Create<Base>().GetInfo();
+		assert(IsA(info, baseInfo));
+		assert(info.MoveConstructor && info.Destructor);
+
+		Bucket& bucket = m_Buckets.emplace_back();
+		bucket.Info = &info;
+		bucket.Objects = TypeVector{ type, m_Resource };
+		bucket.BaseOffset = &info == &baseInfo ? 0 : info.AncestorOffsets[baseInfo.HierarchyIndex];
+		return bucket;
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	typename PolymorphicVector<Base>::Bucket* PolymorphicVector<Base>::FindBucket(const TypeInfo& info)
+	{
+		// there are usually only a few types, so a linear search over the buckets is the fastest
+		for (Bucket& bucket : m_Buckets)
+		{
+			if (bucket.Info == &info)
+				return &bucket;
+		}
+		return nullptr;
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	const typename PolymorphicVector<Base>::Bucket* PolymorphicVector<Base>::FindBucket(const TypeInfo& info) const
+	{
+		return const_cast<PolymorphicVector*>(this)->FindBucket(info);
+	}
+
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	MethodTableEntry PolymorphicVector<Base>::ResolveMethod(const TypeInfo& info, const FunctionInfo& method)
+	{
+		const TypeInfo& owner = method.OwningType.GetInfo();
+
+		const MethodTableEntry* result{};
+		const TypeInfo* resultOwner{};
+
+		for (const MethodTableEntry& entry : info.MethodTable)
+		{
+			if (entry.Info->TypesHash != method.TypesHash || entry.Info->Name != method.Name)
+				continue;
+
+			const TypeInfo& entryOwner = entry.Info->OwningType.GetInfo();
+			if (!IsA(entryOwner, owner))
+				continue;
+
+			// overrides of derived classes replace the methods of their base classes
+			if (!result || IsA(entryOwner, *resultOwner))
+			{
+				result = &entry;
+				resultOwner = &entryOwner;
+			}
+		}
+
+		return result ? *result : MethodTableEntry{};
+	}
+	/**
+	 * STRUCTURE OF ARRAYS VECTOR
+	 */
+
+	inline TypeSoAVector::TypeSoAVector(TypeId type, std::pmr::memory_resource* resource)
+		: m_Type{ type }
+		, m_Data{ resource }
+	{
+		assert(type.IsValid());
+
+		const TypeInfo& info = type.GetInfo();
+		if (info.Members.empty() && info.BaseClasses.empty())
+			m_Columns.emplace_back(std::string{}, &info, 0, info.Size, info.Align, 1);
+		else
+			AddColumns(info, {}, 0);
+
+		m_ColumnData.resize(m_Columns.size());
+	}
+
+	inline TypeSoAVector::TypeSoAVector(const TypeVector& vector, std::pmr::memory_resource* resource)
+		: TypeSoAVector{ vector.GetType(), resource }
+	{
+		Reserve(vector.Size());
+
+		for (size_t i{}; i < vector.Size(); ++i)
+		{
+			PushBack(vector[i]);
+		}
+	}
+
+	template <typename T>
+	TypeSoAVector TypeSoAVector::Create(std::pmr::memory_resource* resource)
+	{
+		return TypeSoAVector{ TypeId::Create<T>(), resource };
+	}
+
+	inline TypeSoAVector::~TypeSoAVector()
+	{
+		Clear();
+	}
+
+	inline TypeSoAVector::TypeSoAVector(const TypeSoAVector& other)
+		: m_Type{ other.m_Type }
+		, m_Columns{ other.m_Columns }
+		, m_ColumnData(other.m_ColumnData.size())
+	{
+		CopyRows(other);
+	}
+
+	inline TypeSoAVector::TypeSoAVector(TypeSoAVector&& other) noexcept
+		: m_Type{ other.m_Type }
+		, m_Columns{ std::move(other.m_Columns) }
+		, m_ColumnData{ std::move(other.m_ColumnData) }
+		, m_Data{ std::move(other.m_Data) }
+		, m_Size{ std::exchange(other.m_Size, 0) }
+		, m_Capacity{ std::exchange(other.m_Capacity, 0) }
+	{
+		other.m_ColumnData.clear();
+	}
+
+	inline TypeSoAVector& TypeSoAVector::operator=(const TypeSoAVector& other)
+	{
+		if (this != &other)
+		{
+			Clear();
+
+			// the buffer is laid out for the columns of the previous type
+			if (m_Type.GetId() != other.m_Type.GetId())
+			{
+				m_Type = other.m_Type;
+				m_Columns = other.m_Columns;
+				m_ColumnData.assign(m_Columns.size(), nullptr);
+				m_Data.Reset();
+				m_Capacity = 0;
+			}
+
+			CopyRows(other);
+		}
+		return *this;
+	}
+
+	inline TypeSoAVector& TypeSoAVector::operator=(TypeSoAVector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Clear();
+
+			m_Type			= other.m_Type;
+			m_Columns		= std::move(other.m_Columns);
+			m_ColumnData	= std::move(other.m_ColumnData);
+			m_Data			= std::move(other.m_Data);
+			m_Size			= std::exchange(other.m_Size, 0);
+			m_Capacity		= std::exchange(other.m_Capacity, 0);
+
+			other.m_ColumnData.clear();
+		}
+		return *this;
+	}
+
+	inline size_t TypeSoAVector::GetColumnIndex(std::string_view name) const
+	{
+		const auto it = std::ranges::find(m_Columns, name, &ColumnInfo::Name);
+		return it != m_Columns.end() ? static_cast<size_t>(it - m_Columns.begin()) : InvalidColumn;
+	}
+
+	inline void* TypeSoAVector::GetAddress(size_t column, size_t index)
+	{
+		assert(column < m_Columns.size() && index < m_Size);
+		return m_ColumnData[column] + index * m_Columns[column].Size;
+	}
+
+	inline const void* TypeSoAVector::GetAddress(size_t column, size_t index) const
+	{
+		assert(column < m_Columns.size() && index < m_Size);
+		return m_ColumnData[column] + index * m_Columns[column].Size;
+	}
+
+	template <typename T>
+	std::span<T> TypeSoAVector::Column(size_t column)
+	{
+		assert(AssertColumn<T>(column));
+		return { reinterpret_cast<T*>(m_ColumnData[column]), m_Size };
+	}
+
+	template <typename T>
+	std::span<const T> TypeSoAVector::Column(size_t column) const
+	{
+		assert(AssertColumn<T>(column));
+		return { reinterpret_cast<const T*>(m_ColumnData[column]), m_Size };
+	}
+
+	template <typename T>
+	std::span<T> TypeSoAVector::Column(std::string_view name)
+	{
+		const size_t column = GetColumnIndex(name);
+		assert(column != InvalidColumn && "The type has no registered member with this path");
+		return Column<T>(column);
+	}
+
+	template <typename T>
+	std::span<const T> TypeSoAVector::Column(std::string_view name) const
+	{
+		const size_t column = GetColumnIndex(name);
+		assert(column != InvalidColumn && "The type has no registered member with this path");
+		return Column<T>(column);
+	}
+
+	inline void TypeSoAVector::CopyTo(size_t index, void* instance) const
+	{
+		assert(index < m_Size);
+
+		for (size_t i{}; i < m_Columns.size(); ++i)
+		{
+			const ColumnInfo& column = m_Columns[i];
+			void* member = static_cast<uint8_t*>(instance) + column.Offset;
+			const void* value = GetAddress(i, index);
+
+			if (!column.Info || column.Info->TriviallyCopyable)
+			{
+				std::memcpy(member, value, column.Size);
+			}
+			else
+			{
+				// the member is replaced, there is no type erased copy assignment
+				if (column.Info->DestructN)
+					column.Info->DestructN(member, column.ArraySize);
+				column.Info->CopyConstructN(member, value, column.ArraySize);
+			}
+		}
+	}
+
+	inline TypeVector TypeSoAVector::ToTypeVector(std::pmr::memory_resource* resource) const
+	{
+		TypeVector vector{ m_Type, m_Size, resource };
+
+		for (size_t i{}; i < m_Size; ++i)
+		{
+			CopyTo(i, vector[i]);
+		}
+		return vector;
+	}
+
+	inline void TypeSoAVector::Reserve(size_t capacity)
+	{
+		if (capacity > m_Capacity)
+			MoveToNewBuffer(capacity);
+	}
+
+	inline void TypeSoAVector::PushBack()
+	{
+		// constructed as a whole so that the default member initializers are used
+		const TypeStorage instance{ m_Type };
+		PushBack(instance.GetData());
+	}
+
+	inline void TypeSoAVector::PushBack(const void* instance)
+	{
+		if (m_Size >= m_Capacity)
+			Reserve((m_Size + 1) * 3 / 2);
+
+		for (size_t i{}; i < m_Columns.size(); ++i)
+		{
+			try
+			{
+				CopyValues(i, m_ColumnData[i] + m_Size * m_Columns[i].Size, static_cast<const uint8_t*>(instance) + m_Columns[i].Offset, 1);
+			}
+			catch (...)
+			{
+				for (size_t j{}; j < i; ++j)
+				{
+					DestroyRange(j, m_Size, 1);
+				}
+				throw;
+			}
+		}
+		++m_Size;
+	}
+
+	template <typename T>
+	void TypeSoAVector::PushBack(const T& instance) requires (!std::is_pointer_v<T>)
+	{
+		assert(TypeId::Create<T>().GetId() == m_Type.GetId());
+		PushBack(static_cast<const void*>(std::addressof(instance)));
+	}
+
+	inline void TypeSoAVector::Erase(size_t index)
+	{
+		assert(index < m_Size);
+
+		for (size_t i{}; i < m_Columns.size(); ++i)
+		{
+			DestroyRange(i, index, 1);
+			Relocate(i, index, index + 1, m_Size - index - 1);
+		}
+		--m_Size;
+	}
+
+	inline void TypeSoAVector::SwapRemove(size_t index)
+	{
+		assert(index < m_Size);
+
+		for (size_t i{}; i < m_Columns.size(); ++i)
+		{
+			DestroyRange(i, index, 1);
+			if (index != m_Size - 1)
+				Relocate(i, index, m_Size - 1, 1);
+		}
+		--m_Size;
+	}
+
+	inline void TypeSoAVector::PopBack()
+	{
+		assert(m_Size > 0);
+
+		for (size_t i{}; i < m_Columns.size(); ++i)
+		{
+			DestroyRange(i, m_Size - 1, 1);
+		}
+		--m_Size;
+	}
+
+	inline void TypeSoAVector::Clear()
+	{
+		for (size_t i{}; i < m_Columns.size(); ++i)
+		{
+			DestroyRange(i, 0, m_Size);
+		}
+		m_Size = 0;
+	}
+
+	inline void TypeSoAVector::AddColumns(const TypeInfo& info, const std::string& prefix, uint32_t offset)
+	{
+		// the members of base classes are named as if they were members of the type itself
+		for (const BaseClassInfo& baseClass : info.BaseClasses)
+		{
+			AddColumns(baseClass.BaseId.GetInfo(), prefix, offset + baseClass.ClassOffset);
+		}
+
+		for (const MemberInfo& member : info.Members)
+		{
+			const VariableId& variable = member.Variable;
+			std::string name = prefix + member.Name;
+
+			assert(!variable.IsReference() && !variable.IsRValReference() && "Reference members can not be stored in columns");
+
+			if (variable.IsPointer())
+			{
+				m_Columns.emplace_back(std::move(name), nullptr, offset + member.Offset, member.Size, member.Align, 1);
+				continue;
+			}
+
+			const TypeInfo& memberInfo = variable.GetTypeId().GetInfo();
+			if (variable.GetArraySize() == 1 && (!memberInfo.Members.empty() || !memberInfo.BaseClasses.empty()))
+			{
+				AddColumns(memberInfo, name + '.', offset + member.Offset);
+				continue;
+			}
+
+			assert(memberInfo.CopyConstructN && "The type of the member is not registered");
+			m_Columns.emplace_back(std::move(name), &memberInfo, offset + member.Offset, member.Size, member.Align, variable.GetArraySize());
+		}
+	}
+
+	inline void TypeSoAVector::MoveToNewBuffer(size_t capacity)
 	{
-		using Type = std::remove_reference_t<std::tuple_element_t<Index, std::tuple<Types...>>>;
-
-		new (typeTuple.GetVoid(Index)) Type(std::move(std::get<Index>(tuple)));
-		
-		if constexpr (Index + 1 < sizeof...(Types))
+		// every column starts at an aligned offset of a single allocation
+		std::vector<size_t> offsets(m_Columns.size());
+		size_t bufferSize{};
+		size_t bufferAlign{ GLAS_STORAGE_SOA_COLUMN_ALIGN };
+		for (size_t i{}; i < m_Columns.size(); ++i)
 		{
-			InitializeDataTupleMove<Index + 1, Types...>(typeTuple, std::move(tuple));
+			const size_t align = std::max<size_t>(GLAS_STORAGE_SOA_COLUMN_ALIGN, m_Columns[i].Align);
+			bufferSize = (bufferSize + align - 1) / align * align;
+			offsets[i] = bufferSize;
+			bufferSize += capacity * m_Columns[i].Size;
+			bufferAlign = std::max(bufferAlign, align);
 		}
-	}
-
-	template <size_t Index, typename T, typename ... Types>
-	void InitializeDataMove(TypeTuple& typeTuple, T&& val, Types&&... vals)
-	{
-		using Type = std::remove_reference_t<T>;
 
-		new (typeTuple.GetVoid(Index)) Type(std::forward<T>(val));
+		StorageBuffer buffer{ bufferSize, bufferAlign, GetResource() };
 
-		if constexpr (sizeof...(Types) > 0)
+		for (size_t i{}; i < m_Columns.size(); ++i)
 		{
-			InitializeDataMove<Index + 1, Types...>(typeTuple, std::forward<Types>(vals)...);
+			const ColumnInfo& column = m_Columns[i];
+			uint8_t* destination = buffer.Get() + offsets[i];
+
+			if (m_Size)
+			{
+				if (!column.Info || column.Info->TriviallyRelocatable)
+				{
+					std::memcpy(destination, m_ColumnData[i], m_Size * column.Size);
+				}
+				else
+				{
+					assert(column.Info->MoveConstructN);
+					column.Info->MoveConstructN(destination, m_ColumnData[i], m_Size * column.ArraySize);
+					DestroyRange(i, 0, m_Size);
+				}
+			}
+			m_ColumnData[i] = destination;
 		}
+
+		m_Data = std::move(buffer);
+		m_Capacity = capacity;
 	}
 
-	inline TypeTuple::~TypeTuple()
+	inline void TypeSoAVector::CopyRows(const TypeSoAVector& other)
 	{
-		for (uint32_t i{}; i < m_Size; ++i)
+		assert(m_Size == 0);
+
+		Reserve(other.m_Size);
+
+		for (size_t i{}; i < m_Columns.size(); ++i)
 		{
-			VariableId id = GetVariable(i);
-			if (!id.IsRefOrPointer())
+			try
+			{
+				CopyValues(i, m_ColumnData[i], other.m_ColumnData[i], other.m_Size);
+			}
+			catch (...)
 			{
-				if (const auto destructor = id.GetTypeId().GetInfo().Destructor)
+				for (size_t j{}; j < i; ++j)
 				{
-					destructor(GetVoid(i));
+					DestroyRange(j, 0, other.m_Size);
 				}
+				throw;
 			}
 		}
+		m_Size = other.m_Size;
 	}
 
-	inline TypeTuple::TypeTuple(std::span<VariableId> variables)
+	inline void TypeSoAVector::CopyValues(size_t column, void* destination, const void* source, size_t count) const
 	{
-		Initialize(variables, true);
-	}
+		const ColumnInfo& info = m_Columns[column];
+		if (!info.Info)
+		{
+			if (count)
+				std::memcpy(destination, source, count * info.Size);
+			return;
+		}
 
-	template <typename ... T>
-	TypeTuple::TypeTuple(const std::tuple<T...>& tuple)
-	{
-		auto variables = GetVariableArray<T...>();
-		Initialize(variables, false);
-		InitializeDataTupleCopy<0, T...>(*this, tuple);
+		info.Info->CopyConstructN(destination, source, count * info.ArraySize);
 	}
 
-	template <typename ... T>
-	TypeTuple::TypeTuple(std::tuple<T...>&& tuple)
+	inline void TypeSoAVector::DestroyRange(size_t column, size_t index, size_t count)
 	{
-		auto variables = GetVariableArray<T...>();
-		Initialize(variables, false);
-		InitializeDataTupleMove<0, T...>(*this, std::move(tuple));
+		const ColumnInfo& info = m_Columns[column];
+		if (info.Info && info.Info->DestructN)
+			info.Info->DestructN(m_ColumnData[column] + index * info.Size, count * info.ArraySize);
 	}
 
-	template <typename ... T>
-	TypeTuple TypeTuple::Create()
+	inline void TypeSoAVector::Relocate(size_t column, size_t destination, size_t source, size_t count)
 	{
-		//GetVariableIdArray<T...>();
-		if constexpr (sizeof...(T) != 0)
+		const ColumnInfo& info = m_Columns[column];
+		uint8_t* data = m_ColumnData[column];
+
+		if (!info.Info || info.Info->TriviallyRelocatable)
 		{
-			auto variableArray = GetVariableArray<T...>();
-			const auto variables = std::span<VariableId>(variableArray.begin(), variableArray.end());
-			return { variables };
+			if (count)
+				std::memmove(data + destination * info.Size, data + source * info.Size, count * info.Size);
+			return;
 		}
-		else
+
+		// the values are moved one by one, the ranges can overlap when rows are shifted forward
+		assert(destination < source);
+		for (size_t i{}; i < count; ++i)
 		{
-			return {};
+			info.Info->MoveConstructN(data + (destination + i) * info.Size, data + (source + i) * info.Size, info.ArraySize);
+			DestroyRange(column, source + i, 1);
 		}
 	}
 
-	template <typename ... T>
-	TypeTuple TypeTuple::Create(T&&... val)
+	template <typename T>
+	bool TypeSoAVector::AssertColumn(size_t column) const
 	{
-		TypeTuple tuple;
-		auto variables = GetVariableArray<T...>();
-		tuple.Initialize(variables, false);
+		if (column >= m_Columns.size() || sizeof(T) != m_Columns[column].Size)
+			return false;
 
-		InitializeDataMove<0, T...>(tuple, std::forward<T>(val)...);
-
-		return tuple;
+		const TypeInfo* info = m_Columns[column].Info;
+		if constexpr (std::is_pointer_v<T>)
+			return !info;
+		else if constexpr (std::is_array_v<T>)
+			return info && info == &TypeId::Create<std::remove_all_extents_t<T>>().GetInfo();
+		else
+			return info && info == &TypeId::Create<T>().GetInfo();
 	}
+	/**
+	 * CHUNKED VECTOR
+	 */
 
-	template <typename ... T>
-	TypeTuple TypeTuple::CreateNoReferences()
+	inline TypeChunkedVector::TypeChunkedVector(TypeId type, std::pmr::memory_resource* resource)
+		: m_Type{ type }
+		, m_Info{ &type.GetInfo() }
+		, m_ChunkCapacity{ std::max<size_t>(GLAS_STORAGE_CHUNK_SIZE / std::max<size_t>(m_Info->Size, 1), 1) }
+		, m_Resource{ resource }
 	{
-		auto variableIds = glas::GetVariableArray<T...>();
-		for (auto& variable : variableIds)
-		{
-			variable.SetReferenceFlag(false);
-		}
-		return TypeTuple(variableIds);
+		assert(type.IsValid());
+		assert(m_Info->Size > 0);
 	}
 
-	template <typename ... T>
-	TypeTuple TypeTuple::CreateNoReferences(T&&... val)
+	template <typename T>
+	TypeChunkedVector TypeChunkedVector::Create(std::pmr::memory_resource* resource)
 	{
-		return TypeTuple(std::tuple<std::remove_reference_t<T>...>(std::forward<T>(val)...));
+		return TypeChunkedVector{ TypeId::Create<T>(), resource };
 	}
 
-	inline VariableId TypeTuple::GetVariable(size_t index) const
+	inline TypeChunkedVector::~TypeChunkedVector()
 	{
-		return GetVariableIds()[index];
+		Clear();
 	}
 
-	inline void TypeTuple::SetVariableUnsafe(size_t index, VariableId id)
+	inline TypeChunkedVector::TypeChunkedVector(TypeChunkedVector&& other) noexcept
+		: m_Type{ other.m_Type }
+		, m_Info{ other.m_Info }
+		, m_Chunks{ std::move(other.m_Chunks) }
+		, m_Occupied{ std::move(other.m_Occupied) }
+		, m_FreeSlots{ std::move(other.m_FreeSlots) }
+		, m_ChunkCapacity{ other.m_ChunkCapacity }
+		, m_Size{ std::exchange(other.m_Size, 0) }
+		, m_End{ std::exchange(other.m_End, 0) }
+		, m_Resource{ other.m_Resource }
 	{
-		GetVariableIds()[index] = id;
+		other.m_Chunks.clear();
+		other.m_Occupied.clear();
+		other.m_FreeSlots.clear();
 	}
 
-	inline uint32_t TypeTuple::CalculateAlignment(std::span<VariableId> variables) const
+	inline TypeChunkedVector& TypeChunkedVector::operator=(TypeChunkedVector&& other) noexcept
 	{
-		uint32_t maxAlign = 1;
-		for (auto& variable : variables)
+		if (this != &other)
 		{
-			maxAlign = std::max(variable.GetAlign(), maxAlign);
+			Clear();
+
+			m_Type			= other.m_Type;
+			m_Info			= other.m_Info;
+			m_Chunks		= std::move(other.m_Chunks);
+			m_Occupied		= std::move(other.m_Occupied);
+			m_FreeSlots		= std::move(other.m_FreeSlots);
+			m_ChunkCapacity	= other.m_ChunkCapacity;
+			m_Size			= std::exchange(other.m_Size, 0);
+			m_End			= std::exchange(other.m_End, 0);
+			m_Resource		= other.m_Resource;
+
+			other.m_Chunks.clear();
+			other.m_Occupied.clear();
+			other.m_FreeSlots.clear();
 		}
-		return maxAlign;
+		return *this;
 	}
 
-	inline void TypeTuple::Initialize(std::span<VariableId> variables, bool InitializeToDefault)
+	inline void* TypeChunkedVector::At(size_t index)
 	{
-		m_Size = static_cast<uint32_t>(variables.size());
-		const size_t jumpTableSize{ sizeof(void*) * variables.size() };
-		const size_t variableIdsSize{ sizeof(VariableId) * variables.size() };
-
-		// Get the max alignment of all the classes
-		const uint32_t structAlignment = CalculateAlignment(variables);
-
-		// Check the variables and calculate the final size of the data
-		uint32_t DataSize{};
-		for (auto& var : variables)
-		{
-			// because refs and rVal Refs cannot be stored, we store the while variable instead
-			var.RemoveReferenceFlag();
-			var.RemoveRValReferenceFlag();
-
-			DataSize = GetOffset(structAlignment, var.GetAlign(), DataSize) + var.GetSize();
-		}
-
-		// Allocate the memory
-		const size_t allocatedSize = DataSize + jumpTableSize + variableIdsSize;
-		m_Data = std::make_unique<uint8_t[]>(allocatedSize);
-		std::memset(m_Data.get(), 0, allocatedSize);
-
-		// Copy the variable Ids to the allocated variable id section
-		std::ranges::copy(variables, GetVariableIds().begin());
-		
-		// Populate the jump table
-		uint32_t accumulatedOffset{};
-		for (uint32_t i{}; i < variables.size(); ++i)
-		{
-			auto& var = variables[i];
-			accumulatedOffset = GetOffset(structAlignment, var.GetAlign(), accumulatedOffset);
-
-			reinterpret_cast<void**>(m_Data.get())[i] = VoidOffset(GetVariableDataPtr(), accumulatedOffset);
-
-			accumulatedOffset += var.GetSize();
-		}
-
-		// Initialize the types
-		if (InitializeToDefault)
-		{
-			for (uint32_t i{}; i < variables.size(); ++i)
-			{
-				auto& var = variables[i];
-
-				if (!var.IsPointer())
-				{
-					if (const auto constructor = var.GetTypeId().GetInfo().Constructor)
-					{
-						constructor(GetVoid(i));
-					}
-				}
-			}
-		}
+		assert(IsOccupied(index));
+		return SlotAddress(index);
 	}
 
-	inline void* TypeTuple::GetVoid(size_t index) const
+	inline const void* TypeChunkedVector::At(size_t index) const
 	{
-		return reinterpret_cast<void**>(m_Data.get())[index];
+		assert(IsOccupied(index));
+		return SlotAddress(index);
 	}
 
 	template <typename T>
-	T& TypeTuple::Get(size_t index)
+	T& TypeChunkedVector::Get(size_t index)
 	{
-		assert(VariableId::Create<T>().GetTypeId() == GetVariableIds()[index].GetTypeId());
-		return *static_cast<std::remove_reference_t<T>*>(reinterpret_cast<void**>(m_Data.get())[index]);
+		assert(TypeId::Create<T>().GetId() == m_Type.GetId());
+		return *static_cast<T*>(At(index));
 	}
 
 	template <typename T>
-	const T& TypeTuple::Get(size_t index) const
+	const T& TypeChunkedVector::Get(size_t index) const
 	{
-		assert(VariableId::Create<T>().GetTypeId() == GetVariableIds()[index].GetTypeId());
-		return *static_cast<std::remove_reference_t<T>*>(reinterpret_cast<void**>(m_Data.get())[index]);
+		assert(TypeId::Create<T>().GetId() == m_Type.GetId());
+		return *static_cast<const T*>(At(index));
 	}
 
-	/**
-	 * TYPE VECTOR
-	 * TYPE VECTOR
-	 * TYPE VECTOR
-	 */
-
-	inline TypeVector::~TypeVector()
+	inline bool TypeChunkedVector::IsOccupied(size_t index) const
 	{
-		if (m_Data)
-		{
-			const auto destructor = m_ContainedType.GetInfo().Destructor;
+		return index < m_End && (m_Occupied[index / 64] >> (index % 64) & 1);
+	}
 
-			assert(destructor);
+	inline size_t TypeChunkedVector::GetIndex(const void* element) const
+	{
+		const auto* address = static_cast<const uint8_t*>(element);
+		const size_t chunkSize = m_ChunkCapacity * m_Info->Size;
 
-			for (auto& element : *this)
+		for (size_t i{}; i < m_Chunks.size(); ++i)
+		{
+			const uint8_t* chunk = m_Chunks[i].Get();
+			if (address >= chunk && address < chunk + chunkSize)
 			{
-				destructor(element);
+				assert((address - chunk) % m_Info->Size == 0);
+				return i * m_ChunkCapacity + static_cast<size_t>(address - chunk) / m_Info->Size;
 			}
 		}
+
+		assert(false && "The element is not stored inside of this vector");
+		return m_End;
 	}
 
-	inline TypeVector::TypeVector(const TypeVector& other)
-		: m_ContainedType	{ other.m_ContainedType }
-		, m_ElementSize		{ other.m_ElementSize }
+	template <typename Function>
+	void TypeChunkedVector::ForEach(Function&& function)
 	{
-		if (other.m_ContainedType.IsValid())
-		{
-			const auto& info = m_ContainedType.GetInfo();
-			const auto copyConstructor = info.CopyConstructor;
-
-			assert(copyConstructor);
-
-			m_ElementSize = info.Size;
-
-			ReserveUninitialized(other.Size());
+		if (IsEmpty())
+			return;
 
-			m_Size = other.Size();
+		const size_t elementSize = m_Info->Size;
 
-			for (size_t i{}; i < other.Size(); ++i)
+		// the occupied bits are read a word at a time, so full chunks are visited without branching per slot
+		for (size_t word{}; word * 64 < m_End; ++word)
+		{
+			uint64_t bits = m_Occupied[word];
+			while (bits)
 			{
-				copyConstructor((*this)[i], other[i]);
+				const size_t index = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+				bits &= bits - 1;
+
+				function(static_cast<void*>(m_Chunks[index / m_ChunkCapacity].Get() + index % m_ChunkCapacity * elementSize));
 			}
 		}
 	}
 
-	inline TypeVector::TypeVector(TypeVector&& other) noexcept
-		: m_ContainedType	{ other.m_ContainedType }
-		, m_Data			{ std::move(other.m_Data )}
-		, m_Size			{ other.m_Size }
-		, m_Capacity		{ other.m_Capacity }
-		, m_ElementSize		{ other.m_ElementSize }
-	{
-		other.m_Capacity = 0;
-		other.m_Size = 0;
-	}
-
-	inline TypeVector::TypeVector(TypeId type, size_t count)
-		: m_ContainedType{ type }
+	inline void TypeChunkedVector::Reserve(size_t size)
 	{
-		assert(type.IsValid());
-		assert(AssertType(type));
-
-		const auto& info = type.GetInfo();
-		const auto constructor = info.Constructor;
-
-		assert(constructor);
-
-		m_ElementSize = info.Size;
-
-		ReserveUninitialized(count);
+		assert(m_Info);
 
-		m_Size = count;
+		const size_t chunkAlign = std::max<size_t>(GLAS_STORAGE_CHUNK_ALIGN, m_Info->Align);
 
-		for (auto& element : *this)
+		while (Capacity() < size)
 		{
-			constructor(element);
+			m_Chunks.emplace_back(m_ChunkCapacity * m_Info->Size, chunkAlign, m_Resource);
+			m_Occupied.resize((Capacity() + 63) / 64);
 		}
 	}
 
-	inline TypeVector::TypeVector(size_t count, const TypeStorage& value)
-		: TypeVector(value.GetType(), count, value.GetData())
-	{}
-
-	inline TypeVector::TypeVector(TypeId type, size_t count, const void* value)
-		: m_ContainedType{ type }
+	inline void TypeChunkedVector::ShrinkToFit()
 	{
-		assert(type.IsValid());
-		assert(value);
-		assert(AssertType(type));
-
-		const auto& info = type.GetInfo();
-		const auto copyConstructor = info.CopyConstructor;
-
-		assert(copyConstructor);
-
-		m_ElementSize = info.Size;
-
-		ReserveUninitialized(count);
-
-		m_Size = count;
-
-		for (auto& element : *this)
+		// erased slots inside of the freed chunks are dropped from the free list
+		size_t end = m_End;
+		while (end > 0 && !IsOccupied(end - 1))
 		{
-			copyConstructor(element, value);
+			--end;
 		}
+
+		const size_t chunkCount = (end + m_ChunkCapacity - 1) / m_ChunkCapacity;
+		m_Chunks.resize(chunkCount);
+		m_Occupied.resize((Capacity() + 63) / 64);
+		m_Occupied.shrink_to_fit();
+
+		std::erase_if(m_FreeSlots, [end](size_t slot) { return slot >= end; });
+		m_End = end;
 	}
 
-	inline TypeVector::TypeVector(TypeId type)
-		: m_ContainedType{ type }
-		, m_ElementSize{ type.GetInfo().Size }
+	inline void* TypeChunkedVector::PushBack()
 	{
-		assert(type.IsValid());
-		assert(AssertType(type));
+		assert(m_Info->Constructor);
+		return Construct([this](void* data) { m_Info->Constructor(data); });
 	}
 
-	template <typename T>
-	TypeVector TypeVector::Create()
+	inline void* TypeChunkedVector::PushBackCopy(const void* data)
 	{
-		return TypeVector{ TypeId::Create<T>() };
+		assert(m_Info->CopyConstructor);
+		return Construct([this, data](void* destination) { m_Info->CopyConstructor(destination, data); });
 	}
 
-	template <typename T>
-	TypeVector TypeVector::Create(size_t count)
+	inline void* TypeChunkedVector::PushBackMove(void* data)
 	{
-		return TypeVector{ TypeId::Create<T>(), count };
+		assert(m_Info->MoveConstructor);
+		return Construct([this, data](void* destination) { m_Info->MoveConstructor(destination, data); });
 	}
 
-	template <typename T>
-	TypeVector::TypeVector(size_t count, const T& value)
-		: TypeVector(TypeId::Create<T>(), count, &value)
-	{}
-
-	template <typename T>
-	TypeVector::TypeVector(const std::vector<T>& vector) requires (!std::is_pointer_v<T>)
-		: m_ContainedType{ TypeId::Create<T>() }
-		, m_ElementSize{ sizeof(T) }
+	template <typename T, typename... Arguments>
+	T& TypeChunkedVector::Emplace(Arguments&&... arguments)
 	{
-		ReserveUninitialized(vector.size());
+		assert(TypeId::Create<T>().GetId() == m_Type.GetId());
+		return *static_cast<T*>(Construct([&arguments...](void* data) { new (data) T(std::forward<Arguments>(arguments)...); }));
+	}
 
-		const auto& info = m_ContainedType.GetInfo();
-		const auto copyConstructor = info.CopyConstructor;
+	inline void TypeChunkedVector::Erase(size_t index)
+	{
+		assert(IsOccupied(index));
 
-		assert(copyConstructor);
+		if (m_Info->Destructor)
+			m_Info->Destructor(SlotAddress(index));
 
-		for (size_t i{}; i < vector.Size(); ++i)
-		{
-			copyConstructor((*this)[i], &vector[i]);
-		}
+		m_Occupied[index / 64] &= ~(uint64_t{ 1 } << (index % 64));
+		m_FreeSlots.emplace_back(index);
+		--m_Size;
 	}
 
-	template <typename T>
-	TypeVector::TypeVector(std::vector<T>&& vector) requires (!std::is_pointer_v<T>)
-		: m_ContainedType{ TypeId::Create<T>() }
-		, m_ElementSize{ sizeof(T) }
+	inline void TypeChunkedVector::Erase(const void* element)
 	{
-		ReserveUninitialized(vector.size());
-
-		const auto& info = m_ContainedType.GetInfo();
-		const auto moveConstructor = info.MoveConstructor;
-
-		assert(moveConstructor);
+		Erase(GetIndex(element));
+	}
 
-		for (size_t i{}; i < vector.Size(); ++i)
+	inline void TypeChunkedVector::Clear()
+	{
+		if (m_Info && m_Info->Destructor)
 		{
-			moveConstructor((*this)[i], &vector[i]);
+			const auto destructor = m_Info->Destructor;
+			ForEach([destructor](void* element) { destructor(element); });
 		}
-	}
 
-	template <typename T>
-	T& TypeVector::Get(size_t index)
-	{
-		assert(GetType() == TypeId::Create<T>());
-		return *static_cast<T*>((*this)[index]);
+		std::ranges::fill(m_Occupied, 0);
+		m_FreeSlots.clear();
+		m_Size = 0;
+		m_End = 0;
 	}
 
-	template <typename T>
-	const T& TypeVector::Get(size_t index) const
+	template <typename Function>
+	void* TypeChunkedVector::Construct(Function&& constructor)
 	{
-		assert(GetType() == TypeId::Create<T>());
-		return *static_cast<const T*>((*this)[index]);
+		// the slot is only taken once the constructor succeeded
+		const size_t index = GetFreeSlot();
+		void* data = SlotAddress(index);
+		constructor(data);
+		OccupySlot(index);
+		return data;
 	}
 
-	template <typename T>
-	T& TypeVector::PushBack()
+	inline size_t TypeChunkedVector::GetFreeSlot()
 	{
-		assert(GetType() == TypeId::Create<T>());
-		auto address = PushBackUninitialized();
-
-		new (address) T();
+		if (!m_FreeSlots.empty())
+			return m_FreeSlots.back();
 
-		return *static_cast<T*>(address);
+		Reserve(m_End + 1);
+		return m_End;
 	}
 
-	template <typename T>
-	T& TypeVector::PushBack(const T& element)
+	inline void TypeChunkedVector::OccupySlot(size_t index)
 	{
-		assert(GetType() == TypeId::Create<T>());
-		auto address = PushBackUninitialized();
+		if (!m_FreeSlots.empty() && m_FreeSlots.back() == index)
+			m_FreeSlots.pop_back();
+		else
+			++m_End;
+
+		m_Occupied[index / 64] |= uint64_t{ 1 } << (index % 64);
+		++m_Size;
+	}
 
-		new (address) T(element);
+	inline size_t TypeChunkedVector::FindOccupied(size_t index) const
+	{
+		while (index < m_End)
+		{
+			const uint64_t bits = m_Occupied[index / 64] >> (index % 64);
+			if (bits)
+				return index + static_cast<size_t>(std::countr_zero(bits));
 
-		return *static_cast<T*>(address);
+			index = (index / 64 + 1) * 64;
+		}
+		return m_End;
 	}
 
-	template <typename T>
-	T& TypeVector::PushBack(T&& element)
+	inline void* TypeChunkedVector::SlotAddress(size_t index) const
 	{
-		assert(GetType() == TypeId::Create<T>());
-		auto address = PushBackUninitialized();
+		return m_Chunks[index / m_ChunkCapacity].Get() + index % m_ChunkCapacity * m_Info->Size;
+	}
 
-		new (address) T(element);
+	/**
+	 * TYPE HASH MAP
+	 */
 
-		return *static_cast<T*>(address);
-	}
+	inline TypeHashMap::TypeHashMap(TypeId key, TypeId value, std::pmr::memory_resource* resource)
+		: m_KeyType{ key }
+		, m_ValueType{ value }
+		, m_KeyInfo{ &key.GetInfo() }
+		, m_ValueInfo{ &value.GetInfo() }
+		, m_Data{ resource }
+	{
+		assert(key.IsValid() && value.IsValid());
+		assert(m_KeyInfo->TriviallyComparable || IsComparable(*m_KeyInfo));
 
-	//template <typename T>
-	//TypeVector::TypeVector(std::initializer_list<T> initializer)
-	//	: m_ContainedType{ TypeId::Create<T>() }
-	//	, m_ElementSize{ sizeof(T) }
-	//{
-	//	assert(AssertType(TypeId::Create<T>()));
-	//
-	//	ReserveUninitialized(initializer.size());
-	//
-	//	size_t index{};
-	//	for (auto& element : initializer)
-	//	{
-	//		*static_cast<T*>((*this)[index]) = element;
-	//		++index;
-	//	}
-	//}
+		const size_t slotAlign = std::max(m_KeyInfo->Align, m_ValueInfo->Align);
+		m_ValueOffset = (m_KeyInfo->Size + m_ValueInfo->Align - 1) & ~(size_t{ m_ValueInfo->Align } - 1);
+		m_SlotSize = (m_ValueOffset + m_ValueInfo->Size + slotAlign - 1) & ~(slotAlign - 1);
+	}
 
-	inline TypeVector& TypeVector::operator=(const TypeVector& other)
+	template <typename Key, typename Value>
+	TypeHashMap TypeHashMap::Create(std::pmr::memory_resource* resource)
 	{
-		if (&other != this)
-		{
-			m_ContainedType = other.m_ContainedType;
-			m_ElementSize = other.m_ElementSize;
+		return TypeHashMap{ TypeId::Create<Key>(), TypeId::Create<Value>(), resource };
+	}
 
-			ReserveUninitialized(other.m_Size);
+	inline TypeHashMap::~TypeHashMap()
+	{
+		DestroyElements();
+	}
 
-			const auto& info = m_ContainedType.GetInfo();
-			const auto copyConstructor = info.CopyConstructor;
+	inline TypeHashMap::TypeHashMap(const TypeHashMap& other)
+		: TypeHashMap{ other, std::pmr::get_default_resource() }
+	{}
 
-			assert(copyConstructor);
+	inline TypeHashMap::TypeHashMap(const TypeHashMap& other, std::pmr::memory_resource* resource)
+		: m_KeyType{ other.m_KeyType }
+		, m_ValueType{ other.m_ValueType }
+		, m_KeyInfo{ other.m_KeyInfo }
+		, m_ValueInfo{ other.m_ValueInfo }
+		, m_Data{ resource }
+		, m_ValueOffset{ other.m_ValueOffset }
+		, m_SlotSize{ other.m_SlotSize }
+	{
+		if (other.m_Capacity)
+			CopyFrom(other);
+	}
+
+	inline TypeHashMap::TypeHashMap(TypeHashMap&& other) noexcept
+		: m_KeyType{ other.m_KeyType }
+		, m_ValueType{ other.m_ValueType }
+		, m_KeyInfo{ other.m_KeyInfo }
+		, m_ValueInfo{ other.m_ValueInfo }
+		, m_Data{ std::move(other.m_Data) }
+		, m_Capacity{ std::exchange(other.m_Capacity, 0) }
+		, m_Size{ std::exchange(other.m_Size, 0) }
+		, m_ErasedSlots{ std::exchange(other.m_ErasedSlots, 0) }
+		, m_SlotsOffset{ other.m_SlotsOffset }
+		, m_ValueOffset{ other.m_ValueOffset }
+		, m_SlotSize{ other.m_SlotSize }
+	{}
 
-			for (size_t i{}; i < Size(); ++i)
-			{
-				copyConstructor((*this)[i], other[i]);
-			}
+	inline TypeHashMap& TypeHashMap::operator=(const TypeHashMap& other)
+	{
+		if (this != &other)
+		{
+			*this = TypeHashMap{ other, GetResource() };
 		}
 		return *this;
 	}
 
-	inline TypeVector& TypeVector::operator=(TypeVector&& other) noexcept
+	inline TypeHashMap& TypeHashMap::operator=(TypeHashMap&& other) noexcept
 	{
-		if (&other != this)
+		if (this != &other)
 		{
-			m_ContainedType		= other.m_ContainedType;
-			m_Data				= std::move(other.m_Data);
-			m_Capacity			= other.m_Capacity;
-			m_Size				= other.m_Size;
-			m_ElementSize		= other.m_ElementSize;
-
-			other.m_Capacity	= 0;
-			other.m_Size		= 0;
+			// the previous elements will be destroyed by the other map
+			std::swap(m_KeyType, other.m_KeyType);
+			std::swap(m_ValueType, other.m_ValueType);
+			std::swap(m_KeyInfo, other.m_KeyInfo);
+			std::swap(m_ValueInfo, other.m_ValueInfo);
+			std::swap(m_Data, other.m_Data);
+			std::swap(m_Capacity, other.m_Capacity);
+			std::swap(m_Size, other.m_Size);
+			std::swap(m_ErasedSlots, other.m_ErasedSlots);
+			std::swap(m_SlotsOffset, other.m_SlotsOffset);
+			std::swap(m_ValueOffset, other.m_ValueOffset);
+			std::swap(m_SlotSize, other.m_SlotSize);
 		}
 		return *this;
 	}
 
-	inline const void* TypeVector::At(size_t index) const
+	inline void* TypeHashMap::Find(const void* key)
 	{
-		if (index >= Size())
-			throw std::out_of_range("index out of range");
-
-		return ElementAddress(index);
+		return const_cast<void*>(std::as_const(*this).Find(key));
 	}
 
-	inline void* TypeVector::At(size_t index)
+	inline const void* TypeHashMap::Find(const void* key) const
 	{
-		if (index >= Size())
-			throw std::out_of_range("index out of range");
+		if (IsEmpty())
+			return nullptr;
 
-		return ElementAddress(index);
+		const size_t slot = FindSlot(key, HashKey(key));
+		return slot != m_Capacity ? SlotValue(slot) : nullptr;
 	}
 
-	inline const void* TypeVector::operator[](size_t index) const
+	template <typename Value, typename Key>
+	Value* TypeHashMap::Find(const Key& key) requires (!std::is_pointer_v<Key>)
 	{
-		assert(index < Size());
-		return ElementAddress(index);
+		assert(TypeId::Create<Key>().GetId() == m_KeyType.GetId());
+		assert(TypeId::Create<Value>().GetId() == m_ValueType.GetId());
+		return static_cast<Value*>(Find(static_cast<const void*>(&key)));
 	}
 
-	inline void* TypeVector::operator[](size_t index)
+	template <typename Value, typename Key>
+	const Value* TypeHashMap::Find(const Key& key) const requires (!std::is_pointer_v<Key>)
 	{
-		assert(index < Size());
-		return ElementAddress(index);
+		assert(TypeId::Create<Key>().GetId() == m_KeyType.GetId());
+		assert(TypeId::Create<Value>().GetId() == m_ValueType.GetId());
+		return static_cast<const Value*>(Find(static_cast<const void*>(&key)));
 	}
 
-	inline void TypeVector::ShrinkToFit()
+	template <typename Key>
+	bool TypeHashMap::Contains(const Key& key) const requires (!std::is_pointer_v<Key>)
 	{
-		if (Capacity() > Size())
+		assert(TypeId::Create<Key>().GetId() == m_KeyType.GetId());
+		return Contains(static_cast<const void*>(&key));
+	}
+
+	template <typename Function>
+	void TypeHashMap::ForEach(Function&& function)
+	{
+		const uint8_t* control = GetControl();
+		for (size_t slot{}; slot < m_Capacity; ++slot)
 		{
-			auto newBuffer = CreateNewBuffer(Size());
-			MoveToNewBuffer(newBuffer);
-			SetBuffer(std::move(newBuffer), Size());
+			if (control[slot] & OccupiedSlot)
+				function(SlotKey(slot), SlotValue(slot));
 		}
 	}
 
-	inline void TypeVector::Reserve(size_t size)
+	template <typename Function>
+	void TypeHashMap::ForEach(Function&& function) const
 	{
-		if (size > Capacity())
+		const uint8_t* control = GetControl();
+		for (size_t slot{}; slot < m_Capacity; ++slot)
 		{
-			auto newBuffer = CreateNewBuffer(size);
-			MoveToNewBuffer(newBuffer);
-			SetBuffer(std::move(newBuffer), size);
+			if (control[slot] & OccupiedSlot)
+				function(static_cast<const void*>(SlotKey(slot)), static_cast<const void*>(SlotValue(slot)));
 		}
 	}
 
-	inline void* TypeVector::PushBack()
+	inline void TypeHashMap::Reserve(size_t size)
 	{
-		if (Size() >= Capacity())
+		size_t capacity = std::max<size_t>(m_Capacity, GLAS_STORAGE_HASH_MAP_MIN_CAPACITY);
+		while (size * 8 > capacity * 7)
 		{
-			ReserveZeroed(CalculateNewSize());
+			capacity *= 2;
 		}
 
-		const auto& info = m_ContainedType.GetInfo();
-		const auto constructor = info.Constructor;
-
-		assert(constructor);
+		if (size && capacity > m_Capacity)
+			Rehash(capacity);
+	}
 
-		++m_Size;
-		void* back = Back();
+	inline std::pair<void*, bool> TypeHashMap::Insert(const void* key, const void* value)
+	{
+		assert(m_KeyInfo->CopyConstructor && m_ValueInfo->CopyConstructor);
 
-		constructor(back);
-		return back;
+		return Emplace(key,
+			[this, key](void* location) { m_KeyInfo->CopyConstructor(location, key); },
+			[this, value](void* location) { m_ValueInfo->CopyConstructor(location, value); });
 	}
 
-	inline void* TypeVector::PushBackCopy(const void* data)
+	inline std::pair<void*, bool> TypeHashMap::InsertMove(void* key, void* value)
 	{
-		if (Size() >= Capacity())
-		{
-			ReserveZeroed(CalculateNewSize());
-		}
+		assert(m_KeyInfo->MoveConstructor && m_ValueInfo->MoveConstructor);
 
-		const auto& info = m_ContainedType.GetInfo();
-		const auto copyConstructor = info.CopyConstructor;
+		return Emplace(key,
+			[this, key](void* location) { m_KeyInfo->MoveConstructor(location, key); },
+			[this, value](void* location) { m_ValueInfo->MoveConstructor(location, value); });
+	}
 
-		assert(copyConstructor);
+	template <typename Key, typename Value>
+	std::pair<Value*, bool> TypeHashMap::Insert(const Key& key, const Value& value) requires (!std::is_pointer_v<Key> && !std::is_pointer_v<Value>)
+	{
+		assert(TypeId::Create<Key>().GetId() == m_KeyType.GetId());
+		assert(TypeId::Create<Value>().GetId() == m_ValueType.GetId());
 
-		++m_Size;
-		void* back = Back();
+		const auto [address, inserted] = Emplace(&key,
+			[&key](void* location) { new (location) Key(key); },
+			[&value](void* location) { new (location) Value(value); });
 
-		copyConstructor(back, data);
-		return back;
+		return { static_cast<Value*>(address), inserted };
 	}
 
-	inline void* TypeVector::PushBackMove(void* data)
+	inline void* TypeHashMap::FindOrInsert(const void* key)
 	{
-		if (Size() >= Capacity())
-		{
-			ReserveZeroed(CalculateNewSize());
-		}
+		assert(m_KeyInfo->CopyConstructor && m_ValueInfo->Constructor);
 
-		const auto& info = m_ContainedType.GetInfo();
-		const auto moveConstructor = info.MoveConstructor;
+		return Emplace(key,
+			[this, key](void* location) { m_KeyInfo->CopyConstructor(location, key); },
+			[this](void* location) { m_ValueInfo->Constructor(location); }).first;
+	}
 
-		assert(moveConstructor);
+	inline bool TypeHashMap::Erase(const void* key)
+	{
+		if (IsEmpty())
+			return false;
 
-		++m_Size;
-		void* back = Back();
+		const size_t slot = FindSlot(key, HashKey(key));
+		if (slot == m_Capacity)
+			return false;
 
-		moveConstructor(back, data);
-		return back;
-	}
+		if (m_KeyInfo->Destructor)
+			m_KeyInfo->Destructor(SlotKey(slot));
+		if (m_ValueInfo->Destructor)
+			m_ValueInfo->Destructor(SlotValue(slot));
 
-	inline void* TypeVector::PushBackUninitialized()
-	{
-		if (Size() >= Capacity())
+		// no probe has to pass a slot that is followed by an empty slot, so it can be emptied instead of marked as erased
+		uint8_t* control = GetControl();
+		if (control[(slot + 1) & (m_Capacity - 1)] == EmptySlot)
 		{
-			ReserveZeroed(CalculateNewSize());
+			control[slot] = EmptySlot;
+		}
+		else
+		{
+			control[slot] = ErasedSlot;
+			++m_ErasedSlots;
 		}
 
-		++m_Size;
-
-		return Back();
+		--m_Size;
+		return true;
 	}
 
-	inline void TypeVector::PopBack()
+	template <typename Key>
+	bool TypeHashMap::Erase(const Key& key) requires (!std::is_pointer_v<Key>)
 	{
-		assert(Size() > 0);
+		assert(TypeId::Create<Key>().GetId() == m_KeyType.GetId());
+		return Erase(static_cast<const void*>(&key));
+	}
 
-		const auto& info = m_ContainedType.GetInfo();
-		const auto destructor = info.Destructor;
+	inline void TypeHashMap::Clear()
+	{
+		DestroyElements();
 
-		assert(destructor);
+		if (m_Capacity)
+			std::memset(GetControl(), EmptySlot, m_Capacity);
 
-		destructor(Back());
-		--m_Size;
+		m_Size = 0;
+		m_ErasedSlots = 0;
 	}
 
-	inline void TypeVector::PopBack(size_t amount)
+	inline size_t TypeHashMap::HashKey(const void* key) const
 	{
-		assert(Size() - amount > 0);
+		// std::hash of integers returns the integer itself, so the hash is mixed before the slot is taken from its low bits
+		return m_KeyInfo->TriviallyComparable ?
+			HashBytes(key, m_KeyInfo->Size) :
+			static_cast<size_t>(MixHash(m_KeyInfo->Hash(key)));
+	}
 
-		const auto& info = m_ContainedType.GetInfo();
-		const auto destructor = info.Destructor;
+	inline bool TypeHashMap::KeysEqual(const void* lhs, const void* rhs) const
+	{
+		return m_KeyInfo->TriviallyComparable ?
+			std::memcmp(lhs, rhs, m_KeyInfo->Size) == 0 :
+			m_KeyInfo->Equals(lhs, rhs);
+	}
 
-		assert(destructor);
+	inline size_t TypeHashMap::FindSlot(const void* key, size_t hash) const
+	{
+		const uint8_t* control = GetControl();
+		const uint8_t keyControl = ControlByte(hash);
+		const size_t mask = m_Capacity - 1;
 
-		for (size_t i{ Size() - amount }; i < Size(); ++i)
+		for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
 		{
-			destructor((*this)[i]);
+			if (control[slot] == EmptySlot)
+				return m_Capacity;
+
+			if (control[slot] == keyControl && KeysEqual(SlotKey(slot), key))
+				return slot;
 		}
-		m_Size -= amount;
 	}
 
-	inline void TypeVector::Clear()
+	inline size_t TypeHashMap::FindFreeSlot(size_t hash) const
 	{
-		const auto& info = m_ContainedType.GetInfo();
-		const auto destructor = info.Destructor;
-
-		assert(destructor);
+		const uint8_t* control = GetControl();
+		const size_t mask = m_Capacity - 1;
 
-		for (auto& element : *this)
+		size_t slot = hash & mask;
+		while (control[slot] & OccupiedSlot)
 		{
-			destructor(element);
+			slot = (slot + 1) & mask;
 		}
-		m_Size = 0;
+		return slot;
 	}
 
-	inline void TypeVector::Resize(size_t size)
+	template <typename KeyConstructor, typename ValueConstructor>
+	std::pair<void*, bool> TypeHashMap::Emplace(const void* key, KeyConstructor&& constructKey, ValueConstructor&& constructValue)
 	{
-		const auto& info = m_ContainedType.GetInfo();
-		const auto& constructor = info.Constructor;
+		assert(m_KeyInfo);
 
-		const size_t originalSize = Size();
+		const size_t hash = HashKey(key);
+		if (m_Size)
+		{
+			const size_t slot = FindSlot(key, hash);
+			if (slot != m_Capacity)
+				return { SlotValue(slot), false };
+		}
 
-		ReserveUninitialized(size);
+		// erased slots count towards the load, they are dropped by the rehash
+		if ((m_Size + m_ErasedSlots + 1) * 8 > m_Capacity * 7)
+		{
+			// the map only grows when it would be more than half full, otherwise the rehash only removes the erased slots
+			size_t capacity = std::max<size_t>(m_Capacity, GLAS_STORAGE_HASH_MAP_MIN_CAPACITY);
+			while ((m_Size + 1) * 16 > capacity * 7)
+			{
+				capacity *= 2;
+			}
+			Rehash(capacity);
+		}
 
-		m_Size = size;
+		const size_t slot = FindFreeSlot(hash);
 
-		for (size_t i{ originalSize }; i < size; ++i)
+		constructKey(SlotKey(slot));
+		try
 		{
-			constructor((*this)[i]);
+			constructValue(SlotValue(slot));
+		}
+		catch (...)
+		{
+			if (m_KeyInfo->Destructor)
+				m_KeyInfo->Destructor(SlotKey(slot));
+			throw;
 		}
-	}
 
-	inline void TypeVector::ReserveZeroed(size_t size)
-	{
-		const size_t originalSize = Size();
-		ReserveUninitialized(size);
+		uint8_t& control = GetControl()[slot];
+		if (control == ErasedSlot)
+			--m_ErasedSlots;
 
-		std::memset(ElementAddress(originalSize), 0, (size - originalSize) * ElementSize());
+		control = ControlByte(hash);
+		++m_Size;
+
+		return { SlotValue(slot), true };
 	}
 
-	inline void TypeVector::ReserveUninitialized(size_t size)
+	inline void TypeHashMap::Rehash(size_t capacity)
 	{
-		if (size == Size())
-			return;
+		assert(std::has_single_bit(capacity));
+		assert(m_Size * 8 <= capacity * 7);
 
-		if (size < Size())
-		{
-			PopBack(Size() - size);
-		}
+		const size_t slotAlign = std::max(m_KeyInfo->Align, m_ValueInfo->Align);
+		const size_t slotsOffset = (capacity + slotAlign - 1) & ~(slotAlign - 1);
 
-		auto newBuffer = CreateNewBuffer(size);
-		MoveToNewBuffer(newBuffer);
-		SetBuffer(std::move(newBuffer), size);
-	}
+		StorageBuffer previousData{ std::move(m_Data) };
+		const size_t previousCapacity = m_Capacity;
+		const size_t previousSlotsOffset = m_SlotsOffset;
 
-	inline void TypeVector::SwapRemove(size_t index)
-	{
-		const auto& info = m_ContainedType.GetInfo();
-		const auto swap = info.Swap;
+		m_Data = StorageBuffer{ slotsOffset + capacity * m_SlotSize, slotAlign, previousData.GetResource() };
+		std::memset(m_Data.Get(), EmptySlot, capacity);
 
-		assert(swap);
+		m_Capacity = capacity;
+		m_SlotsOffset = slotsOffset;
+		m_ErasedSlots = 0;
 
-		if (index != Size() - 1)
+		const uint8_t* previousControl = previousData.Get();
+		for (size_t i{}; i < previousCapacity; ++i)
 		{
-			swap((*this)[index], Back());
-		}
+			if (!(previousControl[i] & OccupiedSlot))
+				continue;
 
-		PopBack();
-	}
+			uint8_t* previousSlot = previousData.Get() + previousSlotsOffset + i * m_SlotSize;
+			const size_t hash = HashKey(previousSlot);
+			const size_t slot = FindFreeSlot(hash);
 
-	inline bool TypeVector::AssertType(TypeId id)
-	{
-		auto& info = id.GetInfo();
-		return info.MoveConstructor && info.Constructor;
+			GetControl()[slot] = ControlByte(hash);
+			Relocate(*m_KeyInfo, SlotKey(slot), previousSlot);
+			Relocate(*m_ValueInfo, SlotValue(slot), previousSlot + m_ValueOffset);
+		}
 	}
 
-	inline void TypeVector::MoveToNewBuffer(std::unique_ptr<uint8_t[]>& buffer)
+	inline void TypeHashMap::CopyFrom(const TypeHashMap& other)
 	{
-		const auto& info = m_ContainedType.GetInfo();
-		const auto moveConstructor = info.MoveConstructor;
+		assert(m_KeyInfo->CopyConstructor && m_ValueInfo->CopyConstructor);
 
-		assert(moveConstructor);
+		// the copy keeps the capacity and erased slots of the other map, so every element stays in the same slot
+		m_Data = StorageBuffer{ other.m_Data.GetSize(), other.m_Data.GetAlign(), GetResource() };
+		m_Capacity = other.m_Capacity;
+		m_SlotsOffset = other.m_SlotsOffset;
+		m_ErasedSlots = other.m_ErasedSlots;
 
-		for (size_t i{}; i < Size(); ++i)
+		if (m_KeyInfo->TriviallyCopyable && m_ValueInfo->TriviallyCopyable)
 		{
-			const size_t elementOffset = i * m_ElementSize;
-			moveConstructor(buffer.get() + elementOffset, Data() + elementOffset);
+			std::memcpy(m_Data.Get(), other.m_Data.Get(), other.m_Data.GetSize());
+			m_Size = other.m_Size;
+			return;
 		}
-	}
 
-	inline std::unique_ptr<uint8_t[]> TypeVector::CreateNewBuffer(size_t size) const
-	{
-		return std::make_unique<uint8_t[]>(size * m_ElementSize);
-	}
+		// the control bytes are set after the slot is copied, so the copied slots can be destroyed if a copy throws
+		std::memset(GetControl(), EmptySlot, m_Capacity);
 
-	inline void TypeVector::SetBuffer(std::unique_ptr<uint8_t[]>&& buffer, size_t elementAmount)
-	{
-		m_Data = std::move(buffer);
-		m_Capacity = elementAmount;
+		const uint8_t* otherControl = other.GetControl();
+		try
+		{
+			for (size_t slot{}; slot < m_Capacity; ++slot)
+			{
+				if (otherControl[slot] & OccupiedSlot)
+				{
+					m_KeyInfo->CopyConstructor(SlotKey(slot), other.SlotKey(slot));
+					try
+					{
+						m_ValueInfo->CopyConstructor(SlotValue(slot), other.SlotValue(slot));
+					}
+					catch (...)
+					{
+						if (m_KeyInfo->Destructor)
+							m_KeyInfo->Destructor(SlotKey(slot));
+						throw;
+					}
+					++m_Size;
+				}
+
+				GetControl()[slot] = otherControl[slot];
+			}
+		}
+		catch (...)
+		{
+			DestroyElements();
+			m_Data.Reset();
+			m_Capacity = 0;
+			m_Size = 0;
+			m_ErasedSlots = 0;
+			throw;
+		}
 	}
 
-	inline void* TypeVector::ElementAddress(size_t index) const
+	inline void TypeHashMap::DestroyElements()
 	{
-		return m_Data.get() + index * m_ElementSize;
+		if (!m_Size)
+			return;
+
+		const auto keyDestructor = m_KeyInfo->TriviallyCopyable ? nullptr : m_KeyInfo->Destructor;
+		const auto valueDestructor = m_ValueInfo->TriviallyCopyable ? nullptr : m_ValueInfo->Destructor;
+		if (!keyDestructor && !valueDestructor)
+			return;
+
+		const uint8_t* control = GetControl();
+		for (size_t slot{}; slot < m_Capacity; ++slot)
+		{
+			if (control[slot] & OccupiedSlot)
+			{
+				if (keyDestructor)
+					keyDestructor(SlotKey(slot));
+				if (valueDestructor)
+					valueDestructor(SlotValue(slot));
+			}
+		}
 	}
 
-	constexpr size_t TypeVector::CalculateNewSize() const
+	inline void TypeHashMap::Relocate(const TypeInfo& info, void* destination, void* source)
 	{
-		return (Size() + 1) * 3 / 2;
+		if (info.TriviallyRelocatable)
+		{
+			std::memcpy(destination, source, info.Size);
+		}
+		else
+		{
+			assert(info.MoveConstructor);
+			info.MoveConstructor(destination, source);
+			if (info.Destructor)
+				info.Destructor(source);
+		}
 	}
 }
 
@@ -4,9 +4,18 @@
 
 #include <span>
 #include <tuple>
+#include <atomic>
+#include <string>
+#include <vector>
 #include <memory>
+#include <limits>
+#include <cstddef>
+#include <concepts>
 #include <iterator>
+#include <functional>
 #include <type_traits>
+#include <string_view>
+#include <memory_resource>
 #include <initializer_list>
 
 #include "../glas_decl.h"
@@ -30,6 +39,9 @@ namespace glas::Storage
 
 	template <typename T>
 	concept Swappable = STDSwappable<T> || AlternativeSwappable<T>;
+
+	template <typename T>
+	concept Hashable = requires(const T & value) { { std::hash<T>{}(value) } -> std::convertible_to<size_t>; };
 }
 
 /**
@@ -52,6 +64,42 @@ namespace glas::Storage
 
 	template <typename T>
 	inline constexpr bool EnableSwapping = Swappable<T>;
+
+	/**
+	 * Types without std::hash are hashed as bytes if they are trivially comparable.
+	 * Types with their own operator== must also provide std::hash, a byte hash would not match their equality.
+	 */
+	template <typename T>
+	inline constexpr bool EnableHashing = Hashable<T> || (std::has_unique_object_representations_v<T> && !std::equality_comparable<T>);
+
+	/**
+	 * Only enabled together with hashing, containers declare operator== even when their elements cannot be compared.
+	 * Trivially comparable types without operator== are compared with memcmp.
+	 */
+	template <typename T>
+	inline constexpr bool EnableEquality = (Hashable<T> && std::equality_comparable<T>) || std::has_unique_object_representations_v<T>;
+
+	/**
+	 * Classes that have neither a Hash nor Equals function are hashed and compared using their reflected base classes and members.
+	 * @see HashMembers
+	 */
+	template <typename T>
+	inline constexpr bool EnableMemberComparison = std::is_class_v<T>;
+
+	/**
+	 * Trivially relocatable types can be moved to another address by copying their bytes, without calling the move constructor and destructor.
+	 * Trivially copyable types are detected automatically, other types can opt in with GLAS_STORAGE_TRIVIALLY_RELOCATABLE.
+	 */
+	template <typename T>
+	inline constexpr bool IsTriviallyRelocatable = std::is_trivially_copyable_v<T>;
+
+	/**
+	 * Trivially comparable types are hashed and compared as bytes.
+	 * Classes that define their own std::hash or operator== keep using them, even if their bytes are unique.
+	 */
+	template <typename T>
+	inline constexpr bool IsTriviallyComparable = std::has_unique_object_representations_v<T> && EnableHashing<T> && EnableEquality<T>
+		&& (std::is_scalar_v<T> || (!Hashable<T> && !std::equality_comparable<T>));
 }
 
 #define GLAS_STORAGE_DISABLE_CONSTRUCT(TYPE) template <> inline constexpr bool glas::Storage::EnableDefaultConstructor<TYPE> = false;
@@ -59,23 +107,251 @@ namespace glas::Storage
 #define GLAS_STORAGE_DISABLE_COPY(TYPE) template <> inline constexpr bool glas::Storage::EnableCopyConstructor<TYPE> = false;
 #define GLAS_STORAGE_DISABLE_MOVE(TYPE) template <> inline constexpr bool glas::Storage::EnableMoveConstructor<TYPE> = false;
 #define GLAS_STORAGE_DISABLE_SWAP(TYPE) template <> inline constexpr bool glas::Storage::EnableSwapping<TYPE> = false;
+#define GLAS_STORAGE_DISABLE_HASH(TYPE) template <> inline constexpr bool glas::Storage::EnableHashing<TYPE> = false;
+#define GLAS_STORAGE_DISABLE_EQUALITY(TYPE) template <> inline constexpr bool glas::Storage::EnableEquality<TYPE> = false;
+#define GLAS_STORAGE_DISABLE_MEMBER_COMPARISON(TYPE) template <> inline constexpr bool glas::Storage::EnableMemberComparison<TYPE> = false;
+#define GLAS_STORAGE_TRIVIALLY_RELOCATABLE(TYPE) template <> inline constexpr bool glas::Storage::IsTriviallyRelocatable<TYPE> = true;
+
+/**
+ * Size in bytes of the blocks that a MonotonicArena allocates from its upstream resource.
+ * Allocations that are larger than a block get a block of their own.
+ */
+#ifndef GLAS_STORAGE_ARENA_BLOCK_SIZE
+#define GLAS_STORAGE_ARENA_BLOCK_SIZE 65536
+#endif
+
+/**
+ * Size in bytes of the inline buffer of a TypeStorage.
+ * Types that fit inside of the buffer and have a nothrow move constructor are stored without allocating.
+ * The default keeps a TypeStorage at 64 bytes on 64 bit platforms.
+ */
+#ifndef GLAS_STORAGE_INLINE_SIZE
+#define GLAS_STORAGE_INLINE_SIZE 32
+#endif
+
+/**
+ * Alignment of the inline buffer of a TypeStorage, types with a larger alignment are always allocated.
+ */
+#ifndef GLAS_STORAGE_INLINE_ALIGN
+#define GLAS_STORAGE_INLINE_ALIGN 16
+#endif
+
+/**
+ * Alignment of the columns of a TypeSoAVector.
+ * The default aligns every column to a cache line, which is also enough for the widest vector registers.
+ */
+#ifndef GLAS_STORAGE_SOA_COLUMN_ALIGN
+#define GLAS_STORAGE_SOA_COLUMN_ALIGN 64
+#endif
+
+/**
+ * Size in bytes of the chunks of a TypeChunkedVector, a chunk holds at least one element.
+ */
+#ifndef GLAS_STORAGE_CHUNK_SIZE
+#define GLAS_STORAGE_CHUNK_SIZE 16384
+#endif
+
+/**
+ * Alignment of the chunks of a TypeChunkedVector, types with a larger alignment use their own alignment.
+ */
+#ifndef GLAS_STORAGE_CHUNK_ALIGN
+#define GLAS_STORAGE_CHUNK_ALIGN 64
+#endif
+
+/**
+ * Minimum amount of slots of a TypeHashMap that contains elements.
+ */
+#ifndef GLAS_STORAGE_HASH_MAP_MIN_CAPACITY
+#define GLAS_STORAGE_HASH_MAP_MIN_CAPACITY 16
+#endif
 
 namespace glas::Storage
 {
 	template <typename T>
 	constexpr void FillTypeInfo(TypeInfo& info);
 
+	/**
+	 * Sets TypeInfo::Hash and TypeInfo::Equals to the member wise comparison of the class, unless the class already has them.
+	 * Called when a member or base class of the class is registered.
+	 * @see EnableMemberComparison
+	 * @see IsComparable
+	 */
+	template <typename T>
+	void FillMemberComparison(TypeInfo& info);
+
+	/** Hashes the bytes of the data, used for trivially comparable types. */
+	size_t HashBytes(const void* data, size_t size);
+
+	/** Mixes the bits of a hash, so that hashes that only differ in their high bits also differ in their low bits. */
+	constexpr uint64_t MixHash(uint64_t hash);
+
+	/**
+	 * Combines the hashes of the reflected base classes and members of the type, pointers are hashed by their address.
+	 * Every base class and member type must have a Hash function.
+	 * @see CanCompareMembers
+	 */
+	size_t HashMembers(const TypeInfo& info, const void* data);
+
+	/** Compares the reflected base classes and members of the type, pointers are compared by their address. */
+	bool EqualsMembers(const TypeInfo& info, const void* lhs, const void* rhs);
+
+	template <typename T>
+	size_t HashMembers(const void* data);
+
+	template <typename T>
+	bool EqualsMembers(const void* lhs, const void* rhs);
+
+	/** @returns true if every reflected base class and member of the type can be hashed and compared. */
+	bool CanCompareMembers(const TypeInfo& info);
+
+	/**
+	 * @returns true if the instances of the type can be hashed and compared.
+	 * The members are only checked when they are used, because they can be registered in any order.
+	 */
+	bool IsComparable(const TypeInfo& info);
+
+	/** True if the parameters start with std::allocator_arg, which selects the overloads that take a memory resource. */
+	template <typename... Parameters>
+	constexpr bool StartsWithAllocatorArg = false;
+
+	template <typename First, typename... Parameters>
+	constexpr bool StartsWithAllocatorArg<First, Parameters...> = std::is_same_v<std::remove_cvref_t<First>, std::allocator_arg_t>;
+
+	/**
+	 * Block of memory that is allocated from a memory resource, with the alignment of the type that is stored inside of it.
+	 * The buffer only manages the memory, the owner constructs and destroys the instances inside of it.
+	 * The memory resource stays with the buffer when the memory is released, so new memory comes from the same resource.
+	 */
+	class StorageBuffer final
+	{
+	public:
+		StorageBuffer() = default;
+		explicit StorageBuffer(std::pmr::memory_resource* resource);
+		StorageBuffer(size_t size, size_t align, std::pmr::memory_resource* resource);
+		~StorageBuffer();
+
+		StorageBuffer(const StorageBuffer&) = delete;
+		StorageBuffer(StorageBuffer&& other) noexcept;
+		StorageBuffer& operator=(const StorageBuffer&) = delete;
+		StorageBuffer& operator=(StorageBuffer&& other) noexcept;
+
+	public:
+		uint8_t*					Get			()	const	{ return m_Data; }
+		size_t						GetSize		()	const	{ return m_Size; }
+		size_t						GetAlign	()	const	{ return m_Align; }
+		std::pmr::memory_resource*	GetResource	()	const	{ return m_Resource; }
+
+		explicit					operator bool()	const	{ return m_Data; }
+
+		/** Gives up the ownership of the memory without deallocating it. */
+		uint8_t*					Release		();
+
+		/** Deallocates the memory. */
+		void						Reset		();
+
+	private:
+		uint8_t*					m_Data		{ };
+		size_t						m_Size		{ };
+		size_t						m_Align		{ };
+		std::pmr::memory_resource*	m_Resource	{ std::pmr::get_default_resource() };
+	};
+
+	/**
+	 * Memory resource that hands out memory by bumping an offset inside of large blocks, deallocating does nothing.
+	 * The memory is freed in bulk with Rewind or Reset, which keep the blocks for the next allocations.
+	 * Resetting once per frame turns the arena into a frame arena for short lived reflected objects,
+	 * the objects that were allocated from the arena must be destroyed before it is reset.
+	 * An arena is not thread safe.
+	 * @see ScopedArena
+	 */
+	class MonotonicArena final : public std::pmr::memory_resource
+	{
+	public:
+		/** Position inside of the arena that can be rewound to. */
+		struct Marker
+		{
+			size_t Block	{ };
+			size_t Offset	{ };
+		};
+
+		explicit MonotonicArena(size_t blockSize = GLAS_STORAGE_ARENA_BLOCK_SIZE, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+		~MonotonicArena() override;
+
+		MonotonicArena(const MonotonicArena&) = delete;
+		MonotonicArena(MonotonicArena&&) noexcept = delete;
+		MonotonicArena& operator=(const MonotonicArena&) = delete;
+		MonotonicArena& operator=(MonotonicArena&&) noexcept = delete;
+
+	public:
+		Marker				GetMarker		()	const	{ return { m_CurrentBlock, m_Offset }; }
+
+		/** Frees everything that was allocated after the marker was taken. */
+		void				Rewind			(Marker marker);
+
+		/** Frees everything, the blocks are kept. */
+		void				Reset			()	{ Rewind({}); }
+
+		/** Frees everything and returns the blocks to the upstream resource. */
+		void				Release			();
+
+		size_t				GetBlockCount	()	const	{ return m_Blocks.size(); }
+
+	private:
+		void*				do_allocate		(size_t bytes, size_t alignment) override;
+		void				do_deallocate	(void*, size_t, size_t) override {}
+		bool				do_is_equal		(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+		struct Block
+		{
+			uint8_t*	Data	{ };
+			size_t		Size	{ };
+		};
+
+		static constexpr size_t BlockAlignment = alignof(std::max_align_t);
+
+		std::vector<Block>			m_Blocks		{ };
+		size_t						m_CurrentBlock	{ };
+		size_t						m_Offset		{ };
+		size_t						m_BlockSize		{ };
+		std::pmr::memory_resource*	m_Upstream		{ };
+	};
+
+	/**
+	 * Frees everything that was allocated from the arena during the lifetime of the scope.
+	 * Scopes can be nested, but must be destroyed in the reverse order of their creation.
+	 */
+	class ScopedArena final
+	{
+	public:
+		explicit ScopedArena(MonotonicArena& arena) : m_Arena{ arena }, m_Marker{ arena.GetMarker() } {}
+		~ScopedArena() { m_Arena.Rewind(m_Marker); }
+
+		ScopedArena(const ScopedArena&) = delete;
+		ScopedArena(ScopedArena&&) noexcept = delete;
+		ScopedArena& operator=(const ScopedArena&) = delete;
+		ScopedArena& operator=(ScopedArena&&) noexcept = delete;
+
+		std::pmr::memory_resource*	GetResource	()	const	{ return &m_Arena; }
+
+	private:
+		MonotonicArena&				m_Arena;
+		MonotonicArena::Marker		m_Marker;
+	};
+
 	/**
 	 * Manages an instance of a type similarly to how std::unique_ptr manages memory.
 	 * Whenever an instance of this class goes out of scope and an instance of a type is stored, it will call the destructor before freeing the memory.
+	 * Small types with a nothrow move constructor are stored inside of an inline buffer, and are relocated when the storage is moved.
+	 * @see GLAS_STORAGE_INLINE_SIZE
 	 */
 	class TypeStorage final
 	{
 	public:
-		TypeStorage(TypeId id);
+		TypeStorage(TypeId id, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 		TypeStorage() = default;
 		~TypeStorage();
 
+		/** Copies use the default memory resource. */
 		TypeStorage(const TypeStorage& other);
 		TypeStorage(TypeStorage&& other) noexcept;
 		TypeStorage& operator=(const TypeStorage& other);
@@ -86,7 +362,11 @@ namespace glas::Storage
 		static TypeStorage Construct() requires std::is_default_constructible_v<T>;
 
 		template <typename T, typename ... Parameters>
-		static TypeStorage Construct(Parameters&&... parameters);
+		static TypeStorage Construct(Parameters&&... parameters) requires (!StartsWithAllocatorArg<Parameters...>);
+
+		/** Constructs the instance inside of memory from the given resource, unless it is stored inline. */
+		template <typename T, typename ... Parameters>
+		static TypeStorage Construct(std::allocator_arg_t, std::pmr::memory_resource* resource, Parameters&&... parameters);
 
 		template <typename T>
 		static TypeStorage CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>;
@@ -94,118 +374,249 @@ namespace glas::Storage
 		template <typename T>
 		static TypeStorage MoveConstruct(T&& value) requires std::is_move_constructible_v<T>;
 
-		TypeStorage static CopyConstruct(TypeId id, const void* original);
+		TypeStorage static CopyConstruct(TypeId id, const void* original, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-		TypeStorage static MoveConstruct(TypeId id, void* original);
+		TypeStorage static MoveConstruct(TypeId id, void* original, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/**
+		 * Provides uninitialized memory for the type and lets the constructor construct the instance inside of it.
+		 * If the constructor throws, the memory is released without calling the destructor.
+		 * @param constructor callable that takes a void* and constructs an instance of the type at that address.
+		 * @see FunctionInfo::Invoke
+		 */
+		template <typename Constructor>
+		static TypeStorage ConstructInPlace(TypeId id, Constructor&& constructor, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/** Returns true if instances of the type are stored inside of the inline buffer. */
+		static bool FitsInline(const TypeInfo& info);
 
 	public:
 
 		TypeId GetType() const { return m_TypeId; }
-		void* GetData() const { return m_Data.get(); }
+		void* GetData() const { return m_Data; }
+		std::pmr::memory_resource* GetResource() const { return m_Resource; }
+		bool IsInline() const { return m_Data == m_Buffer; }
 
 		template <typename T>
 		T* As() const;
 
+		/** Moves the instance into a std::unique_ptr and releases the storage. */
 		template <typename T>
 		std::unique_ptr<T> TransferOwnershipCheck();
 		template <typename T>
 		std::unique_ptr<T> TransferOwnershipUnsafe();
 
 	private:
-		template <typename T>
-		static TypeStorage Initialize();
+		template <typename Constructor>
+		void ConstructData(TypeId id, const TypeInfo& info, Constructor&& constructor);
+		void MoveData(TypeStorage& other) noexcept;
+		void Deallocate(const TypeInfo& info);
+		void Destroy();
 
 	private:
-		std::unique_ptr<uint8_t[]> m_Data{};
-		TypeId m_TypeId{};
+		alignas(GLAS_STORAGE_INLINE_ALIGN) std::byte	m_Buffer[GLAS_STORAGE_INLINE_SIZE];
+		void*											m_Data{};
+		const TypeInfo*									m_Info{}; /**< Cached so that moving and destroying does not look up the type*/
+		std::pmr::memory_resource*						m_Resource{ std::pmr::get_default_resource() };
+		TypeId											m_TypeId{};
+	};
+
+	/**
+	 * Header that is stored in front of the instance of a shared storage, inside of the same allocation.
+	 * The weak count includes one reference for all strong references together, the memory is freed when it reaches zero.
+	 */
+	template <bool ThreadSafe>
+	struct SharedStorageHeader
+	{
+		using Counter = std::conditional_t<ThreadSafe, std::atomic<uint32_t>, uint32_t>;
+
+		Counter						StrongCount	{ 1 };
+		Counter						WeakCount	{ 1 };
+		const TypeInfo*				Info		{ };
+		std::pmr::memory_resource*	Resource	{ };
+		TypeId						Type		{ };
 	};
 
-	class SharedTypeStorage final
+	template <bool ThreadSafe>
+	class BasicWeakTypeStorage;
+
+	/**
+	 * Manages an instance of a type similarly to how std::shared_ptr manages memory.
+	 * The reference counts are stored in a header in front of the instance, so a shared instance is a single allocation
+	 * and the storage only holds a pointer to the instance.
+	 * The instance is destroyed when the last shared storage releases it, the memory is returned to its memory resource when the last weak storage releases it.
+	 * @tparam ThreadSafe uses atomic reference counts, storages that are only used by a single thread can use non atomic reference counts.
+	 * @see SharedTypeStorage
+	 * @see LocalSharedTypeStorage
+	 */
+	template <bool ThreadSafe>
+	class BasicSharedTypeStorage final
 	{
-		friend class WeakTypeStorage;
+		friend class BasicWeakTypeStorage<ThreadSafe>;
 	public:
-		SharedTypeStorage(TypeId id);
-		SharedTypeStorage() = default;
-		~SharedTypeStorage();
-
-		SharedTypeStorage(const SharedTypeStorage& other) = default;
-		SharedTypeStorage(SharedTypeStorage&& other) noexcept = default;
-		SharedTypeStorage& operator=(const SharedTypeStorage& other) = default;
-		SharedTypeStorage& operator=(SharedTypeStorage&& other) noexcept = default;
+		BasicSharedTypeStorage(TypeId id, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		BasicSharedTypeStorage() = default;
+		~BasicSharedTypeStorage();
+
+		BasicSharedTypeStorage(const BasicSharedTypeStorage& other);
+		BasicSharedTypeStorage(BasicSharedTypeStorage&& other) noexcept;
+		BasicSharedTypeStorage& operator=(const BasicSharedTypeStorage& other);
+		BasicSharedTypeStorage& operator=(BasicSharedTypeStorage&& other) noexcept;
 	public:
 
 		template <typename T>
-		static SharedTypeStorage Construct() requires std::is_default_constructible_v<T>;
+		static BasicSharedTypeStorage Construct() requires std::is_default_constructible_v<T>;
 
 		template <typename T, typename ... Parameters>
-		static SharedTypeStorage Construct(Parameters&&... parameters);
+		static BasicSharedTypeStorage Construct(Parameters&&... parameters) requires (!StartsWithAllocatorArg<Parameters...>);
+
+		/** Constructs the instance and its header inside of memory from the given resource. */
+		template <typename T, typename ... Parameters>
+		static BasicSharedTypeStorage Construct(std::allocator_arg_t, std::pmr::memory_resource* resource, Parameters&&... parameters);
 
 		template <typename T>
-		static SharedTypeStorage CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>;
+		static BasicSharedTypeStorage CopyConstruct(const T& value) requires std::is_copy_constructible_v<T>;
 
 		template <typename T>
-		static SharedTypeStorage MoveConstruct(T&& value) requires std::is_move_constructible_v<T>;
+		static BasicSharedTypeStorage MoveConstruct(T&& value) requires std::is_move_constructible_v<T>;
+
+		BasicSharedTypeStorage static CopyConstruct(TypeId id, const void* original, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-		SharedTypeStorage static CopyConstruct(TypeId id, const void* original);
+		BasicSharedTypeStorage static MoveConstruct(TypeId id, void* original, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-		SharedTypeStorage static MoveConstruct(TypeId id, void* original);
+		/**
+		 * Allocates uninitialized memory for the type and lets the constructor construct the instance inside of it.
+		 * If the constructor throws, the memory is released without calling the destructor.
+		 * @see TypeStorage::ConstructInPlace
+		 */
+		template <typename Constructor>
+		static BasicSharedTypeStorage ConstructInPlace(TypeId id, Constructor&& constructor, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 	public:
 
-		TypeId GetType() const { return m_TypeId; }
-		void* GetData() const { return m_Data.get()->get(); }
+		TypeId						GetType		()	const	{ return m_Data ? GetHeader()->Type : TypeId{}; }
+		void*						GetData		()	const	{ return m_Data; }
+		std::pmr::memory_resource*	GetResource	()	const	{ return m_Data ? GetHeader()->Resource : nullptr; }
+
+		/** @returns the amount of shared storages that own the instance. */
+		uint32_t					GetUseCount	()	const;
 
 		template <typename T>
 		T* As();
 
 	private:
-		template <typename T>
-		static SharedTypeStorage Initialize();
+		using Header = SharedStorageHeader<ThreadSafe>;
+
+		Header*						GetHeader	()	const	{ return GetHeader(m_Data); }
+		void						Release		();
+
+		static Header*				GetHeader		(void* data)	{ return reinterpret_cast<Header*>(static_cast<uint8_t*>(data) - sizeof(Header)); }
+		static size_t				GetDataOffset	(size_t align)	{ return (sizeof(Header) + align - 1) / align * align; }
+		static void					AddReference	(typename Header::Counter& counter);
+		static bool					RemoveReference	(typename Header::Counter& counter);
+		static void					ReleaseWeak		(void* data);
 
 	private:
-		std::shared_ptr<std::unique_ptr<uint8_t[]>> m_Data{};
-		TypeId m_TypeId{};
+		void* m_Data{};
 	};
 
-	class WeakTypeStorage final
+	/**
+	 * Holds a reference to the instance of a shared storage, without keeping the instance alive.
+	 * @see WeakTypeStorage
+	 * @see LocalWeakTypeStorage
+	 */
+	template <bool ThreadSafe>
+	class BasicWeakTypeStorage final
 	{
 	public:
-		WeakTypeStorage(const SharedTypeStorage& sharedStorage);
-		WeakTypeStorage() = default;
-		~WeakTypeStorage() = default;
-
-		WeakTypeStorage(const WeakTypeStorage& other) = default;
-		WeakTypeStorage(WeakTypeStorage&& other) noexcept = default;
-		WeakTypeStorage& operator=(const WeakTypeStorage& other) = default;
-		WeakTypeStorage& operator=(WeakTypeStorage&& other) noexcept = default;
+		BasicWeakTypeStorage(const BasicSharedTypeStorage<ThreadSafe>& sharedStorage);
+		BasicWeakTypeStorage() = default;
+		~BasicWeakTypeStorage();
+
+		BasicWeakTypeStorage(const BasicWeakTypeStorage& other);
+		BasicWeakTypeStorage(BasicWeakTypeStorage&& other) noexcept;
+		BasicWeakTypeStorage& operator=(const BasicWeakTypeStorage& other);
+		BasicWeakTypeStorage& operator=(BasicWeakTypeStorage&& other) noexcept;
 	public:
 
-		SharedTypeStorage GetSharedStorage() const;
-		TypeId GetType() const { return m_TypeId; }
-		void* GetData() const { return m_Data.lock().get()->get(); }
-		bool Expired() const { return m_Data.expired(); }
+		/** @returns a shared storage that owns the instance, or an empty storage if the instance has been destroyed. */
+		BasicSharedTypeStorage<ThreadSafe> GetSharedStorage() const;
+
+		TypeId GetType() const { return m_Data ? Shared::GetHeader(m_Data)->Type : TypeId{}; }
+
+		/** The instance can be destroyed by another thread after this call, use GetSharedStorage to keep it alive. */
+		void* GetData() const { return Expired() ? nullptr : m_Data; }
+		bool Expired() const;
 
 	private:
-		std::weak_ptr<std::unique_ptr<uint8_t[]>> m_Data{};
-		TypeId m_TypeId{};
+		using Shared = BasicSharedTypeStorage<ThreadSafe>;
+
+		void* m_Data{};
+	};
+
+	/** Shared storage with atomic reference counts. */
+	using SharedTypeStorage			= BasicSharedTypeStorage<true>;
+	using WeakTypeStorage			= BasicWeakTypeStorage<true>;
+
+	/** Shared storage with non atomic reference counts, that must only be used by a single thread at a time. */
+	using LocalSharedTypeStorage	= BasicSharedTypeStorage<false>;
+	using LocalWeakTypeStorage		= BasicWeakTypeStorage<false>;
+
+	/**
+	 * Memory layout of the TypeTuples with a signature, it is computed once and shared by every tuple with the same VariableIds.
+	 * A tuple is a single allocation that starts with a copy of the header, followed by the variable data.
+	 * @see TypeTuple
+	 */
+	struct TypeTupleLayout final
+	{
+		struct Variable
+		{
+			const TypeInfo*		Info		{ }; /**< nullptr for pointers, which are stored as plain values*/
+			uint32_t			Offset		{ }; /**< Offset of the variable from the start of the tuple*/
+			uint32_t			Count		{ 1 }; /**< Amount of elements of fixed size arrays*/
+		};
+
+		std::vector<uint8_t>		Header					{ }; /**< Jump table of data offsets followed by the VariableIds*/
+		std::vector<Variable>		Variables				{ };
+		size_t						DataOffset				{ };
+		size_t						Size					{ }; /**< Size of the whole tuple*/
+		size_t						Align					{ };
+		bool						TriviallyCopyable		{ }; /**< The variable data can be copied with a single memcpy*/
+		bool						TriviallyDestructible	{ };
+
+		/**
+		 * Get the layout of the signature, the layout is computed and cached the first time the signature is used.
+		 * The reference flags of the variables are ignored. The cache is thread safe and layouts are never freed.
+		 */
+		static const TypeTupleLayout&	Get		(std::span<const VariableId> variables);
+
+	private:
+		static VariableId			GetStoredVariable	(VariableId variable);
+		static uint64_t				GetSignatureHash	(std::span<const VariableId> variables);
+		bool						HasSignature		(std::span<const VariableId> variables)	const;
+		void						Compute				(std::span<const VariableId> variables);
 	};
 
 	/**
 	 * Container for storing instances of types similar to std::tuple.
 	 * Any combination of types can be stored in this container.
 	 * Because references can normally not be stored, the reference flag will be removed and the whole type will be stored.
+	 * The layout of every signature is cached, so creating a tuple is a single allocation and a copy of the cached header.
+	 * @see TypeTupleLayout
 	 */
 	class TypeTuple final
 	{
 	public:
 		TypeTuple() = default;
 		~TypeTuple();
-		TypeTuple(std::span<VariableId> variables);
+		TypeTuple(std::span<VariableId> variables, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		TypeTuple(const TypeTupleLayout& layout, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-		TypeTuple(const TypeTuple& other) = delete; // TODO
-		TypeTuple(TypeTuple&& other) noexcept = default;
-		TypeTuple& operator=(const TypeTuple& other) = delete; // TODO
-		TypeTuple& operator=(TypeTuple&& other) noexcept = default;
+		/** Copies use the default memory resource. */
+		TypeTuple(const TypeTuple& other);
+		TypeTuple(TypeTuple&& other) noexcept;
+		TypeTuple& operator=(const TypeTuple& other);
+		TypeTuple& operator=(TypeTuple&& other) noexcept;
 
 		template <typename... T>
 		TypeTuple(const std::tuple<T...>& tuple);
@@ -224,7 +635,18 @@ namespace glas::Storage
 		template <typename... T>
 		static TypeTuple CreateNoReferences(T&&... val);
 
+		/** Copies the tuple into memory of the resource. */
+		TypeTuple Clone(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+		/**
+		 * Destroys the variables and default constructs them again, without allocating.
+		 * A tuple can be reset between calls to reuse it as the arguments of repeated invocations.
+		 */
+		void Reset();
+
 		VariableId GetVariable(size_t index) const;
+
+		/** Replaces the VariableId without changing the layout, the variable is still constructed and destroyed as the original type. */
 		void SetVariableUnsafe(size_t index, VariableId id);
 
 		void* GetVoid(size_t index) const;
@@ -235,33 +657,44 @@ namespace glas::Storage
 		template <typename T>
 		const T& Get(size_t index) const;
 
-		constexpr size_t	GetJumpTableSize		()	const	{ return m_Size * sizeof(void*); }
+		constexpr size_t	GetJumpTableSize		()	const	{ return m_Size * sizeof(size_t); }
 		constexpr size_t	GetVariableIdsSize		()	const	{ return m_Size * sizeof(VariableId); }
 
 		constexpr size_t	GetJumpTableOffset		()	const	{ return 0; }
 		constexpr size_t	GetVariableIdsOffset	()	const	{ return GetJumpTableOffset() + GetJumpTableSize(); }
-		constexpr size_t	GetVariableDataOffset	()	const	{ return GetVariableIdsOffset() + GetVariableIdsSize(); }
+		size_t				GetVariableDataOffset	()	const	{ return m_Layout ? m_Layout->DataOffset : 0; }
 
-		const void*			GetJumpTablePtr			()	const	{ return m_Data.get(); }
-		const VariableId*	GetVariableIdsPtr		()	const	{ return reinterpret_cast<VariableId*>(m_Data.get() + GetVariableIdsOffset()); }
-		const void*			GetVariableDataPtr		()	const	{ return m_Data.get() + GetVariableDataOffset(); }
+		const void*			GetJumpTablePtr			()	const	{ return m_Data.Get(); }
+		const VariableId*	GetVariableIdsPtr		()	const	{ return reinterpret_cast<VariableId*>(m_Data.Get() + GetVariableIdsOffset()); }
+		const void*			GetVariableDataPtr		()	const	{ return m_Data.Get() + GetVariableDataOffset(); }
 
 		std::span<VariableId> GetVariableIds		()			{ return { GetVariableIdsPtr(), m_Size }; }
-		void*				GetJumpTablePtr			()			{ return m_Data.get(); }
-		VariableId*			GetVariableIdsPtr		()			{ return reinterpret_cast<VariableId*>(m_Data.get() + GetVariableIdsOffset()); }
-		void*				GetVariableDataPtr		()			{ return m_Data.get() + GetVariableDataOffset(); }
+		void*				GetJumpTablePtr			()			{ return m_Data.Get(); }
+		VariableId*			GetVariableIdsPtr		()			{ return reinterpret_cast<VariableId*>(m_Data.Get() + GetVariableIdsOffset()); }
+		void*				GetVariableDataPtr		()			{ return m_Data.Get() + GetVariableDataOffset(); }
 
 		std::span<const VariableId> GetVariableIds	()	const	{ return { GetVariableIdsPtr(), m_Size }; }
 
 		constexpr uint32_t	GetSize					()	const	{ return m_Size; }
 
+		std::pmr::memory_resource* GetResource		()	const	{ return m_Data.GetResource(); }
+
+		/** @returns the cached layout of the tuple, or nullptr for empty tuples. */
+		const TypeTupleLayout* GetLayout			()	const	{ return m_Layout; }
+
 	private:
 		void Initialize(std::span<VariableId> variables, bool InitializeToDefault);
+		void Initialize(const TypeTupleLayout& layout, bool InitializeToDefault);
+
+		void ConstructVariables();
+		void DestroyVariables(size_t count);
 
-		uint32_t CalculateAlignment(std::span<VariableId> variables) const;
+		template <typename... T>
+		static const TypeTupleLayout& GetCachedLayout();
 
 	private:
-		std::unique_ptr<uint8_t[]> m_Data{};
+		StorageBuffer m_Data{};
+		const TypeTupleLayout* m_Layout{};
 		uint32_t m_Size{};
 	};
 
@@ -382,25 +815,30 @@ namespace glas::Storage
 	using ReverseTypeIterator		= ReverseTypeIteratorBase<void*>;
 	using ReverseConstTypeIterator	= ReverseTypeIteratorBase<const void*>;
 
+	/**
+	 * Contiguous array of instances of a single type.
+	 * The buffer is allocated from a memory resource with the alignment of the contained type.
+	 */
 	class TypeVector final
 	{
 	public:
 		TypeVector() = default;
 		~TypeVector();
 
+		/** Copies use the default memory resource. */
 		TypeVector(const TypeVector& other);
 		TypeVector(TypeVector&& other) noexcept;
 
-		TypeVector(TypeId type);
-		TypeVector(TypeId type, size_t count);
+		TypeVector(TypeId type, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+		TypeVector(TypeId type, size_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 		TypeVector(size_t count, const TypeStorage& value);
 		TypeVector(TypeId type, size_t count, const void* value);
 
 		template <typename T>
-		static TypeVector Create();
+		static TypeVector Create(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 		template <typename T>
-		static TypeVector Create(size_t count);
+		static TypeVector Create(size_t count, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
 		template <typename T> TypeVector(size_t count, const T& value);
 
@@ -420,8 +858,8 @@ namespace glas::Storage
 		const void*					At				(size_t index)	const;
 		void*						operator[]		(size_t index);
 		const void*					operator[]		(size_t index)	const;
-		uint8_t*					Data			()						{ return m_Data.get(); }
-		const uint8_t*				Data			()				const	{ return m_Data.get(); }
+		uint8_t*					Data			()						{ return m_Data.Get(); }
+		const uint8_t*				Data			()				const	{ return m_Data.Get(); }
 		void*						Front			()						{ return Data(); }
 		const void*					Front			()				const	{ return Data(); }
 		void*						Back			()						{ return Data() + ElementSize() * (Size() - 1); }
@@ -446,6 +884,7 @@ namespace glas::Storage
 		constexpr bool				IsEmpty			()				const	{ return Size() == 0; }
 		constexpr size_t			Size			()				const	{ return m_Size; }
 		constexpr size_t			Capacity		()				const	{ return m_Capacity; }
+		std::pmr::memory_resource*	GetResource		()				const	{ return m_Data.GetResource(); }
 		void						Reserve			(size_t size);
 		void						ShrinkToFit		();
 
@@ -469,19 +908,566 @@ namespace glas::Storage
 
 	private:
 		static bool					AssertType		(TypeId id);
-		void						MoveToNewBuffer	(std::unique_ptr<uint8_t[]>& buffer);
-		std::unique_ptr<uint8_t[]>	CreateNewBuffer	(size_t size)	const;
-		void						SetBuffer		(std::unique_ptr<uint8_t[]>&& buffer, size_t elementAmount);
+		void						MoveToNewBuffer	(StorageBuffer& buffer);
+		StorageBuffer				CreateNewBuffer	(size_t size)	const;
+		void						SetBuffer		(StorageBuffer&& buffer, size_t elementAmount);
 		constexpr size_t			CalculateNewSize()				const;
 		void*						ElementAddress	(size_t index)	const;
 
 	private:
 		TypeId						m_ContainedType	{ };
-		std::unique_ptr<uint8_t[]>	m_Data			{ };
+		StorageBuffer				m_Data			{ };
 		size_t						m_Size			{ };
 		size_t						m_Capacity		{ };
 		uint32_t					m_ElementSize	{ };
 	};
+
+	/**
+	 * Container of objects that derive from a polymorphic base class, stored by value.
+	 * The objects are grouped into one contiguous TypeVector per dynamic type, and every iteration visits the objects bucket by bucket.
+	 * Every call inside of a bucket goes to the same function, so the indirect branches are predictable and the objects are read sequentially.
+	 * The order of the objects is not kept and adding or removing objects can move the other objects of the same type.
+	 * The stored types must be registered as children of the base class and must be move constructible.
+	 */
+	template <typename Base> requires std::is_polymorphic_v<Base>
+	class PolymorphicVector final
+	{
+	public:
+		PolymorphicVector() = default;
+		~PolymorphicVector() = default;
+
+		/** The buckets allocate their memory from the resource. */
+		explicit PolymorphicVector(std::pmr::memory_resource* resource) : m_Resource{ resource } {}
+
+		PolymorphicVector(const PolymorphicVector&) = delete;
+		PolymorphicVector(PolymorphicVector&&) noexcept = default;
+		PolymorphicVector& operator=(const PolymorphicVector&) = delete;
+		PolymorphicVector& operator=(PolymorphicVector&&) noexcept = default;
+
+	public: // Modifiers
+
+		/** Constructs a new object at the back of the bucket of its type. */
+		template <typename T, typename... Arguments>
+		T&							Emplace			(Arguments&&... arguments) requires std::derived_from<T, Base>;
+
+		/** Default constructs a new object of the given type using its TypeInfo. */
+		Base*						Emplace			(TypeId type);
+
+		/**
+		 * Copies the object as its dynamic type.
+		 * @throws std::runtime_error when the dynamic type of the object is not registered.
+		 */
+		Base*						PushBackCopy	(const Base& object);
+
+		/**
+		 * Moves the object as its dynamic type.
+		 * @throws std::runtime_error when the dynamic type of the object is not registered.
+		 */
+		Base*						PushBackMove	(Base& object);
+
+		/** Removes the object by moving the last object of the same type into its place. */
+		void						Erase			(Base* object);
+
+		/** Destroys all objects, the buckets keep their memory. */
+		void						Clear			();
+
+		/** Reserves memory inside of the bucket of the type. */
+		void						Reserve			(TypeId type, size_t size);
+
+	public: // Iteration
+
+		/** Calls the function for every object as a Base&. */
+		template <typename Function>
+		void						ForEach			(Function&& function);
+
+		/**
+		 * Calls the function for every object of exactly the type T as a T&.
+		 * Virtual calls on final types, or qualified calls, are resolved at compile time inside of the loop.
+		 */
+		template <typename T, typename Function>
+		void						ForEachOfType	(Function&& function) requires std::derived_from<T, Base>;
+
+		/**
+		 * Calls a reflected method on every object.
+		 * The method is resolved once per bucket, using the most derived registered override that has the same name and signature.
+		 * Buckets of types that do not have the method are skipped.
+		 * @param arguments the argument types must match the parameter types without references.
+		 */
+		template <typename... Arguments>
+		void						CallMethod		(FunctionId method, Arguments&&... arguments);
+
+	public: // Capacity
+
+		size_t						Size			()	const	{ return m_Size; }
+		bool						IsEmpty			()	const	{ return m_Size == 0; }
+		size_t						GetBucketCount	()	const	{ return m_Buckets.size(); }
+
+		/** @returns the amount of objects of exactly the given type. */
+		size_t						Count			(TypeId type)	const;
+
+	private:
+		struct Bucket
+		{
+			const TypeInfo*		Info		{ };
+			TypeVector			Objects		{ };
+			uint32_t			BaseOffset	{ }; /**< Offset of the Base inside of the type*/
+		};
+
+		Bucket&						GetBucket		(TypeId type);
+		Bucket*						FindBucket		(const TypeInfo& info);
+		const Bucket*				FindBucket		(const TypeInfo& info)	const;
+
+		static MethodTableEntry		ResolveMethod	(const TypeInfo& info, const FunctionInfo& method);
+
+	private:
+		std::vector<Bucket>			m_Buckets		{ };
+		size_t						m_Size			{ };
+		std::pmr::memory_resource*	m_Resource		{ std::pmr::get_default_resource() };
+	};
+
+	/**
+	 * Reference to a row of a TypeSoAVector, the row is read and written column by column.
+	 * @tparam VectorType TypeSoAVector or const TypeSoAVector.
+	 */
+	template <typename VectorType>
+	class SoARowReference final
+	{
+	public:
+		using AddressType = std::conditional_t<std::is_const_v<VectorType>, const void*, void*>;
+
+		SoARowReference(VectorType* vector, size_t index) : m_Vector{ vector }, m_Index{ index } {}
+
+		size_t						GetIndex	()					const	{ return m_Index; }
+
+		/** @returns the address of the value of the column inside of this row. */
+		AddressType					GetAddress	(size_t column)		const	{ return m_Vector->GetAddress(column, m_Index); }
+
+		template <typename T>
+		auto&						Get			(size_t column)		const	{ return m_Vector->template Column<T>(column)[m_Index]; }
+
+		/** Copies the row into a constructed instance of the type of the vector. */
+		void						CopyTo		(void* instance)	const	{ m_Vector->CopyTo(m_Index, instance); }
+
+	private:
+		VectorType*		m_Vector	{ };
+		size_t			m_Index		{ };
+	};
+
+	template <typename VectorType>
+	class SoARowIterator final
+	{
+	public:
+		using iterator_category	= std::forward_iterator_tag;
+		using difference_type	= std::ptrdiff_t;
+		using value_type		= SoARowReference<VectorType>;
+
+		SoARowIterator() = default;
+		SoARowIterator(VectorType* vector, size_t index) : m_Vector{ vector }, m_Index{ index } {}
+
+		value_type			operator*	()	const	{ return { m_Vector, m_Index }; }
+		SoARowIterator&		operator++	()			{ ++m_Index; return *this; }
+		SoARowIterator		operator++	(int)		{ SoARowIterator temp{ *this }; ++m_Index; return temp; }
+
+		bool				operator==	(const SoARowIterator& other)	const	{ return m_Index == other.m_Index; }
+
+	private:
+		VectorType*		m_Vector	{ };
+		size_t			m_Index		{ };
+	};
+
+	/**
+	 * Vector that stores the instances of a reflected type as a structure of arrays.
+	 * Every registered leaf member gets a column of its own, members of registered structs and base classes are split recursively
+	 * and are named by their path, for example "Translation.X". Loops over a single member read contiguous, aligned memory.
+	 * Members that are not registered are not stored, they are default constructed when a row is copied into an instance.
+	 * Pointer members are stored as plain values.
+	 * @see GLAS_STORAGE_SOA_COLUMN_ALIGN
+	 */
+	class TypeSoAVector final
+	{
+	public:
+		static constexpr size_t InvalidColumn = std::numeric_limits<size_t>::max();
+
+		/** Description of a column, the members are listed in the order of the columns. */
+		struct ColumnInfo
+		{
+			std::string			Name		{ }; /**< Path of the member inside of the type*/
+			const TypeInfo*		Info		{ }; /**< Type of the values, nullptr for pointers which are copied as bytes*/
+			uint32_t			Offset		{ }; /**< Offset of the member inside of the type*/
+			uint32_t			Size		{ }; /**< Size of a single value of the column*/
+			uint32_t			Align		{ };
+			uint32_t			ArraySize	{ 1 }; /**< Amount of elements of fixed size array members*/
+		};
+
+		TypeSoAVector() = default;
+		~TypeSoAVector();
+
+		TypeSoAVector(TypeId type, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/** Splits the elements of the vector into columns. */
+		explicit TypeSoAVector(const TypeVector& vector, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		template <typename T>
+		static TypeSoAVector Create(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/** Copies use the default memory resource. */
+		TypeSoAVector(const TypeSoAVector& other);
+		TypeSoAVector(TypeSoAVector&& other) noexcept;
+		TypeSoAVector& operator=(const TypeSoAVector& other);
+		TypeSoAVector& operator=(TypeSoAVector&& other) noexcept;
+
+	public: // Columns
+
+		TypeId								GetType			()	const	{ return m_Type; }
+		const std::vector<ColumnInfo>&		GetColumns		()	const	{ return m_Columns; }
+
+		/** @returns the index of the column of the member path, or InvalidColumn. */
+		size_t								GetColumnIndex	(std::string_view name)			const;
+
+		void*								GetAddress		(size_t column, size_t index);
+		const void*							GetAddress		(size_t column, size_t index)	const;
+
+		/** @returns the values of the column, T must be the type of the member. */
+		template <typename T> std::span<T>			Column	(size_t column);
+		template <typename T> std::span<const T>	Column	(size_t column)				const;
+		template <typename T> std::span<T>			Column	(std::string_view name);
+		template <typename T> std::span<const T>	Column	(std::string_view name)		const;
+
+	public: // Rows
+
+		SoARowReference<TypeSoAVector>			operator[]	(size_t index)			{ return { this, index }; }
+		SoARowReference<const TypeSoAVector>	operator[]	(size_t index)	const	{ return { this, index }; }
+
+		SoARowIterator<TypeSoAVector>			begin		()						{ return { this, 0 }; }
+		SoARowIterator<TypeSoAVector>			end			()						{ return { this, m_Size }; }
+		SoARowIterator<const TypeSoAVector>		begin		()				const	{ return { this, 0 }; }
+		SoARowIterator<const TypeSoAVector>		end			()				const	{ return { this, m_Size }; }
+
+		/** Copies the row into a constructed instance of the type, the stored members are replaced. */
+		void						CopyTo			(size_t index, void* instance)	const;
+
+		/** Copies all rows into a vector of the type. */
+		TypeVector					ToTypeVector	(std::pmr::memory_resource* resource = std::pmr::get_default_resource())	const;
+
+	public: // Capacity
+
+		bool						IsEmpty			()	const	{ return m_Size == 0; }
+		size_t						Size			()	const	{ return m_Size; }
+		size_t						Capacity		()	const	{ return m_Capacity; }
+		std::pmr::memory_resource*	GetResource		()	const	{ return m_Data.GetResource(); }
+		void						Reserve			(size_t capacity);
+
+	public: // Modifiers
+
+		/** Adds a row with the members of a default constructed instance. */
+		void						PushBack		();
+
+		/** Adds a row with copies of the members of the instance. */
+		void						PushBack		(const void* instance);
+
+		template <typename T>
+		void						PushBack		(const T& instance) requires (!std::is_pointer_v<T>);
+
+		/** Removes the row and moves the following rows forward, keeping their order. */
+		void						Erase			(size_t index);
+
+		/** Removes the row by moving the last row into its place. */
+		void						SwapRemove		(size_t index);
+
+		void						PopBack			();
+		void						Clear			();
+
+	private:
+		void						AddColumns		(const TypeInfo& info, const std::string& prefix, uint32_t offset);
+		void						MoveToNewBuffer	(size_t capacity);
+		void						CopyRows		(const TypeSoAVector& other);
+		void						CopyValues		(size_t column, void* destination, const void* source, size_t count)	const;
+		void						DestroyRange	(size_t column, size_t index, size_t count);
+		void						Relocate		(size_t column, size_t destination, size_t source, size_t count);
+		template <typename T>
+		bool						AssertColumn	(size_t column)	const;
+
+	private:
+		TypeId						m_Type			{ };
+		std::vector<ColumnInfo>		m_Columns		{ };
+		std::vector<uint8_t*>		m_ColumnData	{ }; /**< Start of every column inside of the buffer*/
+		StorageBuffer				m_Data			{ };
+		size_t						m_Size			{ };
+		size_t						m_Capacity		{ };
+	};
+
+	/**
+	 * Iterator over the occupied slots of a TypeChunkedVector.
+	 * @tparam VectorType TypeChunkedVector or const TypeChunkedVector.
+	 */
+	template <typename VectorType>
+	class ChunkedIterator final
+	{
+	public:
+		using iterator_category	= std::forward_iterator_tag;
+		using difference_type	= std::ptrdiff_t;
+		using value_type		= std::conditional_t<std::is_const_v<VectorType>, const void*, void*>;
+
+		ChunkedIterator() = default;
+		ChunkedIterator(VectorType* vector, size_t index) : m_Vector{ vector }, m_Index{ index } {}
+
+		value_type			operator*	()	const	{ return m_Vector->At(m_Index); }
+		ChunkedIterator&	operator++	()			{ m_Index = m_Vector->FindOccupied(m_Index + 1); return *this; }
+		ChunkedIterator		operator++	(int)		{ ChunkedIterator temp{ *this }; ++*this; return temp; }
+
+		/** @returns the stable index of the element. */
+		size_t				GetIndex	()	const	{ return m_Index; }
+
+		bool				operator==	(const ChunkedIterator& other)	const	{ return m_Index == other.m_Index; }
+
+	private:
+		VectorType*		m_Vector	{ };
+		size_t			m_Index		{ };
+	};
+
+	/**
+	 * Vector that stores the instances of a type inside of fixed size chunks, elements never move after they are added.
+	 * Pointers to elements and their indices stay valid until the element is erased, so the vector suits long lived objects that are referenced by pointer.
+	 * Erased slots are put on a free list and are reused by the next additions, iteration skips them and is contiguous within a chunk.
+	 * @see GLAS_STORAGE_CHUNK_SIZE
+	 * @see GLAS_STORAGE_CHUNK_ALIGN
+	 */
+	class TypeChunkedVector final
+	{
+	public:
+		TypeChunkedVector() = default;
+		~TypeChunkedVector();
+
+		TypeChunkedVector(TypeId type, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		template <typename T>
+		static TypeChunkedVector Create(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		TypeChunkedVector(const TypeChunkedVector&) = delete;
+		TypeChunkedVector(TypeChunkedVector&& other) noexcept;
+		TypeChunkedVector& operator=(const TypeChunkedVector&) = delete;
+		TypeChunkedVector& operator=(TypeChunkedVector&& other) noexcept;
+
+	public:
+
+		TypeId						GetType			()	const	{ return m_Type; }
+		uint32_t					ElementSize		()	const	{ return m_Info ? m_Info->Size : 0; }
+
+		/** @returns the amount of elements of a single chunk. */
+		size_t						GetChunkCapacity()	const	{ return m_ChunkCapacity; }
+		size_t						GetChunkCount	()	const	{ return m_Chunks.size(); }
+
+	public: // Element access
+
+		/** @returns the element of the stable index, which must be occupied. */
+		void*						At				(size_t index);
+		const void*					At				(size_t index)	const;
+
+		template <typename T> T&	Get				(size_t index);
+		template <typename T> const T& Get			(size_t index)	const;
+
+		bool						IsOccupied		(size_t index)	const;
+
+		/** @returns the stable index of an element of this vector, the chunks are searched linearly. */
+		size_t						GetIndex		(const void* element)	const;
+
+	public: // Iteration
+
+		ChunkedIterator<TypeChunkedVector>			begin	()			{ return { this, FindOccupied(0) }; }
+		ChunkedIterator<TypeChunkedVector>			end		()			{ return { this, m_End }; }
+		ChunkedIterator<const TypeChunkedVector>	begin	()	const	{ return { this, FindOccupied(0) }; }
+		ChunkedIterator<const TypeChunkedVector>	end		()	const	{ return { this, m_End }; }
+
+		/** Calls the function with the address of every element, chunk by chunk. */
+		template <typename Function>
+		void						ForEach			(Function&& function);
+
+	public: // Capacity
+
+		bool						IsEmpty			()	const	{ return m_Size == 0; }
+		size_t						Size			()	const	{ return m_Size; }
+		size_t						Capacity		()	const	{ return m_Chunks.size() * m_ChunkCapacity; }
+		std::pmr::memory_resource*	GetResource		()	const	{ return m_Resource; }
+
+		/** Allocates chunks until the vector can hold the amount of elements without allocating. */
+		void						Reserve			(size_t size);
+
+		/** Frees the chunks at the back that do not contain elements, the indices of the other elements stay valid. */
+		void						ShrinkToFit		();
+
+	public: // Modifiers
+
+		void*						PushBack		();
+		void*						PushBackCopy	(const void* data);
+		void*						PushBackMove	(void* data);
+
+		template <typename T, typename... Arguments>
+		T&							Emplace			(Arguments&&... arguments);
+
+		/** Destroys the element and puts its slot on the free list, no other element moves. */
+		void						Erase			(size_t index);
+		void						Erase			(const void* element);
+
+		/** Destroys all elements, the chunks keep their memory. */
+		void						Clear			();
+
+	private:
+		template <typename VectorType>
+		friend class ChunkedIterator;
+
+		template <typename Function>
+		void*						Construct		(Function&& constructor);
+		size_t						GetFreeSlot		();
+		void						OccupySlot		(size_t index);
+		size_t						FindOccupied	(size_t index)	const;
+		void*						SlotAddress		(size_t index)	const;
+
+	private:
+		TypeId						m_Type			{ };
+		const TypeInfo*				m_Info			{ };
+		std::vector<StorageBuffer>	m_Chunks		{ };
+		std::vector<uint64_t>		m_Occupied		{ }; /**< Bit of every slot that contains an element*/
+		std::vector<size_t>			m_FreeSlots		{ }; /**< Slots below m_End that have been erased*/
+		size_t						m_ChunkCapacity	{ };
+		size_t						m_Size			{ };
+		size_t						m_End			{ }; /**< Slots at and after the end have never been used*/
+		std::pmr::memory_resource*	m_Resource		{ std::pmr::get_default_resource() };
+	};
+
+	/**
+	 * Hash map whose keys and values are instances of the given types.
+	 * The map uses open addressing with linear probing, a key and its value are stored inline inside of a slot that is sized using the TypeInfo.
+	 * Every slot has a control byte with a part of the hash of its key, so most probes that do not match never read the key.
+	 * Keys are hashed and compared with TypeInfo::Hash and TypeInfo::Equals, trivially comparable keys with HashBytes and memcmp instead.
+	 * Adding elements can move the elements to a new buffer, which invalidates pointers to the keys and values.
+	 * @see GLAS_STORAGE_HASH_MAP_MIN_CAPACITY
+	 */
+	class TypeHashMap final
+	{
+	public:
+		TypeHashMap() = default;
+		~TypeHashMap();
+
+		TypeHashMap(TypeId key, TypeId value, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		template <typename Key, typename Value>
+		static TypeHashMap Create(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+		/** Copies use the default memory resource. */
+		TypeHashMap(const TypeHashMap& other);
+		TypeHashMap(const TypeHashMap& other, std::pmr::memory_resource* resource);
+		TypeHashMap(TypeHashMap&& other) noexcept;
+		TypeHashMap& operator=(const TypeHashMap& other);
+		TypeHashMap& operator=(TypeHashMap&& other) noexcept;
+
+	public:
+
+		TypeId						GetKeyType		()	const	{ return m_KeyType; }
+		TypeId						GetValueType	()	const	{ return m_ValueType; }
+
+	public: // Lookup
+
+		/** @returns the value of the key, or nullptr if the map does not contain the key. */
+		void*						Find			(const void* key);
+		const void*					Find			(const void* key)	const;
+
+		template <typename Value, typename Key>
+		Value*						Find			(const Key& key)	requires (!std::is_pointer_v<Key>);
+		template <typename Value, typename Key>
+		const Value*				Find			(const Key& key)	const	requires (!std::is_pointer_v<Key>);
+
+		bool						Contains		(const void* key)	const	{ return Find(key) != nullptr; }
+
+		template <typename Key>
+		bool						Contains		(const Key& key)	const	requires (!std::is_pointer_v<Key>);
+
+		/** Calls the function with the address of every key and its value, in slot order. */
+		template <typename Function>
+		void						ForEach			(Function&& function);
+
+		template <typename Function>
+		void						ForEach			(Function&& function)	const;
+
+	public: // Capacity
+
+		bool						IsEmpty			()	const	{ return m_Size == 0; }
+		size_t						Size			()	const	{ return m_Size; }
+
+		/** @returns the amount of slots, a map holds at most 7/8 of its capacity before it grows. */
+		size_t						Capacity		()	const	{ return m_Capacity; }
+		std::pmr::memory_resource*	GetResource		()	const	{ return m_Data.GetResource(); }
+
+		/** Grows the map so that it can hold the amount of elements without growing. */
+		void						Reserve			(size_t size);
+
+	public: // Modifiers
+
+		/**
+		 * Copies the key and value into the map, an existing value is not replaced.
+		 * @returns the value of the key and true if the element was added.
+		 */
+		std::pair<void*, bool>		Insert			(const void* key, const void* value);
+
+		/** Moves the key and value into the map, they are not moved if the map already contains the key. */
+		std::pair<void*, bool>		InsertMove		(void* key, void* value);
+
+		template <typename Key, typename Value>
+		std::pair<Value*, bool>		Insert			(const Key& key, const Value& value)	requires (!std::is_pointer_v<Key> && !std::is_pointer_v<Value>);
+
+		/** @returns the value of the key, a default constructed value is added if the map does not contain the key. */
+		void*						FindOrInsert	(const void* key);
+
+		/** @returns true if the key was erased. */
+		bool						Erase			(const void* key);
+
+		template <typename Key>
+		bool						Erase			(const Key& key)	requires (!std::is_pointer_v<Key>);
+
+		/** Destroys all elements, the map keeps its memory. */
+		void						Clear			();
+
+	private:
+		static constexpr uint8_t	EmptySlot		= 0;
+		static constexpr uint8_t	ErasedSlot		= 1;
+		static constexpr uint8_t	OccupiedSlot	= 0x80; /**< Bit of the control bytes of occupied slots, the other bits hold the top of the hash*/
+
+		size_t						HashKey			(const void* key)	const;
+		bool						KeysEqual		(const void* lhs, const void* rhs)	const;
+
+		/** @returns the slot of the key, or the capacity if the map does not contain the key. */
+		size_t						FindSlot		(const void* key, size_t hash)	const;
+
+		/** @returns the slot where the key can be added, the map must not contain the key and must have room for it. */
+		size_t						FindFreeSlot	(size_t hash)	const;
+
+		/** Adds the key if the map does not contain it yet, the functions construct the key and value at the given address. */
+		template <typename KeyConstructor, typename ValueConstructor>
+		std::pair<void*, bool>		Emplace			(const void* key, KeyConstructor&& constructKey, ValueConstructor&& constructValue);
+
+		void						Rehash			(size_t capacity);
+		void						CopyFrom		(const TypeHashMap& other);
+		void						DestroyElements	();
+
+		uint8_t*					GetControl		()	const	{ return m_Data.Get(); }
+		void*						SlotKey			(size_t slot)	const	{ return m_Data.Get() + m_SlotsOffset + slot * m_SlotSize; }
+		void*						SlotValue		(size_t slot)	const	{ return m_Data.Get() + m_SlotsOffset + slot * m_SlotSize + m_ValueOffset; }
+
+		static constexpr uint8_t	ControlByte		(size_t hash)	{ return static_cast<uint8_t>(OccupiedSlot | (hash >> (sizeof(size_t) * 8 - 7))); }
+		static void					Relocate		(const TypeInfo& info, void* destination, void* source);
+
+	private:
+		TypeId						m_KeyType		{ };
+		TypeId						m_ValueType		{ };
+		const TypeInfo*				m_KeyInfo		{ };
+		const TypeInfo*				m_ValueInfo		{ };
+		StorageBuffer				m_Data			{ }; /**< Control byte of every slot, followed by the slots*/
+		size_t						m_Capacity		{ };
+		size_t						m_Size			{ };
+		size_t						m_ErasedSlots	{ }; /**< Erased slots still take part in the probing until the next rehash*/
+		size_t						m_SlotsOffset	{ };
+		size_t						m_ValueOffset	{ }; /**< Offset of the value from the key inside of a slot*/
+		size_t						m_SlotSize		{ };
+	};
 }
 
 #endif
\ No newline at end of file